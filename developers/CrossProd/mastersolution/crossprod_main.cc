@@ -1,4 +1,7 @@
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
+#include <chrono>
+#include <cmath>
 #include <iostream>
 #include <vector>
 
@@ -35,5 +38,54 @@ int main() {
 
   // CrossProd::tab_crossprod();
 
+  // Timing of the 3-stage Radau IIA method for the method of lines ODE of
+  // u_t = u_xx - u^3 on (0,1) with zero boundary values, with dense and with
+  // sparse Jacobians
+  const double q = std::sqrt(6.0);
+  Eigen::MatrixXd A(3, 3);
+  A << (88 - 7 * q) / 360, (296 - 169 * q) / 1800, (-2 + 3 * q) / 225,
+      (296 + 169 * q) / 1800, (88 + 7 * q) / 360, (-2 - 3 * q) / 225,
+      (16 - q) / 36, (16 + q) / 36, 1.0 / 9;
+  const Eigen::VectorXd b = A.row(2).transpose();
+  CrossProd::implicitRKIntegrator radau(A, b);
+  std::cout << "Radau IIA, 20 steps, u_t = u_xx - u^3" << std::endl;
+  for (int d : {100, 400, 1600, 6400}) {
+    const double hx = 1.0 / (d + 1);
+    std::vector<Eigen::Triplet<double>> triplets;
+    for (int i = 0; i < d; ++i) {
+      triplets.emplace_back(i, i, -2.0 / (hx * hx));
+      if (i > 0) triplets.emplace_back(i, i - 1, 1.0 / (hx * hx));
+      if (i < d - 1) triplets.emplace_back(i, i + 1, 1.0 / (hx * hx));
+    }
+    Eigen::SparseMatrix<double> L(d, d);
+    L.setFromTriplets(triplets.begin(), triplets.end());
+    auto f_mol = [&L](const Eigen::VectorXd &y) -> Eigen::VectorXd {
+      return L * y - y.cwiseProduct(y).cwiseProduct(y);
+    };
+    auto Jf_sparse = [&L](const Eigen::VectorXd &y) {
+      Eigen::SparseMatrix<double> J = L;
+      J.diagonal() -= 3.0 * y.cwiseProduct(y);
+      return J;
+    };
+    auto Jf_dense = [&Jf_sparse](const Eigen::VectorXd &y) {
+      return Eigen::MatrixXd(Jf_sparse(y));
+    };
+    const Eigen::VectorXd u0 = Eigen::VectorXd::Ones(d);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    radau.solve(f_mol, Jf_sparse, 0.1, u0, 20);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "d = " << d << ": sparse Jacobian "
+              << std::chrono::duration<double>(end - start).count() << " s";
+    if (d <= 400) {
+      start = std::chrono::high_resolution_clock::now();
+      radau.solve(f_mol, Jf_dense, 0.1, u0, 20);
+      end = std::chrono::high_resolution_clock::now();
+      std::cout << ", dense Jacobian "
+                << std::chrono::duration<double>(end - start).count() << " s";
+    }
+    std::cout << std::endl;
+  }
+
   return 0;
 }
@@ -10,7 +10,6 @@ set(SOURCES
   ${DIR}/crossprod_main.cc
   ${DIR}/crossprod.h
   ${DIR}/crossprod.cc
-  ${DIR}/dampnewton.h
   ${DIR}/implicitrkintegrator.h
 )
 
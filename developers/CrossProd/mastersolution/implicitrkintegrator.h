@@ -10,28 +10,104 @@
  */
 
 #include <Eigen/Core>
+#include <Eigen/Eigenvalues>
+#include <Eigen/LU>
+#include <Eigen/SVD>
+#include <Eigen/SparseCore>
+#include <Eigen/SparseLU>
+#include <algorithm>
 #include <cassert>
+#include <complex>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
-#include "dampnewton.h"
-
 namespace CrossProd {
 
-// Compute the Kronecker product A and B.
-inline Eigen::MatrixXd kron(const Eigen::MatrixXd &A,
-                            const Eigen::MatrixXd &B) {
-  Eigen::MatrixXd C(A.rows() * B.rows(), A.cols() * B.cols());
-  for (unsigned int i = 0; i < A.rows(); ++i) {
-    for (unsigned int j = 0; j < A.cols(); ++j) {
-      C.block(i * B.rows(), j * B.cols(), B.rows(), B.cols()) = A(i, j) * B;
+namespace internal {
+
+// true if the Jacobian handle returns a sparse matrix
+template <typename JacobianType>
+constexpr bool isSparse() {
+  using J = std::decay_t<JacobianType>;
+  return std::is_base_of<Eigen::SparseMatrixBase<J>, J>::value;
+}
+
+// LU-factorization of (shifted) Jacobians, dense or sparse
+template <typename Scalar, bool SPARSE>
+using LUSolver = std::conditional_t<
+    SPARSE, Eigen::SparseLU<Eigen::SparseMatrix<Scalar>>,
+    Eigen::PartialPivLU<Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>>>;
+
+// Returns I - gamma * J
+template <typename Scalar>
+Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> shifted(
+    const Eigen::MatrixXd &J, Scalar gamma) {
+  using Matrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+  return Matrix::Identity(J.rows(), J.cols()) - gamma * J.cast<Scalar>();
+}
+template <typename Scalar>
+Eigen::SparseMatrix<Scalar> shifted(const Eigen::SparseMatrix<double> &J,
+                                    Scalar gamma) {
+  Eigen::SparseMatrix<Scalar> I(J.rows(), J.cols());
+  I.setIdentity();
+  return I - gamma * J.cast<Scalar>();
+}
+
+// Returns I - (hA) \otimes J blockwise, without forming A \otimes I
+inline Eigen::MatrixXd coupled(const Eigen::MatrixXd &J,
+                               const Eigen::MatrixXd &hA) {
+  const int d = J.rows();
+  const int s = hA.rows();
+  Eigen::MatrixXd M = Eigen::MatrixXd::Identity(s * d, s * d);
+  for (int i = 0; i < s; ++i) {
+    for (int j = 0; j < s; ++j) {
+      if (hA(i, j) != 0.0) M.block(i * d, j * d, d, d) -= hA(i, j) * J;
+    }
+  }
+  return M;
+}
+inline Eigen::SparseMatrix<double> coupled(
+    const Eigen::SparseMatrix<double> &J, const Eigen::MatrixXd &hA) {
+  const int d = J.rows();
+  const int s = hA.rows();
+  std::vector<Eigen::Triplet<double>> triplets;
+  triplets.reserve(s * d + s * s * J.nonZeros());
+  for (int i = 0; i < s * d; ++i) triplets.emplace_back(i, i, 1.0);
+  for (int i = 0; i < s; ++i) {
+    for (int j = 0; j < s; ++j) {
+      if (hA(i, j) == 0.0) continue;
+      for (int k = 0; k < J.outerSize(); ++k) {
+        for (Eigen::SparseMatrix<double>::InnerIterator it(J, k); it; ++it) {
+          triplets.emplace_back(i * d + it.row(), j * d + it.col(),
+                                -hA(i, j) * it.value());
+        }
+      }
     }
   }
-  return C;
+  Eigen::SparseMatrix<double> M(s * d, s * d);
+  M.setFromTriplets(triplets.begin(), triplets.end());
+  return M;
 }
 
+}  // namespace internal
+
 // Implements a Runge-Kutta implicit solver for a
 // given Butcher tableau for autonomous ODEs.
+//
+// The stage equations are solved by the simplified Newton method: the Jacobian
+// Jf is evaluated once per step (at the initial value of the step) and
+// factorized once per step. The Jacobian handle may return a dense or an
+// Eigen::SparseMatrix<double>; in the latter case sparse LU-factorizations are
+// used throughout.
+//
+// If the Butcher matrix A is diagonalizable, A = T diag(lambda) T^{-1}
+// (e.g. Gauss and Radau IIA methods), the linear systems of size s*d decouple
+// into s systems (I - h lambda_k Jf) w_k = r_k of size d, which are complex
+// for complex eigenvalues. Complex conjugate eigenvalues share a single
+// factorization. Otherwise (e.g. SDIRK methods, whose A is a Jordan block
+// plus strictly lower triangular part) the coupled system I - h A \otimes Jf
+// is assembled and factorized.
 class implicitRKIntegrator {
  public:
   // Constructor for the implicit RK method.
@@ -39,6 +115,56 @@ class implicitRKIntegrator {
       : A(A), b(b), s(b.size()) {
     assert(A.cols() == A.rows() && "Matrix must be square.");
     assert(A.cols() == b.size() && "Incompatible matrix/vector size.");
+    Eigen::ComplexEigenSolver<Eigen::MatrixXd> eig(A);
+    lambda = eig.eigenvalues();
+    Eigen::MatrixXcd T = eig.eigenvectors();
+    // Make the eigenvectors of real eigenvalues real, and those of complex
+    // conjugate eigenvalues complex conjugate: the stage updates are real.
+    const double eps = 1.0E-12 * (1.0 + A.norm());
+    conj.assign(s, -1);
+    for (unsigned int k = 0; k < s; ++k) {
+      if (std::abs(lambda(k).imag()) <= eps) {
+        Eigen::Index imax;
+        T.col(k).cwiseAbs().maxCoeff(&imax);
+        T.col(k) /= T(imax, k);
+        T.col(k) = T.col(k).real().cast<std::complex<double>>();
+        lambda(k) = lambda(k).real();
+        conj[k] = k;
+      } else if (lambda(k).imag() < 0.0) {
+        for (unsigned int j = 0; j < s; ++j) {
+          if (lambda(j).imag() > 0.0 &&
+              std::abs(lambda(j) - std::conj(lambda(k))) <= eps) {
+            T.col(k) = T.col(j).conjugate();
+            lambda(k) = std::conj(lambda(j));
+            conj[k] = j;
+          }
+        }
+      }
+    }
+    for (unsigned int k = 0; k < s; ++k) {
+      if (lambda(k).imag() > 0.0) conj[k] = k;
+    }
+    // Use the decoupled systems only for well-conditioned eigenvector bases
+    Eigen::JacobiSVD<Eigen::MatrixXcd> svd(T);
+    const Eigen::VectorXd sv = svd.singularValues();
+    diagonalizable =
+        std::find(conj.begin(), conj.end(), -1) == conj.end() &&
+        sv(s - 1) > 1.0E-8 * sv(0);
+    if (diagonalizable) {
+      V = T;
+      Vinv = T.inverse();
+      // One factorization per real eigenvalue and per conjugate pair
+      lu_idx.assign(s, -1);
+      for (unsigned int k = 0; k < s; ++k) {
+        if (lambda(k).imag() == 0.0) {
+          lu_idx[k] = nreal++;
+        } else if (conj[k] == static_cast<int>(k)) {
+          lu_idx[k] = ncplx++;
+        }
+      }
+    } else {
+      nreal = 1;  // coupled system
+    }
   }
 
   /* Perform the solution of the ODE.
@@ -70,8 +196,7 @@ class implicitRKIntegrator {
     // Loop over all fixed steps
     for (unsigned int k = 0; k < M; ++k) {
       // Compute, save and swap next step
-      step(std::forward<Function>(f), std::forward<Jacobian>(Jf), h, *yold,
-           *ynew);
+      step(f, Jf, h, *yold, *ynew);
       res.push_back(*ynew);
       std::swap(yold, ynew);
     }
@@ -81,45 +206,82 @@ class implicitRKIntegrator {
 
  private:
   // Perform a single step of the RK method for the sol. of the autonomous ODE
-  // Compute a single explicit RK step y^{n+1} = y_n + \sum ...
-  // starting from value y0 and storing next value in y1
+  // Compute a single implicit RK step y^{n+1} = y_n + h \sum_j b_j k_j,
+  // starting from value y0 and storing next value in y1. The increments
+  // g_j = y_j - y0 of the stages are the columns of the d x s matrix Z and
+  // satisfy Z = h F(Z) A^T, where column j of F(Z) is f(y0 + g_j).
   /* SAM_LISTING_BEGIN_0 */
   template <class Function, class Jacobian>
   void step(Function &&f, Jacobian &&Jf, double h, const Eigen::VectorXd &y0,
             Eigen::VectorXd &y1) const {
-    int d = y0.size();
-    const Eigen::MatrixXd eye = Eigen::MatrixXd::Identity(d, d);
-
-    // Handle for the function F describing the
-    // equation satisfied by the stages g
-    auto F = [&y0, h, d, this, &f,
-              &eye](Eigen::VectorXd gv) -> Eigen::VectorXd {
-      Eigen::VectorXd Fv = gv;
-      for (int j = 0; j < s; j++) {
-        Fv = Fv - h * kron(A.col(j), eye) * f(y0 + gv.segment(j * d, d));
-      }
-      return Fv;
-    };
-
-    // Handle for the Jacobian of F.
-    auto JF = [&y0, h, d, &Jf, this,
-               &eye](Eigen::VectorXd gv) -> Eigen::MatrixXd {
-      Eigen::MatrixXd DF(s * d, s * d);
-      for (int j = 0; j < s; j++) {
-        DF.block(0, j * d, s * d, d) =
-            kron(A.col(j), eye) * Jf(y0 + gv.segment(j * d, d));
+    constexpr bool SPARSE = internal::isSparse<decltype(Jf(y0))>();
+    using JacobianMatrix =
+        std::conditional_t<SPARSE, Eigen::SparseMatrix<double>,
+                           Eigen::MatrixXd>;
+    const int d = y0.size();
+
+    // Frozen Jacobian, factorized once per step
+    const JacobianMatrix J = Jf(y0);
+    std::vector<internal::LUSolver<double, SPARSE>> lu_real(nreal);
+    std::vector<internal::LUSolver<std::complex<double>, SPARSE>> lu_cplx(
+        ncplx);
+    if (diagonalizable) {
+      for (unsigned int k = 0; k < s; ++k) {
+        if (lambda(k).imag() == 0.0) {
+          lu_real[lu_idx[k]].compute(
+              internal::shifted(J, h * lambda(k).real()));
+        } else if (conj[k] == static_cast<int>(k)) {
+          lu_cplx[lu_idx[k]].compute(internal::shifted(J, h * lambda(k)));
+        }
       }
-      DF = Eigen::MatrixXd::Identity(s * d, s * d) - h * DF;
-      return DF;
-    };
+    } else {
+      lu_real[0].compute(internal::coupled(J, h * A));
+    }
 
-    // Obtain stages with damped Newton method
-    Eigen::VectorXd gv = Eigen::VectorXd::Zero(s * d);
-    dampnewton(F, JF, gv);
+    // Simplified Newton iteration for the stage increments
+    Eigen::MatrixXd Z = Eigen::MatrixXd::Zero(d, s);
+    Eigen::MatrixXd K(d, s);
+    Eigen::MatrixXd dZ(d, s);
+    bool converged = false;
+    for (unsigned int it = 0; it < maxit && !converged; ++it) {
+      for (unsigned int j = 0; j < s; ++j) K.col(j) = f(y0 + Z.col(j));
+      // Residual G = Z - h F(Z) A^T; Newton correction solves
+      // dZ - h J dZ A^T = -G
+      const Eigen::MatrixXd G = Z - h * K * A.transpose();
+      if (diagonalizable) {
+        // With dZ = dW V^T the columns of dW decouple:
+        // (I - h lambda_k J) dW_k = -(G V^{-T})_k
+        const Eigen::MatrixXcd R =
+            -G.cast<std::complex<double>>() * Vinv.transpose();
+        Eigen::MatrixXcd dW(d, s);
+        for (unsigned int k = 0; k < s; ++k) {
+          if (lambda(k).imag() == 0.0) {
+            const Eigen::VectorXd r = R.col(k).real();
+            const Eigen::VectorXd w = lu_real[lu_idx[k]].solve(r);
+            dW.col(k) = w.cast<std::complex<double>>();
+          } else if (conj[k] == static_cast<int>(k)) {
+            const Eigen::VectorXcd r = R.col(k);
+            dW.col(k) = lu_cplx[lu_idx[k]].solve(r);
+          }
+        }
+        for (unsigned int k = 0; k < s; ++k) {
+          if (conj[k] != static_cast<int>(k)) {
+            dW.col(k) = dW.col(conj[k]).conjugate();
+          }
+        }
+        dZ = (dW * V.transpose()).real();
+      } else {
+        const Eigen::VectorXd r =
+            -Eigen::Map<const Eigen::VectorXd>(G.data(), s * d);
+        Eigen::Map<Eigen::VectorXd>(dZ.data(), s * d) = lu_real[0].solve(r);
+      }
+      Z += dZ;
+      converged = dZ.norm() <= atol + rtol * Z.norm();
+    }
+    if (!converged) throw "No convergence of simplified Newton iteration";
 
     // Calculate y1
-    Eigen::MatrixXd K(d, s);
-    for (int j = 0; j < s; j++) K.col(j) = f(y0 + gv.segment(j * d, d));
+    for (unsigned int j = 0; j < s; ++j) K.col(j) = f(y0 + Z.col(j));
     y1 = y0 + h * K * b;
   }
   /* SAM_LISTING_END_0 */
@@ -129,6 +291,22 @@ class implicitRKIntegrator {
   const Eigen::VectorXd b;
   //<! Size of Butcher matrix and vector A and b
   unsigned int s;
+  //<! Eigenvalues of A and eigenvector basis V with inverse Vinv
+  Eigen::VectorXcd lambda;
+  Eigen::MatrixXcd V, Vinv;
+  //<! conj[k] == k: lambda(k) real or with positive imaginary part,
+  //<! otherwise lambda(k) is the complex conjugate of lambda(conj[k])
+  std::vector<int> conj;
+  //<! true if the linear systems of the Newton method can be decoupled
+  bool diagonalizable;
+  //<! Number of real and complex factorizations needed in every step, and
+  //<! index of the factorization belonging to each eigenvalue
+  unsigned int nreal = 0, ncplx = 0;
+  std::vector<int> lu_idx;
+  //<! Tolerances and maximal number of simplified Newton steps
+  static constexpr double rtol = 1.0E-10;
+  static constexpr double atol = 1.0E-12;
+  static constexpr unsigned int maxit = 50;
 };
 
 }  // namespace CrossProd
@@ -11,6 +11,9 @@
 #include <gtest/gtest.h>
 
 #include <Eigen/Core>
+#include <Eigen/LU>
+#include <Eigen/SparseCore>
+#include <cmath>
 #include <iostream>
 
 namespace CrossProd::test {
@@ -51,4 +54,91 @@ TEST(CrossProd, solve_lin_mid) {
   ASSERT_NEAR(0.0, (yT - yT_reference).lpNorm<Eigen::Infinity>(), tol);
 }
 
+// Method of lines for u_t = u_xx - u^3 on (0,1), zero boundary values
+Eigen::SparseMatrix<double> laplacian(int d) {
+  const double h = 1.0 / (d + 1);
+  std::vector<Eigen::Triplet<double>> triplets;
+  for (int i = 0; i < d; ++i) {
+    triplets.emplace_back(i, i, -2.0 / (h * h));
+    if (i > 0) triplets.emplace_back(i, i - 1, 1.0 / (h * h));
+    if (i < d - 1) triplets.emplace_back(i, i + 1, 1.0 / (h * h));
+  }
+  Eigen::SparseMatrix<double> L(d, d);
+  L.setFromTriplets(triplets.begin(), triplets.end());
+  return L;
+}
+
+TEST(CrossProd, implicitRKIntegrator_Gauss2) {
+  // 2-stage Gauss method (complex conjugate eigenvalues of A)
+  Eigen::MatrixXd A(2, 2);
+  Eigen::VectorXd b(2);
+  const double r = std::sqrt(3.0) / 6.0;
+  A << 0.25, 0.25 - r, 0.25 + r, 0.25;
+  b << 0.5, 0.5;
+  implicitRKIntegrator RK(A, b);
+
+  // For a linear ODE y' = Ly one step amounts to the stability function
+  // S(z) = (1 + z/2 + z^2/12) / (1 - z/2 + z^2/12)
+  const int d = 20;
+  const double T = 0.1;
+  const Eigen::SparseMatrix<double> L = laplacian(d);
+  auto f = [&L](const Eigen::VectorXd &y) -> Eigen::VectorXd { return L * y; };
+  auto Jf = [&L](const Eigen::VectorXd &y) { return L; };
+  const Eigen::VectorXd y0 = Eigen::VectorXd::LinSpaced(d, 0.0, 1.0);
+  const Eigen::VectorXd yT = RK.solve(f, Jf, T, y0, 1).back();
+
+  const Eigen::MatrixXd Z = T * Eigen::MatrixXd(L);
+  const Eigen::MatrixXd I = Eigen::MatrixXd::Identity(d, d);
+  const Eigen::MatrixXd P = Z * Z / 12.0;
+  const Eigen::VectorXd yT_reference =
+      (I - 0.5 * Z + P).lu().solve((I + 0.5 * Z + P) * y0);
+
+  double tol = 1.0e-8;
+  ASSERT_NEAR(0.0, (yT - yT_reference).lpNorm<Eigen::Infinity>(), tol);
+}
+
+TEST(CrossProd, implicitRKIntegrator_sparse) {
+  const int d = 30;
+  const Eigen::SparseMatrix<double> L = laplacian(d);
+  auto f = [&L](const Eigen::VectorXd &y) -> Eigen::VectorXd {
+    return L * y - y.cwiseProduct(y).cwiseProduct(y);
+  };
+  auto Jf_sparse = [&L](const Eigen::VectorXd &y) {
+    Eigen::SparseMatrix<double> J = L;
+    J.diagonal() -= 3.0 * y.cwiseProduct(y);
+    return J;
+  };
+  auto Jf_dense = [&Jf_sparse](const Eigen::VectorXd &y) {
+    return Eigen::MatrixXd(Jf_sparse(y));
+  };
+  const Eigen::VectorXd y0 =
+      (M_PI * Eigen::VectorXd::LinSpaced(d, 1.0, d) / (d + 1)).array().sin();
+
+  // 3-stage Radau IIA method (one real and two complex eigenvalues of A)
+  // and 2-stage SDIRK method (A not diagonalizable)
+  const double q = std::sqrt(6.0);
+  Eigen::MatrixXd A_radau(3, 3);
+  A_radau << (88 - 7 * q) / 360, (296 - 169 * q) / 1800, (-2 + 3 * q) / 225,
+      (296 + 169 * q) / 1800, (88 + 7 * q) / 360, (-2 - 3 * q) / 225,
+      (16 - q) / 36, (16 + q) / 36, 1.0 / 9;
+  const Eigen::VectorXd b_radau = A_radau.row(2).transpose();
+  const double g = 1.0 - 1.0 / std::sqrt(2.0);
+  Eigen::MatrixXd A_sdirk(2, 2);
+  A_sdirk << g, 0.0, 1.0 - g, g;
+  const Eigen::VectorXd b_sdirk = A_sdirk.row(1).transpose();
+
+  const double T = 0.1;
+  double tol = 1.0e-9;
+  for (auto [A, b] : {std::make_pair(A_radau, b_radau),
+                      std::make_pair(A_sdirk, b_sdirk)}) {
+    implicitRKIntegrator RK(A, b);
+    const Eigen::VectorXd yT_sparse = RK.solve(f, Jf_sparse, T, y0, 10).back();
+    const Eigen::VectorXd yT_dense = RK.solve(f, Jf_dense, T, y0, 10).back();
+    ASSERT_NEAR(0.0, (yT_sparse - yT_dense).lpNorm<Eigen::Infinity>(), tol);
+    // stiff decay of the leading sine mode
+    const double decay = std::exp(-M_PI * M_PI * T);
+    ASSERT_NEAR(0.0, (yT_sparse - decay * y0).lpNorm<Eigen::Infinity>(), 0.05);
+  }
+}
+
 }  // namespace CrossProd::test
@@ -12,6 +12,8 @@
 
 #include <Eigen/Core>
 
+#include "../dgblocksolver.h"
+
 namespace DiscontinuousGalerkin1D::test {
 
 TEST(DiscontinuousGalerkin1D, compBmat) {
@@ -143,4 +145,50 @@ TEST(DiscontinuousGalerkin1D, solveTrafficFlow) {
   }
 }
 
+TEST(DiscontinuousGalerkin1D, DGBlockSolver) {
+  Eigen::VectorXd mu0(6);
+  mu0 << 0.1, 0.2, 0.3, 0.4, 0.3, 0.2;
+  auto f = [](double x) { return 0.5 * x * x; };
+  auto F = [](double v, double w) { return v; };
+  int Ml = 1;
+  int Mr = 1;
+  double h = 0.55;
+  double tol = 1.0e-8;
+
+  // for P = 1 the inverse mass matrix is the inverse of compBmat(...)
+  auto solver = makeDGBlockSolver<1>(f, F, Ml, Mr, h);
+  Eigen::MatrixXd Binv_ref = Eigen::MatrixXd(compBmat(Ml, Mr, h)).inverse();
+  ASSERT_NEAR(0.0,
+              (solver.inverseMassMatrix().toDense() - Binv_ref)
+                  .lpNorm<Eigen::Infinity>(),
+              tol);
+
+  // the fused kernel computes -B^{-1} G(mu)
+  Eigen::VectorXd dmu;
+  solver.rhs(mu0, dmu);
+  Eigen::VectorXd dmu_ref = -Binv_ref * G(mu0, f, F, Ml, Mr, h);
+  ASSERT_NEAR(0.0, (dmu - dmu_ref).lpNorm<Eigen::Infinity>(), tol);
+
+  // and the timestepping agrees with dgcl(...)
+  Eigen::VectorXd mu = mu0;
+  solver.evolve(mu, 1.0, 2);
+  Eigen::VectorXd mu_ref = dgcl(mu0, f, F, 1.0, Ml, Mr, h, 2);
+  ASSERT_NEAR(0.0, (mu - mu_ref).lpNorm<Eigen::Infinity>(), tol);
+
+  // P = 2 with the upwind flux: a constant state is stationary in the
+  // interior, and the total mass changes only by the boundary fluxes
+  auto F_up = [&f](double v, double w) { return f(v); };
+  auto solver2 = makeDGBlockSolver<2>(f, F_up, 2, 2, h);
+  Eigen::VectorXd mu2 = Eigen::VectorXd::Zero(15);
+  for (int i = 0; i < 5; ++i) mu2(3 * i) = 1.0;
+  solver2.rhs(mu2, dmu);
+  ASSERT_NEAR(0.0, dmu.segment(3, 9).lpNorm<Eigen::Infinity>(), tol);
+  // mass leaves through the right boundary only, at rate f(1) = 0.5
+  double dmass = 0.0;
+  for (int i = 0; i < 5; ++i) {
+    dmass += h * dmu(3 * i) + h * h * h / 12.0 * dmu(3 * i + 2);
+  }
+  ASSERT_NEAR(dmass, -0.5, tol);
+}
+
 }  // namespace DiscontinuousGalerkin1D::test
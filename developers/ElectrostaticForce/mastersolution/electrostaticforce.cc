@@ -279,4 +279,162 @@ double getMeshSize(const std::shared_ptr<const lf::mesh::Mesh> &mesh_p) {
 };  // getMeshSize
 /* SAM_LISTING_END_6 */
 
+PoissonBVPSolver::PoissonBVPSolver(
+    std::shared_ptr<lf::uscalfe::FeSpaceLagrangeO1<double>> fe_space_p)
+    : fe_space_p_(std::move(fe_space_p)) {
+  std::shared_ptr<const lf::mesh::Mesh> mesh_p = fe_space_p_->Mesh();
+  const lf::assemble::DofHandler &dofh{fe_space_p_->LocGlobMap()};
+  const lf::uscalfe::size_type N_dofs(dofh.NumDofs());
+
+  // I : SPLITTING THE DOFS
+  // Position of every dof in bd_dofs_ or int_dofs_
+  auto bd_flags{lf::mesh::utils::flagEntitiesOnBoundary(mesh_p, 2)};
+  std::vector<bool> is_bd(N_dofs, false);
+  std::vector<Eigen::Index> pos(N_dofs);
+  for (const lf::mesh::Entity *node : mesh_p->Entities(2)) {
+    is_bd[dofh.GlobalDofIndices(*node)[0]] = bd_flags(*node);
+  }
+  for (lf::assemble::glb_idx_t dof = 0; dof < N_dofs; ++dof) {
+    std::vector<lf::assemble::glb_idx_t> &dofs{is_bd[dof] ? bd_dofs_
+                                                          : int_dofs_};
+    pos[dof] = dofs.size();
+    dofs.push_back(dof);
+  }
+  const Eigen::Index N_int = int_dofs_.size();
+  const Eigen::Index N_bd = bd_dofs_.size();
+
+  // II : ASSEMBLY AND FACTORIZATION OF THE INTERIOR BLOCK
+  lf::assemble::COOMatrix<double> A(N_dofs, N_dofs);
+  lf::uscalfe::LinearFELaplaceElementMatrix elmat_builder{};
+  lf::assemble::AssembleMatrixLocally(0, dofh, dofh, elmat_builder, A);
+  std::vector<Eigen::Triplet<double>> triplets_II;
+  std::vector<Eigen::Triplet<double>> triplets_IB;
+  for (const Eigen::Triplet<double> &triplet : A.triplets()) {
+    if (is_bd[triplet.row()]) continue;
+    const Eigen::Index i = pos[triplet.row()];
+    const Eigen::Index j = pos[triplet.col()];
+    if (is_bd[triplet.col()]) {
+      triplets_IB.emplace_back(i, j, triplet.value());
+    } else {
+      triplets_II.emplace_back(i, j, triplet.value());
+    }
+  }
+  Eigen::SparseMatrix<double> A_II(N_int, N_int);
+  A_II.setFromTriplets(triplets_II.begin(), triplets_II.end());
+  A_IB_.resize(N_int, N_bd);
+  A_IB_.setFromTriplets(triplets_IB.begin(), triplets_IB.end());
+  solver_.compute(A_II);
+  LF_VERIFY_MSG(solver_.info() == Eigen::Success, "LU decomposition failed");
+
+  // III : GRADIENT OPERATORS AND WEIGHTS OF THE FORCE FUNCTIONALS
+  // Same data and quadrature rules as computeForceBoundaryFunctional() and
+  // computeForceDomainFunctional()
+  auto bd_edge_flags{lf::mesh::utils::flagEntitiesOnBoundary(mesh_p, 1)};
+  Eigen::Matrix2d rotation_mat;
+  rotation_mat << 0, 1, -1, 0;  // rotates a 2d vec by 90 deg.
+  Eigen::Vector2d a(-16.0 / 15.0, 0.0);
+  Eigen::Vector2d b(-1.0 / 15.0, 0.0);
+  auto grad_uExact = [&a, &b](Eigen::Vector2d x) -> Eigen::Vector2d {
+    return ((x - a) / (x - a).squaredNorm() - (x - b) / (x - b).squaredNorm()) /
+           std::log(2.0);
+  };
+  // Adds the rows of the gradient on cell as rows 2k and 2k+1
+  auto add_gradient = [&dofh](const lf::mesh::Entity &cell, Eigen::Index k,
+                              std::vector<Eigen::Triplet<double>> &triplets) {
+    const auto dof_idx_vec = dofh.GlobalDofIndices(cell);
+    const Eigen::Matrix<double, 2, 3> elgrad_mat = gradbarycoordinates(cell);
+    for (int j = 0; j < 3; ++j) {
+      triplets.emplace_back(2 * k, dof_idx_vec[j], elgrad_mat(0, j));
+      triplets.emplace_back(2 * k + 1, dof_idx_vec[j], elgrad_mat(1, j));
+    }
+  };
+  std::vector<Eigen::Triplet<double>> triplets_bd;
+  std::vector<Eigen::Vector2d> weights_bd;
+  std::vector<Eigen::Triplet<double>> triplets_dom;
+  weights_dom_.resize(2, mesh_p->NumEntities(0));
+  Eigen::Index k_dom = 0;
+  for (const lf::mesh::Entity *cell : mesh_p->Entities(0)) {
+    auto endpoints = lf::geometry::Corners(*(cell->Geometry()));
+    for (const lf::mesh::Entity *edge : cell->SubEntities(1)) {
+      if (!bd_edge_flags(*edge)) continue;
+      auto edge_endpoints = lf::geometry::Corners(*(edge->Geometry()));
+      if (edge_endpoints.col(0).norm() >= 0.27) continue;
+      const Eigen::Vector2d tangent =
+          edge_endpoints.col(1) - edge_endpoints.col(0);
+      Eigen::Vector2d normal_vec = rotation_mat * tangent.normalized();
+      if (normal_vec.dot(edge_endpoints.col(0)) > 0) {
+        normal_vec *= -1.0;
+      }
+      add_gradient(*cell, weights_bd.size(), triplets_bd);
+      weights_bd.push_back(0.5 * tangent.norm() * normal_vec);
+    }
+    add_gradient(*cell, k_dom, triplets_dom);
+    const double area = lf::geometry::Volume(*(cell->Geometry()));
+    // computeForceDomainFunctional() takes the midpoint of the edge between
+    // the corners 1 and 2 twice, kept here so that both agree
+    const Eigen::Vector2d mid_01 = 0.5 * (endpoints.col(0) + endpoints.col(1));
+    const Eigen::Vector2d mid_12 = 0.5 * (endpoints.col(1) + endpoints.col(2));
+    weights_dom_.col(k_dom) =
+        (area / 3.0) *
+        (grad_uExact(mid_01) + grad_uExact(mid_12) + grad_uExact(mid_12));
+    ++k_dom;
+  }
+  grad_bd_.resize(2 * weights_bd.size(), N_dofs);
+  grad_bd_.setFromTriplets(triplets_bd.begin(), triplets_bd.end());
+  weights_bd_.resize(2, weights_bd.size());
+  for (std::size_t k = 0; k < weights_bd.size(); ++k) {
+    weights_bd_.col(k) = weights_bd[k];
+  }
+  grad_dom_.resize(2 * k_dom, N_dofs);
+  grad_dom_.setFromTriplets(triplets_dom.begin(), triplets_dom.end());
+}
+
+Eigen::MatrixXd PoissonBVPSolver::solve(const Eigen::MatrixXd &G) const {
+  LF_VERIFY_MSG(G.rows() == static_cast<Eigen::Index>(bd_dofs_.size()),
+                "Boundary data has wrong size");
+  // One block solve for all right hand sides -A_IB * g
+  const Eigen::MatrixXd rhs = -(A_IB_ * G);
+  const Eigen::MatrixXd U_int = solver_.solve(rhs);
+  LF_VERIFY_MSG(solver_.info() == Eigen::Success, "Solving LSE failed");
+
+  Eigen::MatrixXd U(int_dofs_.size() + bd_dofs_.size(), G.cols());
+  for (std::size_t k = 0; k < int_dofs_.size(); ++k) {
+    U.row(int_dofs_[k]) = U_int.row(k);
+  }
+  for (std::size_t k = 0; k < bd_dofs_.size(); ++k) {
+    U.row(bd_dofs_[k]) = G.row(k);
+  }
+  return U;
+}
+
+Eigen::Matrix2Xd PoissonBVPSolver::computeForceBoundaryFunctional(
+    const Eigen::MatrixXd &U) const {
+  // Gradients of all solutions on all cells at the interior boundary
+  const Eigen::MatrixXd grads = grad_bd_ * U;
+  Eigen::Matrix2Xd forces = Eigen::Matrix2Xd::Zero(2, U.cols());
+  for (Eigen::Index c = 0; c < U.cols(); ++c) {
+    for (Eigen::Index k = 0; k < weights_bd_.cols(); ++k) {
+      const Eigen::Vector2d grad = grads.block<2, 1>(2 * k, c);
+      forces.col(c) += grad.dot(weights_bd_.col(k)) * grad;
+    }
+  }
+  return forces;
+}
+
+Eigen::Matrix2Xd PoissonBVPSolver::computeForceDomainFunctional(
+    const Eigen::MatrixXd &U) const {
+  // Gradients of all solutions on all cells
+  const Eigen::MatrixXd grads = grad_dom_ * U;
+  Eigen::Matrix2Xd forces = Eigen::Matrix2Xd::Zero(2, U.cols());
+  for (Eigen::Index c = 0; c < U.cols(); ++c) {
+    for (Eigen::Index k = 0; k < weights_dom_.cols(); ++k) {
+      const Eigen::Vector2d grad = grads.block<2, 1>(2 * k, c);
+      // Maxwell stress tensor applied to the weight
+      forces.col(c) += grad.dot(weights_dom_.col(k)) * grad -
+                       0.5 * grad.squaredNorm() * weights_dom_.col(k);
+    }
+  }
+  return forces;
+}
+
 }  // namespace ElectrostaticForce
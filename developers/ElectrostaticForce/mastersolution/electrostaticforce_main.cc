@@ -8,7 +8,9 @@
 
 #include <lf/fe/fe.h>
 
+#include <chrono>
 #include <fstream>
+#include <iomanip>
 
 #include "electrostaticforce.h"
 
@@ -192,6 +194,47 @@ int main() {
   std::cout << "---------------------------------------------------------"
             << std::endl;
 
+  // MANY DIRICHLET DATA ON THE FINEST MESH
+  // Inner conductor at potential 1, outer boundary at potential t
+  const int N_data = 16;
+  auto start = std::chrono::steady_clock::now();
+  PoissonBVPSolver solver(fe_space_p);
+  const Eigen::VectorXd ts = Eigen::VectorXd::LinSpaced(N_data, -1.0, 1.0);
+  Eigen::MatrixXd G(solver.boundaryDofs().size(), N_data);
+  for (int j = 0; j < N_data; ++j) {
+    const double t = ts[j];
+    G.col(j) = solver.boundaryValues([t](Eigen::Vector2d x) -> double {
+      return x.norm() < 0.27 ? 1.0 : t;
+    });
+  }
+  const Eigen::MatrixXd U = solver.solve(G);
+  const Eigen::Matrix2Xd forces_bd = solver.computeForceBoundaryFunctional(U);
+  const Eigen::Matrix2Xd forces_dom = solver.computeForceDomainFunctional(U);
+  const double ms_cached = std::chrono::duration<double, std::milli>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+  // Reference: one assembly and factorization per data set
+  start = std::chrono::steady_clock::now();
+  for (int j = 0; j < N_data; ++j) {
+    computeForceDomainFunctional(fe_space_p, solvePoissonBVP(fe_space_p));
+  }
+  const double ms_single = std::chrono::duration<double, std::milli>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+  std::cout << "\nForces on the finest mesh for " << N_data
+            << " outer potentials t" << std::endl;
+  std::cout << std::setw(10) << "t" << std::setw(14) << "F_bd(0)"
+            << std::setw(14) << "F_dom(0)" << std::endl;
+  const std::ios_base::fmtflags cout_flags = std::cout.flags();
+  std::cout << std::fixed;
+  for (int j = 0; j < N_data; ++j) {
+    std::cout << std::setw(10) << ts[j] << std::setw(14) << forces_bd(0, j)
+              << std::setw(14) << forces_dom(0, j) << std::endl;
+  }
+  std::cout.flags(cout_flags);
+  std::cout << "cached solver: " << ms_cached << " ms, " << N_data
+            << " x solvePoissonBVP: " << ms_single << " ms" << std::endl;
+
   /* Output results to vtk file */
   // We store data by keeping only the coefficients of nodal basis functions
   // In that sense, we are plotting the values of the solution at the vertices
@@ -10,6 +10,7 @@ set(SOURCES
   ${DIR}/exponentialintegrator_main.cc
   ${DIR}/exponentialintegrator.h
   ${DIR}/exponentialintegrator.cc
+  ${DIR}/krylovphi.h
 )
 
 set(LIBRARIES
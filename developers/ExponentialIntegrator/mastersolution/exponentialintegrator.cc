@@ -9,7 +9,9 @@
 #include "exponentialintegrator.h"
 
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
 #include <cassert>
+#include <chrono>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
@@ -77,4 +79,65 @@ void testExpEulerLogODE() {
   /* SAM_LISTING_END_0 */
 }
 
+// Timing of the exponential Euler method with phim() and with KrylovPhi for
+// the semi-discrete Fisher equation y' = Ly + y(1-y), L the finite difference
+// Laplacian on (0,1) with zero boundary values.
+void benchmarkKrylovPhi() {
+  const int steps = 10;
+  std::cout << std::setw(10) << "n" << std::setw(16) << "Krylov [s/step]"
+            << std::setw(8) << "m" << std::setw(16) << "phim [s/step]"
+            << std::setw(14) << "difference" << std::endl;
+  for (int n : {100, 1000, 10000, 100000, 1000000}) {
+    const double hx = 1.0 / (n + 1);
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(3 * n);
+    for (int i = 0; i < n; ++i) {
+      triplets.emplace_back(i, i, -2.0 / (hx * hx));
+      if (i > 0) triplets.emplace_back(i, i - 1, 1.0 / (hx * hx));
+      if (i < n - 1) triplets.emplace_back(i, i + 1, 1.0 / (hx * hx));
+    }
+    Eigen::SparseMatrix<double> L(n, n);
+    L.setFromTriplets(triplets.begin(), triplets.end());
+    auto f = [&L](const Eigen::VectorXd &y) -> Eigen::VectorXd {
+      return L * y + y.cwiseProduct(Eigen::VectorXd::Ones(y.size()) - y);
+    };
+    auto df = [&L](const Eigen::VectorXd &y) {
+      Eigen::SparseMatrix<double> J = L;
+      J.diagonal() += Eigen::VectorXd::Ones(y.size()) - 2.0 * y;
+      return J;
+    };
+    // Timestep with h*|L| = 20, smooth initial data
+    const double h = 5.0 * hx * hx;
+    const Eigen::VectorXd y0 =
+        (M_PI * hx * Eigen::ArrayXd::LinSpaced(n, 1, n)).sin().matrix();
+
+    KrylovPhi phi;
+    Eigen::VectorXd y = y0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int k = 0; k < steps; ++k) {
+      y = exponentialEulerStepKrylov(y, f, df, h, phi);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << std::setw(10) << n << std::setw(16)
+              << std::chrono::duration<double>(end - start).count() / steps
+              << std::setw(8) << phi.krylovDimension();
+
+    // One step with the dense matrix function, only for small n
+    if (n <= 1000) {
+      auto df_dense = [&df](const Eigen::VectorXd &y) {
+        return Eigen::MatrixXd(df(y));
+      };
+      start = std::chrono::high_resolution_clock::now();
+      const Eigen::VectorXd y1 = y0 + h * phim(h * df_dense(y0)) * f(y0);
+      end = std::chrono::high_resolution_clock::now();
+      const Eigen::VectorXd y1_krylov =
+          exponentialEulerStepKrylov(y0, f, df, h, phi);
+      std::cout << std::setw(16)
+                << std::chrono::duration<double>(end - start).count()
+                << std::setw(14) << (y1 - y1_krylov).lpNorm<Eigen::Infinity>();
+    }
+    std::cout << std::endl;
+  }
+}
+
 }  // namespace ExponentialIntegrator
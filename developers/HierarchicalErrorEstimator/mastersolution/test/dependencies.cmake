@@ -16,5 +16,6 @@ set(LIBRARIES
   LF::lf.io
   LF::lf.fe
   LF::lf.uscalfe
+  Threads::Threads
 )
 
@@ -18,19 +18,6 @@
 
 namespace ImplRK3Prey {
 
-// Compute the Kronecker product $C = A \otimes B$
-// A is m x n matrix, B is l x k matrix
-// return Kronecker product of A and B: dim is m*l x n*k
-Eigen::MatrixXd kron(const Eigen::MatrixXd &A, const Eigen::MatrixXd &B) {
-  Eigen::MatrixXd C(A.rows() * B.rows(), A.cols() * B.cols());
-  for (unsigned int i = 0; i < A.rows(); ++i) {
-    for (unsigned int j = 0; j < A.cols(); ++j) {
-      C.block(i * B.rows(), j * B.cols(), B.rows(), B.cols()) = A(i, j) * B;
-    }
-  }
-  return C;
-}
-
 // Implements a Runge-Kutta implicit solver for a given Butcher tableau
 // for autonomous ODEs.
 /* SAM_LISTING_BEGIN_1 */
@@ -90,26 +77,30 @@ class implicitRKIntegrator {
   void step(Function &&f, Jacobian &&Jf, double h, const Eigen::VectorXd &y0,
             Eigen::VectorXd &y1) const {
     int d = y0.size();
-    const Eigen::MatrixXd eye = Eigen::MatrixXd::Identity(d, d);
 
     // Handle for the function F describing the
-    // equation satisfied by the stages g
-    auto F = [&y0, h, d, this, &f, &eye](Eigen::VectorXd gv) {
+    // equation satisfied by the stages g. The coupling (A \otimes I) of the
+    // stages is applied blockwise, without forming the Kronecker product.
+    auto F = [&y0, h, d, this, &f](const Eigen::VectorXd &gv) {
       Eigen::VectorXd Fv = gv;
       for (int j = 0; j < s; j++) {
-        Fv = Fv - h * kron(A.col(j), eye) * f(y0 + gv.segment(j * d, d));
+        const Eigen::VectorXd fj = f(y0 + gv.segment(j * d, d));
+        for (int i = 0; i < s; i++) {
+          Fv.segment(i * d, d) -= h * A(i, j) * fj;
+        }
       }
       return Fv;
     };
 
     // Handle for the Jacobian of F.
-    auto JF = [&y0, h, d, &Jf, this, &eye](Eigen::VectorXd gv) {
-      Eigen::MatrixXd DF(s * d, s * d);
+    auto JF = [&y0, h, d, &Jf, this](const Eigen::VectorXd &gv) {
+      Eigen::MatrixXd DF = Eigen::MatrixXd::Identity(s * d, s * d);
       for (int j = 0; j < s; j++) {
-        DF.block(0, j * d, s * d, d) =
-            kron(A.col(j), eye) * Jf(y0 + gv.segment(j * d, d));
+        const Eigen::MatrixXd Jj = Jf(y0 + gv.segment(j * d, d));
+        for (int i = 0; i < s; i++) {
+          DF.block(i * d, j * d, d, d) -= h * A(i, j) * Jj;
+        }
       }
-      DF = Eigen::MatrixXd::Identity(s * d, s * d) - h * DF;
       return DF;
     };
 
@@ -14,4 +14,5 @@ set(SOURCES
 
 set(LIBRARIES
   Eigen3::Eigen
+  Threads::Threads
 )
@@ -8,12 +8,35 @@
  */
 
 #include <Eigen/Core>
+#include <utility>
+#include <vector>
 
 namespace InitCondLV {
 
 std::pair<Eigen::Vector2d, Eigen::Matrix2d> PhiAndW(double u0, double v0,
                                                     double T);
 
+/* Newton's method for the initial value of a T-periodic solution, starting
+ * from the guess y, with multiple shooting: [0, T] is split into the given
+ * number of segments, which are integrated concurrently on the given number of
+ * threads. The cyclic block-bidiagonal Newton system for the segment initial
+ * values is condensed to a 2x2 system. With segments = 1 this is the Newton
+ * iteration of the main program. Stops once the norm of the residual of all
+ * segment matching conditions is below tol. */
+Eigen::Vector2d MultipleShooting(const Eigen::Vector2d &y, double T,
+                                 unsigned int segments = 1,
+                                 unsigned int threads = 1, double tol = 1e-10,
+                                 unsigned int *iterations = nullptr);
+
+/* MultipleShooting() for independent initial guesses, which are distributed
+ * on the given number of threads. */
+std::vector<Eigen::Vector2d> MultipleShootingBatch(
+    const std::vector<Eigen::Vector2d> &guesses, double T, unsigned int threads,
+    unsigned int segments = 1, double tol = 1e-10);
+
+/* Wall-time scaling of MultipleShooting() and MultipleShootingBatch() */
+void BenchmarkShooting();
+
 }  // namespace InitCondLV
 
 #endif  // #define LV_H_
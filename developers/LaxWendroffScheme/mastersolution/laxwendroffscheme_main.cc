@@ -7,6 +7,7 @@
  */
 
 #include <Eigen/Core>
+#include <chrono>
 #include <fstream>
 #include <iostream>
 
@@ -34,6 +35,41 @@ int main() {
   file.close();
   std::cout << "Generated " CURRENT_BINARY_DIR "/convergence.csv" << std::endl;
 
+  // Timing of the allocating and the double-buffered implementations on
+  // 10^6 cells
+  {
+    const unsigned int N = 1000000;
+    const unsigned int steps = 100;
+    Eigen::VectorXd u0 = Eigen::VectorXd::LinSpaced(N, -1.0, 2.0).unaryExpr(
+        [](double x) { return (0.0 <= x && x <= 1.0) ? x * (1.0 - x) : 0.0; });
+    auto timeit = [](auto &&solve) {
+      auto start = std::chrono::high_resolution_clock::now();
+      Eigen::VectorXd u = solve();
+      auto end = std::chrono::high_resolution_clock::now();
+      return std::make_pair(std::chrono::duration<double>(end - start).count(),
+                            u);
+    };
+    // Both schemes use tau / h = 1 / e, the spatial grid is not needed
+    const double T = 1.0;
+    auto [t_lw, u_lw] =
+        timeit([&]() { return solveLaxWendroff(u0, T, steps); });
+    auto [t_lwip, u_lwip] =
+        timeit([&]() { return solveLaxWendroffInPlace(u0, T, steps); });
+    auto [t_god, u_god] = timeit([&]() { return solveGodunov(u0, T, steps); });
+    auto [t_godip, u_godip] =
+        timeit([&]() { return solveGodunovInPlace(u0, T, steps); });
+    std::cout << "N = " << N << " cells, " << steps << " timesteps"
+              << std::endl;
+    std::cout << "solveLaxWendroff:        " << t_lw << " s" << std::endl;
+    std::cout << "solveLaxWendroffInPlace: " << t_lwip << " s, speedup "
+              << t_lw / t_lwip << ", difference "
+              << (u_lw - u_lwip).lpNorm<Eigen::Infinity>() << std::endl;
+    std::cout << "solveGodunov:            " << t_god << " s" << std::endl;
+    std::cout << "solveGodunovInPlace:     " << t_godip << " s, speedup "
+              << t_god / t_godip << ", difference "
+              << (u_god - u_godip).lpNorm<Eigen::Infinity>() << std::endl;
+  }
+
 #if SOLUTION
   std::system("python3 " CURRENT_SOURCE_DIR "/plot.py " CURRENT_BINARY_DIR
               "/convergence.csv " CURRENT_BINARY_DIR "/convergence.eps");
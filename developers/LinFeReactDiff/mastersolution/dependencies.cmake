@@ -10,6 +10,8 @@ set(SOURCES
   ${DIR}/linfereactdiff_main.cc
   ${DIR}/linfereactdiff.h
   ${DIR}/linfereactdiff.cc
+  ${DIR}/multigrid.h
+  ${DIR}/multigrid.cc
 )
 
 set(LIBRARIES
@@ -21,4 +23,5 @@ set(LIBRARIES
   LF::lf.mesh.utils
   LF::lf.refinement
   LF::lf.uscalfe
+  Threads::Threads
 )
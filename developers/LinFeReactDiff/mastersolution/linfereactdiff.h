@@ -8,15 +8,22 @@
 #include <lf/base/base.h>
 #include <lf/mesh/mesh.h>
 #include <lf/refinement/refinement.h>
+#include <lf/uscalfe/uscalfe.h>
 
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
 #include <memory>
+#include <utility>
 
 namespace LinFeReactDiff {
 
 std::shared_ptr<lf::refinement::MeshHierarchy> generateMeshHierarchy(
     const lf::base::size_type levels);
 
+/** @brief Galerkin matrix and load vector, Dirichlet dofs already fixed */
+std::pair<Eigen::SparseMatrix<double>, Eigen::VectorXd> assembleFE(
+    std::shared_ptr<const lf::uscalfe::FeSpaceLagrangeO1<double>> fe_space);
+
 Eigen::VectorXd solveFE(std::shared_ptr<const lf::mesh::Mesh> mesh);
 
 double computeEnergy(std::shared_ptr<const lf::mesh::Mesh> mesh,
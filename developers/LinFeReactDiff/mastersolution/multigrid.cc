@@ -0,0 +1,288 @@
+/**
+ Geometric multigrid for the linear finite element systems of LinFeReactDiff
+ on the nested meshes of a lf::refinement::MeshHierarchy
+ */
+
+#include "multigrid.h"
+
+#include <lf/assemble/assemble.h>
+#include <lf/base/base.h>
+#include <lf/mesh/mesh.h>
+#include <lf/mesh/utils/utils.h>
+#include <lf/refinement/refinement.h>
+#include <lf/uscalfe/uscalfe.h>
+
+#include <Eigen/Core>
+#include <Eigen/IterativeLinearSolvers>
+#include <Eigen/SparseCore>
+#include <Eigen/SparseLU>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "linfereactdiff.h"
+
+namespace LinFeReactDiff {
+
+Eigen::SparseMatrix<double> prolongationMatrix(
+    const lf::refinement::MeshHierarchy &hierarchy, lf::base::size_type level,
+    const lf::assemble::DofHandler &dofh_coarse,
+    const lf::assemble::DofHandler &dofh_fine) {
+  std::shared_ptr<const lf::mesh::Mesh> coarse_mesh_p =
+      hierarchy.getMesh(level);
+  std::shared_ptr<const lf::mesh::Mesh> fine_mesh_p =
+      hierarchy.getMesh(level + 1);
+  auto coarse_bd{lf::mesh::utils::flagEntitiesOnBoundary(coarse_mesh_p, 2)};
+  auto fine_bd{lf::mesh::utils::flagEntitiesOnBoundary(fine_mesh_p, 2)};
+  const std::vector<lf::refinement::ParentInfo> &parents{
+      hierarchy.ParentInfos(level + 1, 2)};
+
+  std::vector<Eigen::Triplet<double>> triplets;
+  triplets.reserve(4 * fine_mesh_p->NumEntities(2));
+  for (const lf::mesh::Entity *node : fine_mesh_p->Entities(2)) {
+    if (fine_bd(*node)) continue;
+    const lf::base::glb_idx_t row = dofh_fine.GlobalDofIndices(*node)[0];
+    const lf::mesh::Entity *parent =
+        parents[fine_mesh_p->Index(*node)].parent_ptr;
+    // The new node is a coarse node, the midpoint of a coarse edge or the
+    // center of a coarse quadrilateral: equal weights of the parent's nodes
+    std::vector<const lf::mesh::Entity *> coarse_nodes;
+    if (parent->RefEl() == lf::base::RefEl::kPoint()) {
+      coarse_nodes.push_back(parent);
+    } else {
+      for (const lf::mesh::Entity *sub :
+           parent->SubEntities(2 - parent->Codim())) {
+        coarse_nodes.push_back(sub);
+      }
+    }
+    const double weight = 1.0 / coarse_nodes.size();
+    for (const lf::mesh::Entity *coarse_node : coarse_nodes) {
+      if (coarse_bd(*coarse_node)) continue;
+      const lf::base::glb_idx_t col =
+          dofh_coarse.GlobalDofIndices(*coarse_node)[0];
+      triplets.emplace_back(row, col, weight);
+    }
+  }
+  Eigen::SparseMatrix<double> P(dofh_fine.NumDofs(), dofh_coarse.NumDofs());
+  P.setFromTriplets(triplets.begin(), triplets.end());
+  return P;
+}
+
+void MultigridPreconditioner::setProlongations(
+    std::vector<Eigen::SparseMatrix<double>> prolongations, Smoother smoother,
+    unsigned int steps) {
+  P_ = std::move(prolongations);
+  smoother_ = smoother;
+  steps_ = steps;
+}
+
+MultigridPreconditioner &MultigridPreconditioner::compute(
+    const Eigen::SparseMatrix<double> &A) {
+  const unsigned int L = P_.size();
+  LF_VERIFY_MSG(L == 0 || P_.back().rows() == A.rows(),
+                "Finest prolongation does not match the matrix");
+  A_.resize(L + 1);
+  diag_.resize(L + 1);
+  Eigen::SparseMatrix<double> A_l = A;
+  for (unsigned int l = L + 1; l-- > 0;) {
+    if (l < L) {
+      // Galerkin coarse operator
+      A_l = Eigen::SparseMatrix<double>(P_[l].transpose() * A_l * P_[l]);
+      for (Eigen::Index i = 0; i < A_l.rows(); ++i) {
+        if (A_l.coeff(i, i) == 0.0) A_l.coeffRef(i, i) = 1.0;
+      }
+      A_l.makeCompressed();
+    }
+    A_[l] = A_l;
+    diag_[l] = A_l.diagonal();
+  }
+  coarse_ = std::make_shared<Eigen::SparseLU<Eigen::SparseMatrix<double>>>();
+  coarse_->compute(A_l);
+  info_ = coarse_->info();
+  return *this;
+}
+
+void MultigridPreconditioner::smooth(unsigned int l, const Eigen::VectorXd &b,
+                                     Eigen::VectorXd &x, bool forward) const {
+  const RowMatrix &A{A_[l]};
+  const Eigen::VectorXd &d{diag_[l]};
+#if SOLUTION
+  for (unsigned int s = 0; s < steps_; ++s) {
+    if (smoother_ == Smoother::kJacobi) {
+      x += (2.0 / 3.0) * (b - A * x).cwiseQuotient(d);
+      continue;
+    }
+    // Gauss-Seidel sweep over the rows, in reverse order for post-smoothing
+    const Eigen::Index n = A.rows();
+    for (Eigen::Index k = 0; k < n; ++k) {
+      const Eigen::Index i = forward ? k : n - 1 - k;
+      double r = b[i];
+      for (RowMatrix::InnerIterator it(A, i); it; ++it) {
+        r -= it.value() * x[it.col()];
+      }
+      x[i] += r / d[i];
+    }
+  }
+#else
+  //====================
+  // Your code goes here
+  //====================
+#endif
+}
+
+void MultigridPreconditioner::vcycle(unsigned int l, const Eigen::VectorXd &b,
+                                     Eigen::VectorXd &x) const {
+#if SOLUTION
+  if (l == 0) {
+    x = coarse_->solve(b);
+    return;
+  }
+  smooth(l, b, x, true);
+  // Coarse grid correction of the residual
+  const Eigen::VectorXd r_coarse = P_[l - 1].transpose() * (b - A_[l] * x);
+  Eigen::VectorXd e_coarse = Eigen::VectorXd::Zero(r_coarse.size());
+  vcycle(l - 1, r_coarse, e_coarse);
+  x += P_[l - 1] * e_coarse;
+  smooth(l, b, x, false);
+#else
+  //====================
+  // Your code goes here
+  //====================
+#endif
+}
+
+Eigen::VectorXd MultigridPreconditioner::solve(const Eigen::VectorXd &b) const {
+  Eigen::VectorXd x = Eigen::VectorXd::Zero(b.size());
+  vcycle(A_.size() - 1, b, x);
+  return x;
+}
+
+Eigen::VectorXd MultigridPreconditioner::fmg(const Eigen::VectorXd &b,
+                                             unsigned int cycles) const {
+  const unsigned int L = A_.size() - 1;
+  std::vector<Eigen::VectorXd> b_l(L + 1);
+  b_l[L] = b;
+  for (unsigned int l = L; l > 0; --l) {
+    b_l[l - 1] = P_[l - 1].transpose() * b_l[l];
+  }
+  Eigen::VectorXd x = coarse_->solve(b_l[0]);
+  for (unsigned int l = 1; l <= L; ++l) {
+    x = P_[l - 1] * x;
+    for (unsigned int c = 0; c < cycles; ++c) vcycle(l, b_l[l], x);
+  }
+  return x;
+}
+
+Eigen::Index MultigridPreconditioner::nonZeros() const {
+  Eigen::Index nnz = 0;
+  for (const RowMatrix &A : A_) nnz += A.nonZeros();
+  for (const Eigen::SparseMatrix<double> &P : P_) nnz += P.nonZeros();
+  return nnz;
+}
+
+namespace {
+
+using MultigridCG =
+    Eigen::ConjugateGradient<Eigen::SparseMatrix<double>,
+                             Eigen::Lower | Eigen::Upper,
+                             MultigridPreconditioner>;
+
+std::shared_ptr<const lf::uscalfe::FeSpaceLagrangeO1<double>> feSpace(
+    const lf::refinement::MeshHierarchy &hierarchy, lf::base::size_type level) {
+  return std::make_shared<const lf::uscalfe::FeSpaceLagrangeO1<double>>(
+      hierarchy.getMesh(level));
+}
+
+}  // namespace
+
+std::vector<Eigen::SparseMatrix<double>> prolongationMatrices(
+    const lf::refinement::MeshHierarchy &hierarchy, lf::base::size_type level) {
+  std::vector<Eigen::SparseMatrix<double>> prolongations;
+  auto coarse_space = feSpace(hierarchy, 0);
+  for (lf::base::size_type l = 0; l < level; ++l) {
+    auto fine_space = feSpace(hierarchy, l + 1);
+    prolongations.push_back(prolongationMatrix(hierarchy, l,
+                                               coarse_space->LocGlobMap(),
+                                               fine_space->LocGlobMap()));
+    coarse_space = fine_space;
+  }
+  return prolongations;
+}
+
+Eigen::VectorXd solveFEMultigrid(
+    const lf::refinement::MeshHierarchy &hierarchy, lf::base::size_type level,
+    double tol, unsigned int *iterations,
+    ConvergenceStudy::PhaseTimer *timer) {
+  auto [A, phi] = assembleFE(feSpace(hierarchy, level));
+  if (timer != nullptr) timer->lap(ConvergenceStudy::kAssemble);
+  MultigridCG cg;
+  cg.preconditioner().setProlongations(prolongationMatrices(hierarchy, level));
+  cg.setTolerance(tol);
+  cg.compute(A);
+  LF_VERIFY_MSG(cg.info() == Eigen::Success, "Multigrid setup failed");
+  // Full multigrid provides the initial guess
+  const Eigen::VectorXd mu =
+      cg.solveWithGuess(phi, cg.preconditioner().fmg(phi));
+  LF_VERIFY_MSG(cg.info() == Eigen::Success, "CG did not converge");
+  if (iterations != nullptr) *iterations = cg.iterations();
+  if (timer != nullptr) timer->lap(ConvergenceStudy::kSolve);
+  return mu;
+}
+
+void compareSolvers(const lf::refinement::MeshHierarchy &hierarchy,
+                    lf::base::size_type max_lu_dofs) {
+  using clock = std::chrono::steady_clock;
+  auto elapsed = [](clock::time_point start) -> double {
+    return std::chrono::duration<double, std::milli>(clock::now() - start)
+        .count();
+  };
+  std::cout << std::setw(8) << "level" << std::setw(10) << "#dofs"
+            << std::setw(8) << "CG its" << std::setw(12) << "MG nnz"
+            << std::setw(12) << "MG [ms]" << std::setw(12) << "LU nnz"
+            << std::setw(12) << "LU [ms]" << std::setw(12) << "diff"
+            << std::endl;
+  for (lf::base::size_type level = 0; level < hierarchy.NumLevels();
+       ++level) {
+    auto [A, phi] = assembleFE(feSpace(hierarchy, level));
+
+    clock::time_point start = clock::now();
+    MultigridCG cg;
+    cg.preconditioner().setProlongations(
+        prolongationMatrices(hierarchy, level));
+    cg.setTolerance(1.0E-10);
+    cg.compute(A);
+    const Eigen::VectorXd mu_mg =
+        cg.solveWithGuess(phi, cg.preconditioner().fmg(phi));
+    const double ms_mg = elapsed(start);
+
+    std::cout << std::setw(8) << level << std::setw(10) << A.rows()
+              << std::setw(8) << cg.iterations() << std::setw(12)
+              << cg.preconditioner().nonZeros() << std::setw(12) << ms_mg;
+    if (static_cast<lf::base::size_type>(A.rows()) > max_lu_dofs) {
+      std::cout << std::setw(12) << "-" << std::setw(12) << "-"
+                << std::setw(12) << "-" << std::endl;
+      continue;
+    }
+
+    start = clock::now();
+    Eigen::SparseLU<Eigen::SparseMatrix<double>> lu;
+    lu.compute(A);
+    const Eigen::VectorXd mu_lu = lu.solve(phi);
+    const double ms_lu = elapsed(start);
+    // Fill-in of the factors
+#if EIGEN_VERSION_AT_LEAST(3, 4, 0)
+    const Eigen::Index nnz_lu = lu.nnzL() + lu.nnzU();
+#else
+    const Eigen::Index nnz_lu = -1;  // not exposed by older Eigen versions
+#endif
+
+    std::cout << std::setw(12) << nnz_lu << std::setw(12) << ms_lu
+              << std::setw(12) << (mu_mg - mu_lu).lpNorm<Eigen::Infinity>()
+              << std::endl;
+  }
+}
+
+}  // namespace LinFeReactDiff
@@ -0,0 +1,148 @@
+#ifndef __MULTIGRID_H
+#define __MULTIGRID_H
+/**
+ Geometric multigrid for the linear finite element systems of LinFeReactDiff
+ on the nested meshes of a lf::refinement::MeshHierarchy
+ */
+
+#include <lf/assemble/assemble.h>
+#include <lf/base/base.h>
+#include <lf/refinement/refinement.h>
+
+#include <Eigen/Core>
+#include <Eigen/SparseCore>
+#include <Eigen/SparseLU>
+#include <memory>
+#include <vector>
+
+#include "../../../lecturecodes/helperfiles/convergencestudy.h"
+
+namespace LinFeReactDiff {
+
+/**
+ * @brief Prolongation matrix of piecewise linear finite elements with
+ * homogeneous Dirichlet boundary conditions from level to level+1 of a mesh
+ * hierarchy
+ *
+ * The row of a fine node carries the linear interpolation weights of the
+ * coarse nodes of its parent entity. Rows of fine boundary nodes and columns
+ * of coarse boundary nodes vanish, so that corrections never touch fixed
+ * dofs.
+ */
+Eigen::SparseMatrix<double> prolongationMatrix(
+    const lf::refinement::MeshHierarchy &hierarchy, lf::base::size_type level,
+    const lf::assemble::DofHandler &dofh_coarse,
+    const lf::assemble::DofHandler &dofh_fine);
+
+/**
+ * @brief Multigrid V-cycle for symmetric positive definite systems, models
+ * the preconditioner concept of Eigen's iterative solvers
+ *
+ * Given the prolongations P_0, ..., P_{L-1} from level l to level l+1,
+ * compute(A) builds the Galerkin coarse operators A_l = P_l^T A_{l+1} P_l
+ * with A_L = A. Zero diagonal entries of A_l (coarse dofs fixed by boundary
+ * conditions) are replaced by 1. The coarsest level is solved by SparseLU.
+ *
+ * Pre-smoothing runs forward and post-smoothing backward, so one V-cycle is
+ * a symmetric operator and can precondition CG:
+ *
+ *   Eigen::ConjugateGradient<Eigen::SparseMatrix<double>,
+ *                            Eigen::Lower | Eigen::Upper,
+ *                            MultigridPreconditioner> cg;
+ *   cg.preconditioner().setProlongations(prolongations);
+ *   cg.compute(A);
+ */
+class MultigridPreconditioner {
+ public:
+  enum class Smoother { kJacobi, kGaussSeidel };
+  using RowMatrix = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
+  MultigridPreconditioner() = default;
+
+  /**
+   * @param prolongations P_0, ..., P_{L-1}, P_l maps level l to level l+1
+   * @param smoother damped (2/3) Jacobi or Gauss-Seidel
+   * @param steps number of pre- and post-smoothing steps
+   */
+  void setProlongations(std::vector<Eigen::SparseMatrix<double>> prolongations,
+                        Smoother smoother = Smoother::kGaussSeidel,
+                        unsigned int steps = 1);
+
+  /** @brief Builds the Galerkin hierarchy for the finest matrix A */
+  MultigridPreconditioner &compute(const Eigen::SparseMatrix<double> &A);
+  template <typename MatrixType>
+  MultigridPreconditioner &analyzePattern(const MatrixType & /*A*/) {
+    return *this;
+  }
+  template <typename MatrixType>
+  MultigridPreconditioner &factorize(const MatrixType &A) {
+    return compute(A);
+  }
+  template <typename MatrixType>
+  MultigridPreconditioner &compute(const MatrixType &A) {
+    return compute(Eigen::SparseMatrix<double>(A));
+  }
+  Eigen::ComputationInfo info() const { return info_; }
+
+  /** @brief One V-cycle with zero initial guess */
+  Eigen::VectorXd solve(const Eigen::VectorXd &b) const;
+  /** @brief One V-cycle on level l starting from the initial guess x */
+  void vcycle(unsigned int l, const Eigen::VectorXd &b,
+              Eigen::VectorXd &x) const;
+  /**
+   * @brief Full multigrid: the right-hand side is restricted to all levels,
+   * solutions are prolongated upwards and improved by cycles V-cycles on
+   * every level
+   */
+  Eigen::VectorXd fmg(const Eigen::VectorXd &b, unsigned int cycles = 1) const;
+
+  unsigned int numLevels() const { return A_.size(); }
+  /** @brief Number of stored nonzeros of all operators and prolongations */
+  Eigen::Index nonZeros() const;
+
+ private:
+  void smooth(unsigned int l, const Eigen::VectorXd &b, Eigen::VectorXd &x,
+              bool forward) const;
+
+  std::vector<Eigen::SparseMatrix<double>> P_;
+  Smoother smoother_ = Smoother::kGaussSeidel;
+  unsigned int steps_ = 1;
+  // Operators A_[0] (coarsest), ..., A_[L] (finest), row-major for smoothing
+  std::vector<RowMatrix> A_;
+  std::vector<Eigen::VectorXd> diag_;
+  // SparseLU is not copyable, Eigen's solvers store the preconditioner
+  std::shared_ptr<Eigen::SparseLU<Eigen::SparseMatrix<double>>> coarse_;
+  Eigen::ComputationInfo info_ = Eigen::Success;
+};
+
+/** @brief Prolongation matrices P_0, ..., P_{level-1} of a mesh hierarchy */
+std::vector<Eigen::SparseMatrix<double>> prolongationMatrices(
+    const lf::refinement::MeshHierarchy &hierarchy, lf::base::size_type level);
+
+/**
+ * @brief Solves the problem of LinFeReactDiff on mesh level of the hierarchy
+ * by CG preconditioned with a multigrid V-cycle on the levels 0, ..., level
+ *
+ * @param tol relative tolerance of CG
+ * @param iterations if not nullptr, receives the number of CG iterations
+ * @param timer if not nullptr, the assembly and the multigrid setup and
+ * solve are charged to its phases
+ */
+Eigen::VectorXd solveFEMultigrid(
+    const lf::refinement::MeshHierarchy &hierarchy, lf::base::size_type level,
+    double tol = 1.0E-10, unsigned int *iterations = nullptr,
+    ConvergenceStudy::PhaseTimer *timer = nullptr);
+
+/**
+ * @brief Prints CG iterations, time and number of stored nonzeros for
+ * multigrid-preconditioned CG and SparseLU on all levels of the hierarchy
+ *
+ * @param max_lu_dofs SparseLU is skipped on levels with more unknowns, whose
+ * factors would not fit into memory
+ */
+void compareSolvers(const lf::refinement::MeshHierarchy &hierarchy,
+                    lf::base::size_type max_lu_dofs = 100000);
+
+}  // namespace LinFeReactDiff
+
+#endif  // define __MULTIGRID_H
@@ -19,4 +19,5 @@ set(LIBRARIES
   LF::lf.mesh
   LF::lf.mesh.hybrid2d
   LF::lf.mesh.utils
+  LF::lf.refinement
 )
@@ -1,5 +1,6 @@
 
 #include "../linfereactdiff.h"
+#include "../multigrid.h"
 
 #include <gtest/gtest.h>
 #include <lf/assemble/assemble.h>
@@ -9,6 +10,7 @@
 #include <lf/mesh/hybrid2d/hybrid2d.h>
 #include <lf/mesh/mesh.h>
 #include <lf/mesh/utils/utils.h>
+#include <lf/refinement/refinement.h>
 #include <lf/uscalfe/uscalfe.h>
 
 #include <Eigen/Core>
@@ -90,4 +92,25 @@ TEST(LinFeReactDiff, TestEnergy) {
   ASSERT_NEAR(energy, 0.0105153, 0.00001);
 }
 
+TEST(LinFeReactDiff, TestMultigrid) {
+  auto mesh_factory = std::make_unique<lf::mesh::hybrid2d::MeshFactory>(2);
+  lf::io::GmshReader reader(std::move(mesh_factory), mesh_file);
+  std::shared_ptr<lf::refinement::MeshHierarchy> multi_mesh_p =
+      lf::refinement::GenerateMeshHierarchyByUniformRefinemnt(reader.mesh(),
+                                                              3);
+  const lf::refinement::MeshHierarchy &multi_mesh{*multi_mesh_p};
+
+  // Agreement with the direct solver, mesh-independent number of iterations
+  for (lf::base::size_type level = 0; level < multi_mesh.NumLevels();
+       ++level) {
+    unsigned int iterations = 0;
+    Eigen::VectorXd mu_mg =
+        solveFEMultigrid(multi_mesh, level, 1.0E-12, &iterations);
+    Eigen::VectorXd mu_lu = solveFE(multi_mesh.getMesh(level));
+    ASSERT_EQ(mu_mg.size(), mu_lu.size());
+    EXPECT_NEAR((mu_mg - mu_lu).lpNorm<Eigen::Infinity>(), 0.0, 1.0E-10);
+    EXPECT_LE(iterations, 15u);
+  }
+}
+
 }  // namespace LinFeReactDiff::test
@@ -9,6 +9,8 @@
 set(SOURCES
   ${DIR}/mirk_main.cc
   ${DIR}/mirk.h
+  ${DIR}/mirkbvp.h
+  ${DIR}/mirkbvp.cc
 )
 
 set(LIBRARIES
@@ -11,6 +11,10 @@
 #include <gtest/gtest.h>
 
 #include <Eigen/Core>
+#include <cmath>
+#include <utility>
+
+#include "../mirkbvp.h"
 
 namespace MIRK::test {
 
@@ -38,4 +42,102 @@ TEST(MIRK, Newton2Steps) {
   EXPECT_NEAR(0.0, err, 1E-7);
 }
 
-}  // namespace MIRK::test
\ No newline at end of file
+// y'' = mu^2 y, y(0) = 1, y(1) = 0 as first order system
+constexpr double mu = 5.0;
+Eigen::VectorXd fL(double, const Eigen::VectorXd &y) {
+  return Eigen::Vector2d(y(1), mu * mu * y(0));
+}
+Eigen::MatrixXd dfL(double, const Eigen::VectorXd &) {
+  Eigen::MatrixXd J(2, 2);
+  J << 0.0, 1.0, mu * mu, 0.0;
+  return J;
+}
+Eigen::VectorXd gL(const Eigen::VectorXd &ya, const Eigen::VectorXd &yb) {
+  return Eigen::Vector2d(ya(0) - 1.0, yb(0));
+}
+std::pair<Eigen::MatrixXd, Eigen::MatrixXd> dgL(const Eigen::VectorXd &,
+                                                const Eigen::VectorXd &) {
+  Eigen::MatrixXd Ba = Eigen::MatrixXd::Zero(2, 2);
+  Eigen::MatrixXd Bb = Eigen::MatrixXd::Zero(2, 2);
+  Ba(0, 0) = 1.0;
+  Bb(1, 0) = 1.0;
+  return {Ba, Bb};
+}
+double maxError(const Eigen::VectorXd &t, const Eigen::MatrixXd &Y) {
+  double err = 0.0;
+  for (int k = 0; k < t.size(); ++k) {
+    double yex = std::sinh(mu * (1.0 - t(k))) / std::sinh(mu);
+    err = std::max(err, std::abs(Y(0, k) - yex));
+  }
+  return err;
+}
+
+TEST(MIRK, MIRKIntervalResidual) {
+  // Nonlinear, non-autonomous right hand side
+  auto f = [](double t, const Eigen::VectorXd &y) {
+    return Eigen::VectorXd(Eigen::Vector2d(y(1) * y(1) + t, -std::sin(y(0))));
+  };
+  auto df = [](double, const Eigen::VectorXd &y) {
+    Eigen::MatrixXd J(2, 2);
+    J << 0.0, 2.0 * y(1), -std::cos(y(0)), 0.0;
+    return J;
+  };
+  const double t = 0.3, h = 0.2;
+  Eigen::VectorXd yk = Eigen::Vector2d(0.5, -1.0);
+  Eigen::VectorXd yk1 = Eigen::Vector2d(0.7, -0.8);
+  Eigen::VectorXd Phi, Phi_eps;
+  Eigen::MatrixXd L, R, L_eps, R_eps;
+  MIRKIntervalResidual(f, df, t, h, yk, yk1, Phi, L, R);
+
+  // Compare Jacobian blocks with central difference quotients
+  const double eps = 1E-6;
+  for (int j = 0; j < 2; ++j) {
+    Eigen::VectorXd e = eps * Eigen::VectorXd::Unit(2, j);
+    Eigen::VectorXd Phi_plus, Phi_minus;
+    MIRKIntervalResidual(f, df, t, h, yk + e, yk1, Phi_plus, L_eps, R_eps);
+    MIRKIntervalResidual(f, df, t, h, yk - e, yk1, Phi_minus, L_eps, R_eps);
+    EXPECT_NEAR(0.0, (L.col(j) - (Phi_plus - Phi_minus) / (2 * eps)).norm(),
+                1E-8);
+    MIRKIntervalResidual(f, df, t, h, yk, yk1 + e, Phi_plus, L_eps, R_eps);
+    MIRKIntervalResidual(f, df, t, h, yk, yk1 - e, Phi_minus, L_eps, R_eps);
+    EXPECT_NEAR(0.0, (R.col(j) - (Phi_plus - Phi_minus) / (2 * eps)).norm(),
+                1E-8);
+  }
+}
+
+TEST(MIRK, MIRKCollocation) {
+  // Second order convergence on uniform meshes
+  double err_old = 0.0;
+  for (int M : {50, 100, 200}) {
+    Eigen::VectorXd t = Eigen::VectorXd::LinSpaced(M + 1, 0.0, 1.0);
+    Eigen::MatrixXd Y = Eigen::MatrixXd::Zero(2, M + 1);
+    unsigned int iter = MIRKCollocation(fL, dfL, gL, dgL, t, Y);
+    // Linear problem: exact after the first Newton step
+    EXPECT_LE(iter, 2);
+    double err = maxError(t, Y);
+    if (err_old > 0.0) {
+      EXPECT_NEAR(err_old / err, 4.0, 0.2);
+    }
+    err_old = err;
+  }
+}
+
+TEST(MIRK, MIRKBVPSolve) {
+  Eigen::VectorXd t = Eigen::VectorXd::LinSpaced(5, 0.0, 1.0);
+  Eigen::MatrixXd Y = Eigen::MatrixXd::Zero(2, 5);
+  MIRKBVPOptions options;
+  options.tol = 1E-6;
+  MIRKBVPStatistics stats = MIRKBVPSolve(fL, dfL, gL, dgL, t, Y, options);
+  EXPECT_TRUE(stats.converged);
+  EXPECT_GT(stats.meshes, 1);
+  EXPECT_LT(maxError(t, Y), 10 * options.tol);
+  // The defect estimates of the final mesh are below the tolerance
+  EXPECT_LE(MIRKDefect(fL, t, Y).maxCoeff(), options.tol);
+
+  // Shooting on the same problem
+  Eigen::MatrixXd Ys = ShootingBVPSolve(fL, dfL, gL, dgL, 0.0, 1.0,
+                                        Eigen::Vector2d(1.0, 0.0), 100);
+  EXPECT_LT(maxError(Eigen::VectorXd::LinSpaced(101, 0.0, 1.0), Ys), 1E-6);
+}
+
+}  // namespace MIRK::test
@@ -10,6 +10,7 @@ set(SOURCES
   ${DIR}/matode_main.cc
   ${DIR}/matode.h
   ${DIR}/matode.cc
+  ${DIR}/matodestepper.h
 )
 
 set(LIBRARIES
@@ -4,7 +4,16 @@
  * @copyright Developed at ETH Zurich
  */
 
+#include "matode.h"
+
 #include <Eigen/Dense>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "matodestepper.h"
 
 namespace MatODE {
 
@@ -57,4 +66,63 @@ Eigen::MatrixXd impstep(const Eigen::MatrixXd& A, const Eigen::MatrixXd& Y0,
 }
 /* SAM_LISTING_END_5 */
 
+/* SAM_LISTING_BEGIN_7 */
+void benchmarkMatODEStepper() {
+  const int n = 5;
+  const double h = 0.01;
+  const unsigned int steps = 200000;  // steps per measurement
+  // Skew-symmetric A, Y' = AY preserves orthogonality
+  Eigen::Matrix<double, n, n> A;
+  A << 0, 1, 1, 1, 1, -1, 0, 1, 1, 1, -1, -1, 0, 1, 1, -1, -1, -1, 0, 1, -1,
+      -1, -1, -1, 0;
+  const Eigen::Matrix<double, n, n> I = Eigen::Matrix<double, n, n>::Identity();
+
+  // Runs func(), which performs the given number of matrix steps, and prints
+  // the number of steps per second
+  auto measure = [](const char *name, unsigned int count, auto &&func) {
+    auto start = std::chrono::high_resolution_clock::now();
+    const double checksum = func();
+    auto end = std::chrono::high_resolution_clock::now();
+    const double time = std::chrono::duration<double>(end - start).count();
+    std::cout << std::left << std::setw(38) << name << std::right
+              << std::setw(14) << count / time << std::setw(14) << checksum
+              << std::endl;
+  };
+
+  std::cout << "Implicit midpoint rule for " << n << " x " << n
+            << " matrices" << std::endl
+            << std::left << std::setw(38) << "method" << std::right
+            << std::setw(14) << "steps/s" << std::setw(14) << "checksum"
+            << std::endl;
+  measure("impstep (LU in every step)", steps, [&] {
+    Eigen::MatrixXd Y = I;
+    for (unsigned int k = 0; k < steps; ++k) Y = impstep(A, Y, h);
+    return Y.sum();
+  });
+  measure("MatODEStepper<Dynamic>", steps, [&] {
+    MatODEStepper<> stepper(A, h, StepMethod::ImplicitMidpoint);
+    Eigen::MatrixXd Y = I;
+    for (unsigned int k = 0; k < steps; ++k) Y = stepper.step(Y);
+    return Y.sum();
+  });
+  measure("MatODEStepper<5>", steps, [&] {
+    MatODEStepper<n> stepper(A, h, StepMethod::ImplicitMidpoint);
+    Eigen::Matrix<double, n, n> Y = I;
+    for (unsigned int k = 0; k < steps; ++k) Y = stepper.step(Y);
+    return Y.sum();
+  });
+  // Batches of K initial values, each advanced by steps / K steps
+  for (unsigned int K : {10, 1000}) {
+    const std::string name = "MatODEStepper<5>, batch of " + std::to_string(K);
+    measure(name.c_str(), steps, [&] {
+      MatODEStepper<n> stepper(A, h, StepMethod::ImplicitMidpoint);
+      const std::vector<Eigen::Matrix<double, n, n>> Y0(K, I);
+      MatODEStepper<n>::Batch Y = MatODEStepper<n>::pack(Y0);
+      stepper.steps(Y, steps / K);
+      return Y.sum() / K;
+    });
+  }
+}
+/* SAM_LISTING_END_7 */
+
 }  // namespace MatODE
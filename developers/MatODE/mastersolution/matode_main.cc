@@ -59,5 +59,7 @@ int main(int /*argc*/, char** /*argv*/) {
   //====================
 #endif
   /* SAM_LISTING_END_6 */
+
+  MatODE::benchmarkMatODEStepper();
   return 0;
 }
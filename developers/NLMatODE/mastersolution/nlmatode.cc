@@ -2,12 +2,13 @@
 
 #include <Eigen/Core>
 #include <Eigen/LU>
+#include <chrono>
 #include <cmath>
+#include <cstdlib>
 #include <iostream>
 #include <limits>
+#include <vector>
 
-// Supplies class Ode45
-#include "../../../lecturecodes/Ode45/ode45.h"
 // Supplied auxiliary function for linear regression
 #include "../../../lecturecodes/helperfiles/polyfit.h"
 
@@ -113,4 +114,35 @@ double cvgDiscreteGradientMethod() {
 }
 /* SAM_LISTING_END_3 */
 
+/* SAM_LISTING_BEGIN_5 */
+void benchmarkMatodeBatch() {
+  const unsigned int K = 2000;
+  const double T = 1.0;
+  // Random initial values, scaled to norm 1
+  std::srand(1);
+  std::vector<Eigen::Matrix<double, 5, 5>> Y0(K);
+  for (auto &Y : Y0) {
+    Y.setRandom();
+    Y.normalize();
+  }
+
+  auto start = std::chrono::high_resolution_clock::now();
+  double diff = 0.0;
+  for (const auto &Y : Y0) diff += matode(Y, T).norm();
+  auto end = std::chrono::high_resolution_clock::now();
+  const double t_dyn = std::chrono::duration<double>(end - start).count();
+
+  start = std::chrono::high_resolution_clock::now();
+  const std::vector<Eigen::Matrix<double, 5, 5>> YT = matodeBatch(Y0, T);
+  end = std::chrono::high_resolution_clock::now();
+  const double t_fix = std::chrono::duration<double>(end - start).count();
+  for (const auto &Y : YT) diff -= Y.norm();
+
+  std::cout << "\nmatode for " << K << " random 5 x 5 matrices:\n"
+            << "Eigen::MatrixXd:          " << K / t_dyn << " matrices/s\n"
+            << "matodeBatch<5>:           " << K / t_fix << " matrices/s\n"
+            << "difference of the norms:  " << std::abs(diff) << std::endl;
+}
+/* SAM_LISTING_END_5 */
+
 }  // namespace NLMatODE
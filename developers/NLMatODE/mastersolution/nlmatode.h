@@ -2,6 +2,11 @@
 #define NLMATODE_H_
 
 #include <Eigen/Core>
+#include <cstddef>
+#include <vector>
+
+// Supplies class Ode45
+#include "../../../lecturecodes/Ode45/ode45.h"
 
 namespace NLMatODE {
 
@@ -15,6 +20,46 @@ bool checkinvariant(const Eigen::MatrixXd &M, double T);
 
 double cvgDiscreteGradientMethod();
 
+//! \brief Same as matode() for many initial values of size N x N known at
+//! compile time. Then all states and increments of Ode45 have fixed size and
+//! need no heap allocations, and the right-hand side is not wrapped in a
+//! std::function.
+//! \param[in] Y0 Initial data Y_k(0), k = 0, ..., K-1
+//! \param[in] T final time of simulation
+//! \return The matrices Y_k(T)
+template <int N>
+std::vector<Eigen::Matrix<double, N, N>> matodeBatch(
+    const std::vector<Eigen::Matrix<double, N, N>> &Y0, double T);
+
+//! \brief Compares the run times of matode() and matodeBatch() for 5 x 5
+//! matrices
+void benchmarkMatodeBatch();
+
+/* SAM_LISTING_BEGIN_4 */
+template <int N>
+std::vector<Eigen::Matrix<double, N, N>> matodeBatch(
+    const std::vector<Eigen::Matrix<double, N, N>> &Y0, double T) {
+  using Matrix = Eigen::Matrix<double, N, N>;
+  std::vector<Matrix> YT(Y0.size(), Matrix::Zero());
+#if SOLUTION
+  auto F = [](const Matrix &M) -> Matrix { return -(M - M.transpose()) * M; };
+  // One solver object for all initial values
+  Ode45<Matrix, decltype(F)> O(F);
+  O.options.atol = 1e-10;
+  O.options.rtol = 1e-8;
+  O.options.save_init = false;
+  for (std::size_t k = 0; k < Y0.size(); ++k) {
+    YT[k] = O.solve(Y0[k], T).back().first;
+  }
+#else
+  //====================
+  // Your code goes here
+  //====================
+#endif
+  return YT;
+}
+/* SAM_LISTING_END_4 */
+
 }  // namespace NLMatODE
 
 #endif  // #define NLMATODE_H_
@@ -14,6 +14,8 @@
 #include <iostream>
 #include <vector>
 
+#include "../../../lecturecodes/Ode45/stepsizecontrol.h"
+
 namespace ODESolve {
 
 /**
@@ -21,6 +23,7 @@ namespace ODESolve {
  * step-size y0.
  * @tparam DiscEvlOp type for evolution operator (e.g. lambda
  * function type)
+ * @tparam State type of the state, e.g. double or Eigen::VectorXd
  * @param Psi original evolution operator
  * @param p parameter p for construction of Psi tilde
  * @param h step-size
@@ -28,8 +31,9 @@ namespace ODESolve {
  * @return Evolved step \f$ \tilde{\Psi}^h y0 \f$
  */
 /* SAM_LISTING_BEGIN_0 */
-template <class DiscEvlOp>
-double PsiTilde(const DiscEvlOp& Psi, unsigned int p, double h, double y0) {
+template <class DiscEvlOp, class State>
+State PsiTilde(const DiscEvlOp& Psi, unsigned int p, double h,
+               const State& y0) {
 #if SOLUTION
   return (Psi(h, y0) - std::pow(2, p) * Psi(h / 2., Psi(h / 2., y0))) /
          (1. - std::pow(2, p));
@@ -89,6 +93,7 @@ double TestCvpExtrapolatedEuler();
  * @brief Evolves the vector y0 using the evolution operator from time 0 to T
  * using adaptive error control
  * @tparam DiscEvlOp type of the evolution operator
+ * @tparam State type of the state, e.g. double or Eigen::VectorXd
  * @param Psi original evolution operator
  * @param p parameter p for construction of Psi tilde
  * @param y0 initial data
@@ -101,41 +106,43 @@ double TestCvpExtrapolatedEuler();
  * @return pair of vectors (t_k,y_k)
  */
 /* SAM_LISTING_BEGIN_3 */
-template <class DiscEvlOp>
-std::pair<std::vector<double>, std::vector<double>> OdeIntSsCtrl(
-    const DiscEvlOp& Psi, unsigned int p, double y0, double T, double h0,
+template <class DiscEvlOp, class State>
+std::pair<std::vector<double>, std::vector<State>> OdeIntSsCtrl(
+    const DiscEvlOp& Psi, unsigned int p, const State& y0, double T, double h0,
     double reltol, double abstol, double hmin) {
+  std::vector<double> t;
+  std::vector<State> Y;
+
+#if SOLUTION
+  // Psi and the extrapolated PsiTilde form an embedded pair of orders p and
+  // p+1. The PI controller smoothes the sequence of step sizes, the observer
+  // records the initial state and the accepted steps.
+  StepSizeControl::PIDController ctrl = StepSizeControl::PIDController::PI(p);
+  StepSizeControl::integrate(
+      [&Psi, p](double h, const State& y, State& y_high, State& y_low) {
+        y_high = PsiTilde(Psi, p, h, y);
+        y_low = Psi(h, y);
+      },
+      y0, T, h0, reltol, abstol, hmin, ctrl,
+      [&t, &Y](double tk, const State& yk) {
+        t.push_back(tk);
+        Y.push_back(yk);
+      });
+#else
   double h = h0;
-  std::vector<double> Y, t;
   Y.push_back(y0);
   t.push_back(0.0);
-
-  double y = y0;
-
+  State y = y0;
   while (t.back() < T && h > hmin) {
-#if SOLUTION
-    double y_high = PsiTilde(Psi, p, std::min(T - t.back(), h), y);
-    double y_low = Psi(std::min(T - t.back(), h), y);
-    double est = std::abs(y_high - y_low);
-    double tol = std::max(reltol * std::abs(y), abstol);
-
-    if (est < tol) {
-      y = y_high;
-      t.push_back(t.back() + std::min(T - t.back(), h));
-      Y.push_back(y_high);
-    }
-    h = h * std::max(0.5, std::min(2., std::pow(tol / est, 1. / (p + 1))));
-#else
-    double y_high = 1.0;  // TODO: fix this line
-    double y_low = 0.0;   // TODO: fix this line
-    double est = std::abs(y_high - y_low);
+    State y_high = y0;  // TODO: fix this line
+    State y_low = y0;   // TODO: fix this line
+    double est = StepSizeControl::defaultNorm(State(y_high - y_low));
     if (true /* TODO: fix this line */) {
       y = y_high;
       t.push_back(t.back() + std::min(T - t.back(), h));
       Y.push_back(y_high);
     }
     // TODO: update $h$
-#endif
   }
   if (h < hmin) {
     std::cerr << "Warning: Failure at t=" << t.back()
@@ -143,6 +150,7 @@ std::pair<std::vector<double>, std::vector<double>> OdeIntSsCtrl(
                  "step size below the smallest value allowed ("
               << hmin << ") at time t." << std::endl;
   }
+#endif
 
   return {t, Y};
 }
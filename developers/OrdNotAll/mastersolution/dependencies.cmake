@@ -10,6 +10,7 @@ set(SOURCES
   ${DIR}/ordnotall_main.cc
   ${DIR}/ordnotall.h
   ${DIR}/ordnotall.cc
+  ${DIR}/rkengine.h
   ${DIR}/rkintegrator.h
 )
 
@@ -2,5 +2,6 @@
 
 int main() {
   OrdNotAll::cmpCvgRKSSM();
+  OrdNotAll::benchmarkRKEngine();
   return 0;
 }
@@ -0,0 +1,258 @@
+#ifndef RKENGINE_H_
+#define RKENGINE_H_
+
+#include <Eigen/Dense>
+#include <array>
+#include <cassert>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace OrdNotAll {
+
+//! \file rkengine.h Explicit Runge-Kutta engine for Butcher tableaux known
+//! at compile time or at run time.
+
+/*!
+ *! \brief Butcher tableaux known at compile time. A tableau type provides
+ *! the number of stages \a s and constexpr arrays \a A (strictly lower
+ *! triangular) and \a b.
+ */
+/* SAM_LISTING_BEGIN_0 */
+struct ExplicitEulerTableau {
+  static constexpr int s = 1;
+  static constexpr double A[s][s] = {{0.0}};
+  static constexpr double b[s] = {1.0};
+};
+
+struct TrapezoidalTableau {
+  static constexpr int s = 2;
+  static constexpr double A[s][s] = {{0.0, 0.0}, {1.0, 0.0}};
+  static constexpr double b[s] = {0.5, 0.5};
+};
+
+struct RK3Tableau {
+  static constexpr int s = 3;
+  static constexpr double A[s][s] = {
+      {0.0, 0.0, 0.0}, {0.5, 0.0, 0.0}, {-1.0, 2.0, 0.0}};
+  static constexpr double b[s] = {1.0 / 6.0, 2.0 / 3.0, 1.0 / 6.0};
+};
+
+struct ClassicalRK4Tableau {
+  static constexpr int s = 4;
+  static constexpr double A[s][s] = {{0.0, 0.0, 0.0, 0.0},
+                                     {0.5, 0.0, 0.0, 0.0},
+                                     {0.0, 0.5, 0.0, 0.0},
+                                     {0.0, 0.0, 1.0, 0.0}};
+  static constexpr double b[s] = {1.0 / 6.0, 1.0 / 3.0, 1.0 / 3.0, 1.0 / 6.0};
+};
+
+// Third order method of Bogacki and Shampine, whose last stage is evaluated
+// at the new state ("first same as last")
+struct BogackiShampineTableau {
+  static constexpr int s = 4;
+  static constexpr double A[s][s] = {{0.0, 0.0, 0.0, 0.0},
+                                     {0.5, 0.0, 0.0, 0.0},
+                                     {0.0, 0.75, 0.0, 0.0},
+                                     {2.0 / 9.0, 1.0 / 3.0, 4.0 / 9.0, 0.0}};
+  static constexpr double b[s] = {2.0 / 9.0, 1.0 / 3.0, 4.0 / 9.0, 0.0};
+};
+/* SAM_LISTING_END_0 */
+
+/*!
+ *! \brief Butcher tableau given at run time, marked by \a s = 0 in analogy
+ *! to Eigen::Dynamic.
+ */
+struct DynamicTableau {
+  static constexpr int s = 0;
+  DynamicTableau(const Eigen::MatrixXd &A, const Eigen::VectorXd &b)
+      : A(A), b(b) {
+    assert(A.cols() == A.rows() && "Matrix must be square.");
+    assert(A.cols() == b.size() && "Incompatible matrix/vector size.");
+  }
+  const Eigen::MatrixXd A;
+  const Eigen::VectorXd b;
+};
+
+/*!
+ *! \brief Checks whether the last stage of an explicit RK method coincides
+ *! with the next state, so that its increment can be reused as the first
+ *! increment of the next step.
+ */
+template <class Tableau>
+constexpr bool isFSAL() {
+  constexpr int s = Tableau::s;
+  if (s < 2) return false;
+  for (int j = 0; j < s; ++j) {
+    if (Tableau::A[s - 1][j] != Tableau::b[j]) return false;
+  }
+  return true;
+}
+
+inline bool isFSAL(const DynamicTableau &tab) {
+  const int s = tab.b.size();
+  return s >= 2 && tab.A.row(s - 1).transpose() == tab.b;
+}
+
+/*!
+ *! \brief Explicit Runge-Kutta method for autonomous ODEs $y' = f(y)$.
+ *! For tableaux known at compile time, the linear combinations of the
+ *! increments are unrolled and vanishing coefficients are skipped at compile
+ *! time. The increments are stored in member variables, which are allocated
+ *! once and reused in every step. If the tableau allows, the last increment
+ *! of a step is reused as first increment of the next step (FSAL).
+ *! \tparam Tableau a compile-time tableau type or DynamicTableau
+ *! \tparam State a type representing the space in which the solution
+ *! lies, e.g. double, Eigen::Vector2d or Eigen::VectorXd.
+ */
+template <class Tableau, class State = Eigen::VectorXd>
+class ExplicitRKEngine {
+ public:
+  static constexpr int s = Tableau::s;
+
+  ExplicitRKEngine() = default;
+  explicit ExplicitRKEngine(Tableau tab) : tab_(std::move(tab)) {
+    if constexpr (s == 0) {
+      fsal_ = isFSAL(tab_);
+      k_.resize(tab_.b.size());
+    }
+  }
+
+  /*!
+   *! \brief Performs $N$ equidistant steps up to time $T$ with initial data
+   *! $y_0$ and calls observer(n, y) for the initial state (n = 0) and after
+   *! every step n = 1, ..., N.
+   *! \return The final state $y^N$.
+   */
+  template <class Function, class Observer>
+  State solve(const Function &f, double T, const State &y0, unsigned int N,
+              Observer &&observer) {
+    const double h = T / N;
+    State y = y0;
+    State ynew = y0;
+    observer(0, y);
+    have_k0_ = false;
+    for (unsigned int n = 1; n <= N; ++n) {
+      step(f, h, y, ynew);
+      std::swap(y, ynew);
+      observer(n, y);
+    }
+    return y;
+  }
+
+  /*!
+   *! \brief Same as above, only the final state $y^N$ is computed.
+   */
+  template <class Function>
+  State solve(const Function &f, double T, const State &y0, unsigned int N) {
+    return solve(f, T, y0, N, [](unsigned int, const State &) {});
+  }
+
+  /*!
+   *! \brief Returns the states $y^n$ for n = 0, k, 2k, ... and for n = N.
+   */
+  template <class Function>
+  std::vector<State> solveEvery(const Function &f, double T, const State &y0,
+                                unsigned int N, unsigned int k) {
+    std::vector<State> res;
+    res.reserve(N / k + 2);
+    solve(f, T, y0, N, [&res, k, N](unsigned int n, const State &y) {
+      if (n % k == 0 || n == N) res.push_back(y);
+    });
+    return res;
+  }
+
+ private:
+  /*!
+   *! \brief Single step $y_1 = y_0 + h \sum_i b_i k_i$.
+   */
+  template <class Function>
+  void step(const Function &f, double h, const State &y0, State &y1) {
+    if constexpr (s > 0) {
+      stepStatic(f, h, y0, y1, std::make_index_sequence<s>());
+    } else {
+      stepDynamic(f, h, y0, y1);
+    }
+  }
+
+  // Unrolled stages for compile-time tableaux
+  template <class Function, std::size_t... I>
+  void stepStatic(const Function &f, double h, const State &y0, State &y1,
+                  std::index_sequence<I...>) {
+    (stage<I>(f, h, y0), ...);
+    if constexpr (isFSAL<Tableau>()) {
+      // The last stage was evaluated at y1
+      std::swap(y1, ytmp_);
+      std::swap(k_[0], k_[s - 1]);
+      have_k0_ = true;
+    } else {
+      y1 = y0;
+      (addB<I>(h, y1), ...);
+    }
+  }
+
+  template <std::size_t I, class Function>
+  void stage(const Function &f, double h, const State &y0) {
+    if constexpr (I == 0) {
+      if (!have_k0_) k_[0] = f(y0);
+    } else {
+      ytmp_ = y0;
+      addStage<I>(h, std::make_index_sequence<I>());
+      k_[I] = f(ytmp_);
+    }
+  }
+
+  template <std::size_t I, std::size_t... J>
+  void addStage(double h, std::index_sequence<J...>) {
+    (addA<I, J>(h), ...);
+  }
+
+  // Terms with vanishing coefficients are omitted at compile time
+  template <std::size_t I, std::size_t J>
+  void addA(double h) {
+    if constexpr (Tableau::A[I][J] != 0.0) {
+      ytmp_ += (h * Tableau::A[I][J]) * k_[J];
+    }
+  }
+  template <std::size_t I>
+  void addB(double h, State &y1) const {
+    if constexpr (Tableau::b[I] != 0.0) y1 += (h * Tableau::b[I]) * k_[I];
+  }
+
+  // Loops for tableaux given at run time
+  template <class Function>
+  void stepDynamic(const Function &f, double h, const State &y0, State &y1) {
+    const int stages = tab_.b.size();
+    if (!have_k0_) k_[0] = f(y0);
+    for (int i = 1; i < stages; ++i) {
+      ytmp_ = y0;
+      for (int j = 0; j < i; ++j) {
+        if (tab_.A(i, j) != 0.0) ytmp_ += (h * tab_.A(i, j)) * k_[j];
+      }
+      k_[i] = f(ytmp_);
+    }
+    if (fsal_) {
+      std::swap(y1, ytmp_);
+      std::swap(k_[0], k_[stages - 1]);
+      have_k0_ = true;
+    } else {
+      y1 = y0;
+      for (int i = 0; i < stages; ++i) {
+        if (tab_.b(i) != 0.0) y1 += (h * tab_.b(i)) * k_[i];
+      }
+    }
+  }
+
+  Tableau tab_;
+  bool fsal_ = false;     // FSAL property of tableaux given at run time
+  bool have_k0_ = false;  // k_[0] holds f(y0) from the previous step
+  //! Increments and intermediate state, reused in every step
+  std::conditional_t<(s > 0), std::array<State, (s > 0 ? s : 1)>,
+                     std::vector<State>>
+      k_;
+  State ytmp_;
+};
+
+}  // namespace OrdNotAll
+
+#endif  // RKENGINE_H_
@@ -0,0 +1,18 @@
+#if SOLUTION
+# Dependencies of mastersolution:
+#else
+# Add your custom dependencies here:
+#endif
+
+# DIR will be provided by the calling file.
+
+set(SOURCES
+  ${DIR}/rkengine.h
+  ${DIR}/rkintegrator.h
+  ${DIR}/test/ordnotall_test.cc
+)
+
+set(LIBRARIES
+  Eigen3::Eigen
+  GTest::gtest_main
+)
@@ -1,3 +1,5 @@
+#ifndef RESIDUALERRORESTIMATOR_H
+#define RESIDUALERRORESTIMATOR_H
 /**
  * @file
  * @brief NPDE homework ResidualErrorEstimator
@@ -6,8 +8,11 @@
  * @ copyright Developed at SAM, ETH Zurich
  */
 
+#include <array>
 #include <iostream>
 #include <memory>
+#include <utility>
+#include <vector>
 // Lehrfem++ includes
 #include <lf/assemble/assemble.h>
 #include <lf/fe/fe.h>
@@ -17,9 +22,15 @@
 #include <lf/mesh/test_utils/test_meshes.h>
 #include <lf/mesh/utils/utils.h>
 #include <lf/quad/quad.h>
+#include <lf/refinement/refinement.h>
 #include <lf/uscalfe/uscalfe.h>
 
 #include <Eigen/Core>
+#include <Eigen/IterativeLinearSolvers>
+#include <Eigen/SparseCore>
+#include <Eigen/SparseLU>
+
+#include "../../../lecturecodes/helperfiles/convergencestudy.h"
 
 namespace REE {
 
@@ -115,9 +126,31 @@ struct dataDiscreteBVP {
 };
 /* SAM_LISTING_END_1 */
 
+/** @brief Assembles Galerkin matrix and right-hand side vector for the
+ * homogeneous Dirichlet boundary value problem
+ *
+ * The boundary dofs are eliminated symmetrically, so that the matrix is
+ * symmetric positive definite.
+ */
+std::pair<Eigen::SparseMatrix<double>, Eigen::VectorXd> assembleBVP(
+    const dataDiscreteBVP &disc_bvp);
+
 /** @briefs Solves homogeneous Dirichlet boundary value problem
+ *
+ * @param timer if not nullptr, assembly and solve are charged to its phases
+ */
+Eigen::VectorXd solveBVP(const dataDiscreteBVP &disc_bvp,
+                         ConvergenceStudy::PhaseTimer *timer = nullptr);
+
+/** @brief Solves the boundary value problem iteratively by preconditioned CG,
+ * starting from the initial guess
+ *
+ * @param tol relative tolerance for the residual
+ * @param iterations if not nullptr, receives the number of CG iterations
  */
-Eigen::VectorXd solveBVP(const dataDiscreteBVP &disc_bvp);
+Eigen::VectorXd solveBVP(const dataDiscreteBVP &disc_bvp,
+                         const Eigen::VectorXd &guess, double tol = 1.0E-10,
+                         unsigned int *iterations = nullptr);
 
 /** @brief Computes cell contributions to error estimator */
 lf::mesh::utils::CodimMeshDataSet<double> volumeResiduals(
@@ -127,11 +160,73 @@ lf::mesh::utils::CodimMeshDataSet<double> volumeResiduals(
 lf::mesh::utils::CodimMeshDataSet<double> edgeResiduals(
     const dataDiscreteBVP &disc_bvp, const Eigen::VectorXd &u_vec);
 
+/** @brief Geometric data of a TRIANGULAR mesh required by the residual error
+ * estimator
+ *
+ * Computed once per mesh, so that repeated estimates on the same mesh, e.g.
+ * for several right-hand sides or inside an adaptive loop before the mesh is
+ * refined, only evaluate the problem data and the finite-element solution.
+ * All arrays are indexed by the mesh indices of cells and edges.
+ */
+/* SAM_LISTING_BEGIN_5 */
+struct EstimatorGeometry {
+  explicit EstimatorGeometry(std::shared_ptr<const lf::mesh::Mesh> mesh_p);
+
+  std::shared_ptr<const lf::mesh::Mesh> mesh_p_;
+  // Cells: diameter h_K (longest edge), area, gradients of the barycentric
+  // coordinate functions as columns, indices of the edges and orientation
+  // (+1/-1) of the unit edge normals with respect to the cell
+  std::vector<double> cell_diam_;
+  std::vector<double> cell_area_;
+  std::vector<Eigen::Matrix<double, 2, 3>> cell_grad_bary_;
+  std::vector<std::array<lf::base::size_type, 3>> cell_edges_;
+  std::vector<std::array<double, 3>> cell_edge_ori_;
+  // Edges: unit normal (direction vector turned by 90 degrees), length and
+  // boundary flag
+  std::vector<Eigen::Vector2d> edge_normal_;
+  std::vector<double> edge_length_;
+  std::vector<bool> edge_on_bd_;
+};
+/* SAM_LISTING_END_5 */
+
+/** @brief Volume and edge contributions to the error estimator and their sums
+ */
+struct ResidualEstimate {
+  lf::mesh::utils::CodimMeshDataSet<double> vol_res;
+  lf::mesh::utils::CodimMeshDataSet<double> edge_res;
+  double eta_vol;
+  double eta_ed;
+};
+
+/** @brief Computes the same volume and edge residuals as volumeResiduals() and
+ * edgeResiduals() in a single sweep over the cells
+ *
+ * The cells are split into contiguous chunks, one per thread. Every thread
+ * accumulates the flux jumps and the maximal diffusion coefficients of the
+ * edges in arrays of its own, which are reduced afterwards.
+ *
+ * @param geo geometric data of the mesh of the finite-element space
+ * @param threads number of threads
+ */
+ResidualEstimate estimateResiduals(const dataDiscreteBVP &disc_bvp,
+                                   const EstimatorGeometry &geo,
+                                   const Eigen::VectorXd &u_vec,
+                                   unsigned int threads = 1);
+
+/** @brief Compares runtimes of volumeResiduals() + edgeResiduals() and
+ * estimateResiduals() on the given mesh */
+void benchmarkEstimators(std::shared_ptr<const lf::mesh::Mesh> mesh_p);
+
 /** @brief solves boundary value problem and estimates error
 
     @note the provided mesh must cover the unit square
+    @param timer if not nullptr, the computation is charged to the assembly,
+    solve and error evaluation phases
  */
 std::tuple<double, double, double> solveAndEstimate(
-    std::shared_ptr<const lf::mesh::Mesh> mesh_p);
+    std::shared_ptr<const lf::mesh::Mesh> mesh_p,
+    ConvergenceStudy::PhaseTimer *timer = nullptr);
 
 }  // namespace REE
+
+#endif  // RESIDUALERRORESTIMATOR_H
@@ -8,6 +8,8 @@
 
 #include "../residualerrorestimator.h"
 
+#include "../adaptiveloop.h"
+
 #include <gtest/gtest.h>
 
 #include <Eigen/Core>
@@ -112,4 +114,82 @@ TEST(REE, ZeroEdgeResioduals) {
   }
 }
 
+TEST(REE, SingleSweepEstimator) {
+  // Obtain a triangular test mesh
+  std::shared_ptr<lf::mesh::Mesh> mesh_p =
+      lf::mesh::test_utils::GenerateHybrid2DTestMesh(3);
+  // Piecewise constant coefficient with jumps and a smooth source function
+  std::function<double(Eigen::Vector2d)> alpha =
+      [](Eigen::Vector2d x) -> double { return (x[0] > x[1]) ? 3.0 : 0.5; };
+  auto f = [](Eigen::Vector2d x) -> double { return x[0] * x[0] - x[1]; };
+  const dataDiscreteBVP disc_bvp(mesh_p, alpha, f);
+  // Arbitrary finite element function
+  const Eigen::VectorXd mu = Eigen::VectorXd::LinSpaced(
+      disc_bvp.pwlinfespace_p_->LocGlobMap().NumDofs(), -1.0, 2.0);
+
+  const lf::mesh::utils::CodimMeshDataSet<double> vol_res{
+      volumeResiduals(disc_bvp, mu)};
+  const lf::mesh::utils::CodimMeshDataSet<double> ed_res{
+      edgeResiduals(disc_bvp, mu)};
+  // The geometric data are reused for all numbers of threads
+  const EstimatorGeometry geo(mesh_p);
+  for (unsigned int threads : {1, 2, 3}) {
+    const ResidualEstimate est{estimateResiduals(disc_bvp, geo, mu, threads)};
+    double eta_vol = 0.0;
+    for (const lf::mesh::Entity* cell : mesh_p->Entities(0)) {
+      EXPECT_NEAR(est.vol_res(*cell), vol_res(*cell), 1.0E-10);
+      eta_vol += vol_res(*cell);
+    }
+    double eta_ed = 0.0;
+    for (const lf::mesh::Entity* edge : mesh_p->Entities(1)) {
+      EXPECT_NEAR(est.edge_res(*edge), ed_res(*edge), 1.0E-10);
+      eta_ed += ed_res(*edge);
+    }
+    EXPECT_NEAR(est.eta_vol, eta_vol, 1.0E-10);
+    EXPECT_NEAR(est.eta_ed, eta_ed, 1.0E-10);
+  }
+}
+
+TEST(REE, DoerflerMarking) {
+  const std::vector<double> eta{1.0, 4.0, 2.0, 3.0};
+  // 4 + 3 >= 0.5 * 10
+  EXPECT_EQ(doerflerMarking(eta, 0.5),
+            std::vector<bool>({false, true, false, true}));
+  EXPECT_EQ(doerflerMarking(eta, 0.3),
+            std::vector<bool>({false, true, false, false}));
+  EXPECT_EQ(doerflerMarking(eta, 1.0), std::vector<bool>(4, true));
+}
+
+TEST(REE, ProlongationLinear) {
+  // Uniform refinement followed by local refinement at the re-entrant corner
+  lf::refinement::MeshHierarchy hierarchy(
+      generateLShapedMesh(),
+      std::make_unique<lf::mesh::hybrid2d::MeshFactory>(2));
+  hierarchy.RefineRegular();
+  hierarchy.MarkEdges(
+      [](const lf::mesh::Mesh& /*mesh*/, const lf::mesh::Entity& edge) {
+        const Eigen::MatrixXd corners{lf::geometry::Corners(*edge.Geometry())};
+        return corners.colwise().norm().minCoeff() < 1.0E-10;
+      });
+  hierarchy.RefineMarked();
+  ASSERT_EQ(hierarchy.NumLevels(), 3);
+  // Linear functions are prolongated exactly
+  const lf::mesh::utils::MeshFunctionGlobal mf_lin(
+      [](Eigen::Vector2d x) -> double { return 2.0 * x[0] + x[1] + 1.0; });
+  for (lf::base::size_type level = 0; level < 2; ++level) {
+    const lf::uscalfe::FeSpaceLagrangeO1<double> coarse_space(
+        hierarchy.getMesh(level));
+    const lf::uscalfe::FeSpaceLagrangeO1<double> fine_space(
+        hierarchy.getMesh(level + 1));
+    const Eigen::VectorXd mu_coarse =
+        lf::fe::NodalProjection(coarse_space, mf_lin);
+    const Eigen::VectorXd mu_fine = prolongateP1(
+        hierarchy, level, coarse_space.LocGlobMap(), fine_space.LocGlobMap(),
+        mu_coarse);
+    EXPECT_NEAR((mu_fine - lf::fe::NodalProjection(fine_space, mf_lin))
+                    .lpNorm<Eigen::Infinity>(),
+                0.0, 1.0E-12);
+  }
+}
+
 }  // namespace REE::test
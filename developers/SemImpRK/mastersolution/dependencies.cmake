@@ -10,6 +10,8 @@ set(SOURCES
   ${DIR}/semimprk_main.cc
   ${DIR}/semimprk.h
   ${DIR}/semimprk.cc
+  ${DIR}/rosenbrockw.h
+  ${DIR}/rosenbrockwbenchmark.cc
 )
 
 set(LIBRARIES
@@ -24,4 +24,5 @@ set(LIBRARIES
   LF::lf.mesh.utils
   LF::lf.quad
   LF::lf.uscalfe
+  Threads::Threads
 )
@@ -81,6 +81,12 @@ int main(int /*argc*/, const char ** /*argv*/) {
         StableEvaluationAtAPoint::ComparePointEval(fe_space, uExact, x);
     errors_direct(k) = std::abs(uExact(x) - direct_eval);
     errors_stable(k) = std::abs(uExact(x) - stable_eval);
+
+    // Many evaluation points on the finest mesh
+    if (k == N_meshes - 1) {
+      StableEvaluationAtAPoint::BenchmarkBatchEvaluation(
+          fe_space, StableEvaluationAtAPoint::SolveBVP(fe_space, uExact));
+    }
   }
 
   // Compute rates of convergence:
@@ -24,5 +24,6 @@ set(LIBRARIES
   LF::lf.mesh.utils
   LF::lf.quad
   LF::lf.uscalfe
+  Threads::Threads
 )
 
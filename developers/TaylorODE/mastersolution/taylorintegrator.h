@@ -0,0 +1,167 @@
+#ifndef TAYLORINTEGRATOR_H
+#define TAYLORINTEGRATOR_H
+/**
+ * @file taylorintegrator.h
+ * @brief NPDE homework TaylorODE
+ * @author agent
+ * @date 18.10.2026
+ * @copyright Developed at ETH Zurich
+ */
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "taylorseries.h"
+
+namespace TaylorODE {
+
+/**
+ * @brief Taylor series method of order p <= N for autonomous ODEs y' = f(y)
+ * in R^D.
+ *
+ * The Taylor coefficients y_k = y^{(k)}(t)/k! of the solution through y are
+ * obtained from y_{k+1} = [f(y_0 + ... + y_k t^k)]_k / (k+1), evaluating f
+ * with TaylorSeries arithmetic. Hence f has to be a generic callable
+ * accepting std::array<Scalar, D> for Scalar = TaylorSeries<N> and
+ * returning an array of the same type.
+ *
+ * The adaptive variant chooses the step size from the decay of the last two
+ * coefficients, h = min_{k = p-1, p} (tol / |y_k|)^{1/k} exp(-0.7/(p-1)),
+ * such that the truncated terms are below tol (relative to max(1, |y|)), see
+ * Jorba, Zou, Experiment. Math. 14 (2005).
+ */
+template <int N = 20>
+class TaylorIntegrator {
+ public:
+  using Series = TaylorSeries<N>;
+  template <int D>
+  using State = Eigen::Matrix<double, D, 1>;
+
+  /**
+   * @param p order of the method, 1 <= p <= N
+   * @param tol tolerance for the adaptive variant
+   */
+  explicit TaylorIntegrator(unsigned int p = N, double tol = 1.0E-12)
+      : p_(p), tol_(tol) {
+    assert(1 <= p && p <= N && "Order out of range.");
+  }
+
+  /** @brief Taylor coefficients y_0, ..., y_p of the solution through y */
+  template <class Function, int D>
+  std::array<Series, D> coefficients(const Function& f,
+                                     const State<D>& y) const;
+
+  /**
+   * @brief Adaptive solution on [0, T], calling observer(t, y) for t = 0 and
+   * after every step
+   * @return y(T)
+   */
+  template <class Function, int D, class Observer>
+  State<D> solve(const Function& f, double T, const State<D>& y0,
+                 Observer&& observer);
+  template <class Function, int D>
+  State<D> solve(const Function& f, double T, const State<D>& y0) {
+    return solve(f, T, y0, [](double, const State<D>&) {});
+  }
+
+  /** @brief M equidistant steps, returns all states y^m */
+  template <class Function, int D>
+  std::vector<State<D>> solveEqui(const Function& f, double T,
+                                  const State<D>& y0, unsigned int M);
+
+  /** @brief Number of steps of the last call of solve() or solveEqui() */
+  unsigned int steps() const { return steps_; }
+
+ private:
+  // Evaluates the Taylor polynomial at h by the Horner scheme
+  template <std::size_t D>
+  static State<D> evaluate(const std::array<Series, D>& Y, double h) {
+    State<D> y;
+    for (std::size_t i = 0; i < D; ++i) {
+      double s = 0.0;
+      for (int k = Y[i].degree(); k >= 0; --k) s = s * h + Y[i][k];
+      y(i) = s;
+    }
+    return y;
+  }
+
+  unsigned int p_;
+  double tol_;
+  unsigned int steps_ = 0;
+};
+
+/* SAM_LISTING_BEGIN_1 */
+template <int N>
+template <class Function, int D>
+std::array<TaylorSeries<N>, D> TaylorIntegrator<N>::coefficients(
+    const Function& f, const State<D>& y) const {
+  std::array<Series, D> Y;
+  for (int i = 0; i < D; ++i) Y[i] = Series(y(i));
+  for (unsigned int k = 0; k < p_; ++k) {
+    // Y has degree k, hence f(Y) is exact up to t^k
+    const std::array<Series, D> F = f(Y);
+    for (int i = 0; i < D; ++i) {
+      Y[i].setDegree(k + 1);
+      Y[i][k + 1] = F[i][k] / (k + 1);
+    }
+  }
+  return Y;
+}
+/* SAM_LISTING_END_1 */
+
+/* SAM_LISTING_BEGIN_2 */
+template <int N>
+template <class Function, int D, class Observer>
+typename TaylorIntegrator<N>::template State<D> TaylorIntegrator<N>::solve(
+    const Function& f, double T, const State<D>& y0, Observer&& observer) {
+  State<D> y = y0;
+  double t = 0.0;
+  steps_ = 0;
+  observer(t, y);
+  while (t < T) {
+    const std::array<Series, D> Y = coefficients(f, y);
+    // Step size from the decay of the coefficients
+    const double tol =
+        tol_ * std::max(1.0, y.template lpNorm<Eigen::Infinity>());
+    double h = std::numeric_limits<double>::infinity();
+    for (unsigned int k = std::max(1u, p_ - 1); k <= p_; ++k) {
+      double yk = 0.0;
+      for (int i = 0; i < D; ++i) yk = std::max(yk, std::abs(Y[i][k]));
+      if (yk > 0.0) h = std::min(h, std::pow(tol / yk, 1.0 / k));
+    }
+    // Safety factor of Jorba and Zou
+    h = std::min(h * std::exp(-0.7 / std::max(1u, p_ - 1)), T - t);
+    y = evaluate(Y, h);
+    t += h;
+    ++steps_;
+    observer(t, y);
+  }
+  return y;
+}
+/* SAM_LISTING_END_2 */
+
+template <int N>
+template <class Function, int D>
+std::vector<typename TaylorIntegrator<N>::template State<D>>
+TaylorIntegrator<N>::solveEqui(const Function& f, double T, const State<D>& y0,
+                               unsigned int M) {
+  const double h = T / M;
+  std::vector<State<D>> res;
+  res.reserve(M + 1);
+  res.push_back(y0);
+  for (unsigned int m = 0; m < M; ++m) {
+    res.push_back(evaluate(coefficients(f, res.back()), h));
+  }
+  steps_ = M;
+  return res;
+}
+
+}  // namespace TaylorODE
+
+#endif  // TAYLORINTEGRATOR_H
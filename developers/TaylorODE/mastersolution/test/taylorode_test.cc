@@ -11,8 +11,13 @@
 #include <gtest/gtest.h>
 
 #include <Eigen/Core>
+#include <array>
+#include <cmath>
 #include <vector>
 
+#include "../taylorintegrator.h"
+#include "../taylorseries.h"
+
 namespace TaylorODE::test {
 
 TEST(PredPreyModel, f) {
@@ -64,4 +69,70 @@ TEST(SolvePredPReyTaylor, OneStep) {
   EXPECT_NEAR((y1 - res[1]).norm(), 0.0, 1E-8);
 }
 
-}  // namespace TaylorODE::test
\ No newline at end of file
+TEST(TaylorSeries, Arithmetic) {
+  // t as a series of degree 8
+  TaylorSeries<8> t(0.0);
+  t.setDegree(8);
+  t[1] = 1.0;
+  const TaylorSeries<8> one_minus_t = 1.0 - t;
+  const TaylorSeries<8> geometric = 1.0 / one_minus_t;
+  const TaylorSeries<8> e = exp(t);
+  const TaylorSeries<8> s = sin(2.0 * t);
+  const TaylorSeries<8> r = sqrt((1.0 + t) * (1.0 + t));
+  double factorial = 1.0;
+  for (int k = 0; k <= 8; ++k) {
+    if (k > 0) factorial *= k;
+    EXPECT_NEAR(geometric[k], 1.0, 1E-14);
+    EXPECT_NEAR(e[k], 1.0 / factorial, 1E-14);
+    // sin(2t) = sum_j (-1)^j (2t)^(2j+1) / (2j+1)!
+    const double s_ex =
+        (k % 2 == 0) ? 0.0 : std::pow(-1, k / 2) * std::pow(2, k) / factorial;
+    EXPECT_NEAR(s[k], s_ex, 1E-14);
+    EXPECT_NEAR(r[k], k < 2 ? 1.0 : 0.0, 1E-14);
+  }
+}
+
+TEST(TaylorSeries, SetDegree) {
+  TaylorSeries<8> a(1.0);
+  a.setDegree(4);
+  for (int k = 1; k <= 4; ++k) a[k] = k + 1.0;
+  const TaylorSeries<8>& ca = a;
+  // Lowering the degree truncates the series
+  a.setDegree(2);
+  EXPECT_EQ(a.degree(), 2);
+  EXPECT_EQ(ca[2], 3.0);
+  EXPECT_EQ(ca[3], 0.0);
+  // Raising it again appends zeros instead of the old coefficients
+  a.setDegree(6);
+  EXPECT_EQ(a.degree(), 6);
+  EXPECT_EQ(ca[1], 2.0);
+  EXPECT_EQ(ca[2], 3.0);
+  for (int k = 3; k <= 6; ++k) EXPECT_EQ(ca[k], 0.0);
+}
+
+TEST(TaylorIntegrator, ThirdOrder) {
+  // The Taylor method of order 3 is SolvePredPreyTaylor()
+  PredPreyModel model(1.0, 2.0, 4.0, 8.0);
+  auto f = [&model](const auto& y) { return model.f(y); };
+  Eigen::Vector2d y0(1.0, 1.0);
+  TaylorIntegrator<3> taylor(3);
+  auto res = taylor.solveEqui(f, 0.5, y0, 10);
+  auto ref = SolvePredPreyTaylor(model, 0.5, y0, 10);
+  ASSERT_EQ(res.size(), ref.size());
+  for (std::size_t m = 0; m < res.size(); ++m) {
+    EXPECT_NEAR((res[m] - ref[m]).norm(), 0.0, 1E-12);
+  }
+}
+
+TEST(TaylorIntegrator, Adaptive) {
+  PredPreyModel model(3.0, 2.0, 0.1, 0.1);
+  auto f = [&model](const auto& y) { return model.f(y); };
+  Eigen::Vector2d y0(100, 5);
+  Eigen::Vector2d yex(0.319465882659820, 9.730809352326228);
+  TaylorIntegrator<> taylor(15, 1E-14);
+  Eigen::Vector2d yT = taylor.solve(f, 10.0, y0);
+  EXPECT_NEAR((yT - yex).norm(), 0.0, 1E-10);
+  EXPECT_LT(taylor.steps(), 500);
+}
+
+}  // namespace TaylorODE::test
@@ -23,4 +23,5 @@ set(LIBRARIES
   LF::lf.mesh.utils
   LF::lf.refinement
   LF::lf.uscalfe
+  Threads::Threads
 )
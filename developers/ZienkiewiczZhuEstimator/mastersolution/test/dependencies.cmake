@@ -17,4 +17,5 @@ set(LIBRARIES
   LF::lf.geometry
   LF::lf.uscalfe
   LF::lf.assemble
+  Threads::Threads
 )
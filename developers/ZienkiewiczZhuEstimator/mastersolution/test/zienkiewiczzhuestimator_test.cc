@@ -169,4 +169,37 @@ TEST(ZienkiewiczZhuEstimator, computeL2Deviation) {
   ASSERT_NEAR(error_grad, 0.0419009, 1.0e-6);
 }
 
+/**
+ * @brief test GradientRecovery against computeLumpedProjection and
+ * computeL2Deviation
+ */
+TEST(ZienkiewiczZhuEstimator, GradientRecovery) {
+  auto mesh_p = lf::mesh::test_utils::GenerateHybrid2DTestMesh(4);
+  auto fe_space_p =
+      std::make_shared<lf::uscalfe::FeSpaceLagrangeO1<double>>(mesh_p);
+  // Obtain reference to scalar dofh
+  const lf::assemble::DofHandler &dofh{fe_space_p->LocGlobMap()};
+  // Produce a dof handler for the vector-valued finite element space
+  lf::assemble::UniformFEDofHandler vec_dofh(mesh_p,
+                                             {{lf::base::RefEl::kPoint(), 2},
+                                              {lf::base::RefEl::kSegment(), 0},
+                                              {lf::base::RefEl::kTria(), 0},
+                                              {lf::base::RefEl::kQuad(), 0}});
+
+  auto mu = ZienkiewiczZhuEstimator::solveBVP(fe_space_p);
+  auto mu_grad =
+      ZienkiewiczZhuEstimator::computeLumpedProjection(dofh, mu, vec_dofh);
+  double deviation = computeL2Deviation(dofh, mu, vec_dofh, mu_grad);
+
+  const ZienkiewiczZhuEstimator::GradientRecovery recovery(dofh, vec_dofh);
+  for (unsigned int threads : {1, 3}) {
+    Eigen::VectorXd gamma = recovery.lumpedProjection(mu, threads);
+    ASSERT_EQ(gamma.size(), mu_grad.size());
+    EXPECT_NEAR((gamma - mu_grad).lpNorm<Eigen::Infinity>(), 0.0, 1.0e-12);
+    Eigen::VectorXd eta = recovery.cellDeviations(mu, gamma, threads);
+    ASSERT_EQ(eta.size(), mesh_p->NumEntities(0));
+    EXPECT_NEAR(std::sqrt(eta.sum()), deviation, 1.0e-12);
+  }
+}
+
 }  // namespace ZienkiewiczZhuEstimator::test
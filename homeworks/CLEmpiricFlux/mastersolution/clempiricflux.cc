@@ -71,4 +71,53 @@ double GodunovFlux::operator()(double v, double w) const {
 
 /* SAM_LISTING_END_9 */
 
+TabulatedGodunovFlux::TabulatedGodunovFlux(const UniformCubicSpline &f)
+    : _n(f.numIntervals()), _a(f.leftBound()) {
+  const double b = f.rightBound();
+  const double h = (b - _a) / _n;
+  _inv_h = 1.0 / h;
+
+  // Locate the minimum of the strictly convex function f once. If f is
+  // monotonic on [a, b], the minimum is attained at the boundary.
+  if (f.derivative(_a) >= 0.0) {
+    _ustar = _a;
+  } else if (f.derivative(b) <= 0.0) {
+    _ustar = b;
+  } else {
+    // Bisection for the zero of the increasing function f'. Unlike
+    // findRoots() it also copes with f' vanishing exactly at a midpoint.
+    double v = _a, w = b;
+    while (w - v > 1.0E-14 * (b - _a)) {
+      const double x = 0.5 * (v + w);
+      if (f.derivative(x) < 0.0) {
+        v = x;
+      } else {
+        w = x;
+      }
+    }
+    _ustar = 0.5 * (v + w);
+  }
+
+  // Monomial coefficients of the pieces s(tau), 0 <= tau <= 1, where
+  // u = a + (j + tau) * h on interval j
+  const Eigen::ArrayXd fv = f.nodeValues().array();
+  const Eigen::ArrayXd M = f.secondDerivatives().array();
+  const double h2 = h * h;
+  _c0 = fv.head(_n);
+  _c1 = fv.tail(_n) - fv.head(_n) -
+        h2 / 6.0 * (M.tail(_n) + 2.0 * M.head(_n));
+  _c2 = 0.5 * h2 * M.head(_n);
+  _c3 = h2 / 6.0 * (M.tail(_n) - M.head(_n));
+}
+
+void TabulatedGodunovFlux::operator()(const Eigen::Ref<const Eigen::ArrayXd> &v,
+                                      const Eigen::Ref<const Eigen::ArrayXd> &w,
+                                      Eigen::Ref<Eigen::ArrayXd> F) const {
+  assert(v.size() == w.size() && v.size() == F.size());
+  const Eigen::Index m = v.size();
+  for (Eigen::Index i = 0; i < m; ++i) {
+    F[i] = (*this)(v[i], w[i]);
+  }
+}
+
 }  // namespace CLEmpiricFlux
@@ -10,6 +10,7 @@
  */
 
 #include <Eigen/Core>
+#include <algorithm>
 
 #include "uniformcubicspline.h"
 
@@ -26,6 +27,43 @@ class GodunovFlux {
   UniformCubicSpline _f;
 };
 
+// Godunov numerical flux for a strictly convex spline flux function with all
+// data precomputed in the constructor: the sonic point u* (minimum of f) is
+// located once and the spline is converted into the monomial coefficients of
+// its cubic pieces, stored in contiguous arrays. Then
+//   F(v, w) = max(f(max(v, u*)), f(min(w, u*))),
+// which only needs two polynomial evaluations without any branching on the
+// shape of f.
+class TabulatedGodunovFlux {
+ public:
+  TabulatedGodunovFlux(const UniformCubicSpline &f);
+  // evaluate the Godunov numerical flux F(v, w)
+  double operator()(double v, double w) const {
+    return std::max(f(std::max(v, _ustar)), f(std::min(w, _ustar)));
+  }
+  // evaluate F(v(i), w(i)) for all i and store it in F(i)
+  void operator()(const Eigen::Ref<const Eigen::ArrayXd> &v,
+                  const Eigen::Ref<const Eigen::ArrayXd> &w,
+                  Eigen::Ref<Eigen::ArrayXd> F) const;
+  // evaluate the flux function f, extrapolated by the first/last piece
+  // outside the interval of definition
+  double f(double u) const {
+    const double s = (u - _a) * _inv_h;
+    // clamp before the conversion, which overflows for very large |u|
+    const int i = static_cast<int>(std::min(std::max(s, 0.0), _n - 1.0));
+    const double tau = s - i;
+    return ((_c3[i] * tau + _c2[i]) * tau + _c1[i]) * tau + _c0[i];
+  }
+  // the sonic point u* at which f attains its minimum
+  double sonicPoint() const { return _ustar; }
+
+ private:
+  int _n;                             // number of intervals
+  double _a, _inv_h;                  // left bound, inverse meshwidth
+  double _ustar;                      // sonic point
+  Eigen::ArrayXd _c0, _c1, _c2, _c3;  // coefficients of the cubic pieces
+};
+
 }  // namespace CLEmpiricFlux
 
 #endif
@@ -6,6 +6,7 @@
  * @copyright Developed at ETH Zurich
  */
 
+#include <chrono>
 #include <iostream>
 
 #include "clempiricflux.h"
@@ -41,5 +42,24 @@ int main() {
   std::cout << "Your solution at time T = " << T << ":" << std::endl;
   std::cout << muT.transpose().format(CSVFormat) << std::endl;
 
+  // Long run on a fine mesh: compare runtimes of the finite volume scheme
+  // with GodunovFlux and with TabulatedGodunovFlux
+  h = 1.0E-3;
+  T = 2.0;
+  mu0 = computeInitVec(f, u0, h, T);
+  auto t0 = std::chrono::high_resolution_clock::now();
+  Eigen::VectorXd muT_ref = solveCauchyProblem(f, mu0, h, T);
+  auto t1 = std::chrono::high_resolution_clock::now();
+  Eigen::VectorXd muT_tab = solveCauchyProblemTabulated(f, mu0, h, T);
+  auto t2 = std::chrono::high_resolution_clock::now();
+  const double time_ref = std::chrono::duration<double>(t1 - t0).count();
+  const double time_tab = std::chrono::duration<double>(t2 - t1).count();
+  std::cout << "N = " << mu0.size() << ", h = " << h << ", T = " << T
+            << std::endl;
+  std::cout << "solveCauchyProblem:          " << time_ref << " s" << std::endl;
+  std::cout << "solveCauchyProblemTabulated: " << time_tab << " s"
+            << ", speedup " << time_ref / time_tab << ", difference "
+            << (muT_ref - muT_tab).lpNorm<Eigen::Infinity>() << std::endl;
+
   return 0;
 }
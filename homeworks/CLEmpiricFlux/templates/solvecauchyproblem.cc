@@ -9,6 +9,7 @@
 #include "solvecauchyproblem.h"
 
 #include <Eigen/Core>
+#include <algorithm>
 #include <cmath>
 
 #include "uniformcubicspline.h"
@@ -50,6 +51,32 @@ Eigen::VectorXd RalstonODESolver(FUNCTOR &&rhs, Eigen::VectorXd mu0, double tau,
 }
 /* SAM_LISTING_END_3 */
 
+void semiDiscreteRhs(const Eigen::VectorXd &mu, double h,
+                     const TabulatedGodunovFlux &numFlux, Eigen::ArrayXd &F,
+                     Eigen::VectorXd &rhs) {
+  const Eigen::Index m = mu.size();
+  F.resize(m + 1);
+  rhs.resize(m);
+  // Interface fluxes F(mu(j-1), mu(j)), constant continuation at both ends
+  F(0) = numFlux(mu(0), mu(0));
+  numFlux(mu.head(m - 1).array(), mu.tail(m - 1).array(), F.segment(1, m - 1));
+  F(m) = numFlux(mu(m - 1), mu(m - 1));
+  rhs = -1.0 / h * (F.tail(m) - F.head(m)).matrix();
+}
+
+template <typename FUNCTOR>
+Eigen::VectorXd RalstonODESolverInPlace(FUNCTOR &&rhs, Eigen::VectorXd mu0,
+                                        double tau, int n) {
+  Eigen::VectorXd k1(mu0.size()), k2(mu0.size()), y(mu0.size());
+  for (int i = 0; i < n; ++i) {
+    rhs(mu0, k1);
+    y = mu0 + tau * 2.0 / 3.0 * k1;
+    rhs(y, k2);
+    mu0 += 0.25 * tau * (k1 + 3.0 * k2);
+  }
+  return mu0;
+}
+
 /* SAM_LISTING_BEGIN_4 */
 Eigen::VectorXd solveCauchyProblem(const UniformCubicSpline &f,
                                    const Eigen::VectorXd &mu0, double h,
@@ -62,4 +89,20 @@ Eigen::VectorXd solveCauchyProblem(const UniformCubicSpline &f,
 }
 /* SAM_LISTING_END_4 */
 
+Eigen::VectorXd solveCauchyProblemTabulated(const UniformCubicSpline &f,
+                                            const Eigen::VectorXd &mu0,
+                                            double h, double T) {
+  // Same timestep as in solveCauchyProblem()
+  const double tau = std::min(h / std::abs(f.derivative(-1.0)),
+                              h / std::abs(f.derivative(1.0)));
+  const int n = (int)std::floor(T / tau);
+  const TabulatedGodunovFlux godunovFlux(f);
+  Eigen::ArrayXd F(mu0.size() + 1);  // workspace for interface fluxes
+  auto rhs = [h, &godunovFlux, &F](const Eigen::VectorXd &mu,
+                                   Eigen::VectorXd &dmu) {
+    semiDiscreteRhs(mu, h, godunovFlux, F, dmu);
+  };
+  return RalstonODESolverInPlace(rhs, mu0, tau, n);
+}
+
 }  // namespace CLEmpiricFlux
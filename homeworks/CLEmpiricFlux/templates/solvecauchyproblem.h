@@ -79,6 +79,35 @@ template <typename FUNCTOR>
 Eigen::VectorXd RalstonODESolver(FUNCTOR &&rhs, Eigen::VectorXd mu0, double tau,
                                  int n);
 
+/**
+ * @brief Same as semiDiscreteRhs(), but all interfaces are processed by a
+ * single call of the tabulated Godunov flux and no memory is allocated.
+ *
+ * @param mu vector of size N containing cell averages
+ * @param h spacial mesh-width
+ * @param numFlux tabulated Godunov flux
+ * @param F workspace for the N+1 interface fluxes, resized if necessary
+ * @param rhs vector of size N, returns the image of mu under the RHS of the
+ * semi-discretized equation
+ */
+void semiDiscreteRhs(const Eigen::VectorXd &mu, double h,
+                     const TabulatedGodunovFlux &numFlux, Eigen::ArrayXd &F,
+                     Eigen::VectorXd &rhs);
+
+/**
+ * @brief Same as RalstonODESolver(), but with preallocated stages
+ *
+ * @param rhs right-hand side of the homogenous ODE, models
+ *  std::function<void(const Eigen::VectorXd &y, Eigen::VectorXd &dydt)>
+ * @param mu0 initial data, vector of size N
+ * @param tau timestep size, tau > 0.0
+ * @param n number of timesteps to perform, n > 0
+ * @return vector of size N containg the approximate solution at time n * tau
+ */
+template <typename FUNCTOR>
+Eigen::VectorXd RalstonODESolverInPlace(FUNCTOR &&rhs, Eigen::VectorXd mu0,
+                                        double tau, int n);
+
 /**
  * @brief Implements a finite volume scheme to solve a conservation law with
  * strictly convex flux function
@@ -93,6 +122,14 @@ Eigen::VectorXd solveCauchyProblem(const UniformCubicSpline &f,
                                    const Eigen::VectorXd &mu0, double h,
                                    double T);
 
+/**
+ * @brief Same as solveCauchyProblem(), but based on TabulatedGodunovFlux,
+ * the vectorized semiDiscreteRhs() and RalstonODESolverInPlace()
+ */
+Eigen::VectorXd solveCauchyProblemTabulated(const UniformCubicSpline &f,
+                                            const Eigen::VectorXd &mu0,
+                                            double h, double T);
+
 }  // namespace CLEmpiricFlux
 
 #endif
@@ -148,6 +148,54 @@ TEST(CLEmpiricFlux, GodunovFlux_class) {
   EXPECT_NEAR(error, 0.0, tol);
 }
 
+TEST(CLEmpiricFlux, TabulatedGodunovFlux_class) {
+  // strictly convex flux with minimum inside the interval [a, b]
+  double a = -1.0;
+  double b = 2.0;
+  unsigned int n = 37;
+  Eigen::VectorXd x = Eigen::VectorXd::LinSpaced(n + 1, a, b);
+  auto f_lambda = [](double x) { return std::exp(x) - 2.0 * x; };
+  UniformCubicSpline spline(a, b, x.unaryExpr(f_lambda),
+                            x.unaryExpr([](double x) { return std::exp(x); }));
+  TabulatedGodunovFlux tabulatedFlux(spline);
+
+  // the sonic point is the minimum of the spline, close to log(2)
+  EXPECT_NEAR(spline.derivative(tabulatedFlux.sonicPoint()), 0.0, 1.0e-10);
+  EXPECT_NEAR(tabulatedFlux.sonicPoint(), std::log(2.0), 1.0e-3);
+
+  // compare with the spline and with GodunovFlux on all combinations of
+  // states, both pointwise and for whole vectors
+  Eigen::ArrayXd u = Eigen::ArrayXd::LinSpaced(41, a, b);
+  Eigen::ArrayXd v(u.size() * u.size()), w(u.size() * u.size());
+  for (int i = 0; i < u.size(); ++i) {
+    EXPECT_NEAR(tabulatedFlux.f(u(i)), spline(u(i)), 1.0e-12);
+    v.segment(i * u.size(), u.size()).setConstant(u(i));
+    w.segment(i * u.size(), u.size()) = u;
+  }
+  Eigen::ArrayXd F(v.size());
+  tabulatedFlux(v, w, F);
+  for (int i = 0; i < v.size(); ++i) {
+    EXPECT_NEAR(F(i), tabulatedFlux(v(i), w(i)), 1.0e-15);
+  }
+
+  // far outside of [a, b] the last piece is extrapolated: compare with the
+  // cubic interpolating it in four points of the last interval
+  double h = (b - a) / n;
+  for (double u_far : {1.0e4, 1.0e12}) {
+    double p = 0.0;
+    for (int k = 0; k < 4; ++k) {
+      double u_k = b - h * k / 3.0;
+      double l_k = 1.0;
+      for (int m = 0; m < 4; ++m) {
+        double u_m = b - h * m / 3.0;
+        if (m != k) l_k *= (u_far - u_m) / (u_k - u_m);
+      }
+      p += l_k * tabulatedFlux.f(u_k);
+    }
+    EXPECT_NEAR(tabulatedFlux.f(u_far) / p, 1.0, 1.0e-6);
+  }
+}
+
 TEST(CLEmpiricFlux, solveCauchyProblem_semiDiscreteRhs) {
   // my solution
   Eigen::VectorXd mu0(10);
@@ -272,6 +320,11 @@ TEST(CLEmpiricFlux, solveCauchyProblem_solveCauchyProblem) {
   double error = (muT_ref - muT).lpNorm<Eigen::Infinity>();
   double tol = 1.0e-4;
   EXPECT_NEAR(error, 0.0, tol);
+
+  // version with tabulated flux
+  Eigen::VectorXd muT_tab = solveCauchyProblemTabulated(f, mu0, h, T);
+  error = (muT_ref - muT_tab).lpNorm<Eigen::Infinity>();
+  EXPECT_NEAR(error, 0.0, tol);
 }
 
 }  // namespace CLEmpiricFlux::test
@@ -18,6 +18,13 @@ class UniformCubicSpline {
   UniformCubicSpline(double a, double b, Eigen::VectorXd f, Eigen::VectorXd M);
   double operator()(double u) const;  // Point evaluation operator
   double derivative(double u) const;  // Evaluation of derivative
+  // Access to the data defining the spline
+  unsigned int numIntervals() const { return _n; }
+  double leftBound() const { return _a; }
+  double rightBound() const { return _b; }
+  const Eigen::VectorXd &nodeValues() const { return _f; }
+  const Eigen::VectorXd &secondDerivatives() const { return _M; }
+
  private:
   unsigned int _n;     // Number of nodes - 1
   double _a, _b;       // Interval boundaries
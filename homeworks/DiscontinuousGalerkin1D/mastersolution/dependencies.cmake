@@ -5,6 +5,7 @@
 set(SOURCES
   ${DIR}/discontinuousgalerkin1d_main.cc
   ${DIR}/discontinuousgalerkin1d.h
+  ${DIR}/dgblocksolver.h
   ${DIR}/discontinuousgalerkin1d.cc
 )
 
@@ -0,0 +1,203 @@
+#ifndef DGBLOCKSOLVER_H_
+#define DGBLOCKSOLVER_H_
+
+/**
+ * @file dgblocksolver.h
+ * @brief NPDE homework "DiscontinuousGalerkin1D" code
+ * @author agent
+ * @date 18.10.2026
+ * @copyright Developed at ETH Zurich
+ */
+
+#include <Eigen/Core>
+#include <Eigen/Eigenvalues>
+#include <Eigen/StdVector>
+#include <cmath>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace DiscontinuousGalerkin1D {
+
+/**
+ * @brief Block-diagonal matrix with square blocks of compile-time size B,
+ * acting on vectors of length B * (number of blocks).
+ */
+template <int B>
+class BlockDiagonalMatrix {
+ public:
+  using Block = Eigen::Matrix<double, B, B>;
+
+  explicit BlockDiagonalMatrix(int nblocks)
+      : blocks_(nblocks, Block::Zero()) {}
+
+  Eigen::Index numBlocks() const { return blocks_.size(); }
+  Eigen::Index size() const { return B * numBlocks(); }
+  Block &block(Eigen::Index i) { return blocks_[i]; }
+  const Block &block(Eigen::Index i) const { return blocks_[i]; }
+
+  /** @brief Replaces every block by its inverse */
+  void invertInPlace() {
+    for (Block &A : blocks_) A = A.inverse().eval();
+  }
+
+  /** @brief x <- A * x, block by block without temporary vectors */
+  void applyInPlace(Eigen::Ref<Eigen::VectorXd> x) const {
+    for (Eigen::Index i = 0; i < numBlocks(); ++i) {
+      x.template segment<B>(B * i) =
+          (blocks_[i] * x.template segment<B>(B * i)).eval();
+    }
+  }
+
+  Eigen::MatrixXd toDense() const {
+    Eigen::MatrixXd A = Eigen::MatrixXd::Zero(size(), size());
+    for (Eigen::Index i = 0; i < numBlocks(); ++i) {
+      A.template block<B, B>(B * i, B * i) = blocks_[i];
+    }
+    return A;
+  }
+
+ private:
+  std::vector<Block, Eigen::aligned_allocator<Block>> blocks_;
+};
+
+/**
+ * @brief Discontinuous Galerkin method with polynomials of degree P on an
+ * equidistant mesh for a 1D scalar conservation law, generalizing G(...) and
+ * dgcl(...) from discontinuousgalerkin1d.h, which correspond to P = 1.
+ *
+ * The local basis on cell i with center x_i consists of the monomials
+ * (x - x_i)^k, k = 0, ..., P, so that the coefficients of cell i are stored in
+ * mu(B * i), ..., mu(B * i + B - 1), B = P + 1. Volume integrals are computed
+ * by the (P+1)-point Gauss-Legendre rule. As for G(...), the solution is
+ * extended by zero outside the computational domain.
+ *
+ * @tparam FUNCTOR flux function matching std::function<double(double)>
+ * @tparam NUMFLUX numerical flux matching std::function<double(double,
+ * double)>
+ */
+template <int P, typename FUNCTOR, typename NUMFLUX>
+class DGBlockSolver {
+ public:
+  static constexpr int B = P + 1;  // block size = local number of dofs
+  using BlockVector = Eigen::Matrix<double, B, 1>;
+
+  /**
+   * @param f flux function
+   * @param F numerical flux
+   * @param Ml number of negative spacial nodes
+   * @param Mr number of positive spacial nodes
+   * @param h equidistant spacial mesh-width
+   */
+  DGBlockSolver(FUNCTOR f, NUMFLUX F, int Ml, int Mr, double h)
+      : f_(std::move(f)),
+        F_(std::move(F)),
+        n_(Ml + Mr + 1),
+        Minv_(Ml + Mr + 1),
+        k_(B * (Ml + Mr + 1)),
+        y_(B * (Ml + Mr + 1)) {
+    // (P+1)-point Gauss-Legendre rule on [-1, 1] (Golub-Welsch)
+    Eigen::Matrix<double, B, B> J = Eigen::Matrix<double, B, B>::Zero();
+    for (int k = 1; k < B; ++k) {
+      J(k, k - 1) = J(k - 1, k) = k / std::sqrt(4.0 * k * k - 1.0);
+    }
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix<double, B, B>> eig(J);
+    const BlockVector s = 0.5 * h * eig.eigenvalues();  // offsets from x_i
+    const BlockVector w =
+        h * eig.eigenvectors().row(0).transpose().array().square().matrix();
+
+    // Basis functions at the quadrature points and at the cell boundaries,
+    // derivatives at the quadrature points, premultiplied by the weights
+    for (int k = 0; k < B; ++k) {
+      for (int q = 0; q < B; ++q) {
+        V_(q, k) = std::pow(s(q), k);
+        Dw_(q, k) = (k == 0) ? 0.0 : w(q) * k * std::pow(s(q), k - 1);
+      }
+      bl_(k) = std::pow(-0.5 * h, k);
+      br_(k) = std::pow(0.5 * h, k);
+    }
+
+    // The local mass matrices are all the same:
+    // M(k, l) = int_{-h/2}^{h/2} s^{k+l} ds
+    Eigen::Matrix<double, B, B> M;
+    for (int k = 0; k < B; ++k) {
+      for (int l = 0; l < B; ++l) {
+        const int e = k + l + 1;
+        M(k, l) = (std::pow(0.5 * h, e) - std::pow(-0.5 * h, e)) / e;
+      }
+    }
+    for (int i = 0; i < n_; ++i) Minv_.block(i) = M;
+    Minv_.invertInPlace();
+  }
+
+  /** @brief Inverse of the block-diagonal mass matrix */
+  const BlockDiagonalMatrix<B> &inverseMassMatrix() const { return Minv_; }
+
+  /**
+   * @brief Computes dmu = -B^{-1} G(mu) in a single sweep over the cells: the
+   * numerical flux at the right endpoint of cell i is reused at the left
+   * endpoint of cell i+1, and the inverse of the local mass matrix is applied
+   * as soon as the local entries of G are known.
+   * @param mu expansion coefficients, vector of length B * (Ml + Mr + 1)
+   * @param dmu returns -B^{-1} G(mu), same size as mu, must not alias mu
+   */
+  void rhs(const Eigen::VectorXd &mu, Eigen::VectorXd &dmu) const {
+    dmu.resize(mu.size());
+    // mu is extended by zero to the left of the domain
+    double F_old = F_(0.0, bl_.dot(mu.template head<B>()));
+    for (int i = 0; i < n_; ++i) {
+      const BlockVector c = mu.template segment<B>(B * i);
+      const double u_right = br_.dot(c);
+      const double u_next =
+          (i + 1 < n_) ? bl_.dot(mu.template segment<B>(B * (i + 1))) : 0.0;
+      const double F_new = F_(u_right, u_next);
+      // values of f(u_h) at the quadrature points
+      const BlockVector fq = (V_ * c).unaryExpr(f_);
+      const BlockVector g = F_new * br_ - F_old * bl_ - Dw_.transpose() * fq;
+      dmu.template segment<B>(B * i).noalias() = -Minv_.block(i) * g;
+      F_old = F_new;
+    }
+  }
+
+  /**
+   * @brief Time evolution by the explicit midpoint rule as in dgcl(...), with
+   * the stage vectors allocated once in the constructor.
+   * @param mu expansion coefficients at initial time, overwritten by those at
+   * time T
+   * @param T final time
+   * @param m number of timesteps
+   */
+  void evolve(Eigen::VectorXd &mu, double T, unsigned int m) {
+    const double tau = T / m;
+    for (unsigned int i = 0; i < m; ++i) {
+      rhs(mu, k_);
+      y_ = mu + 0.5 * tau * k_;
+      rhs(y_, k_);
+      mu += tau * k_;
+    }
+  }
+
+ private:
+  FUNCTOR f_;
+  NUMFLUX F_;
+  int n_;                           // number of cells
+  BlockDiagonalMatrix<B> Minv_;     // inverse mass matrix
+  Eigen::Matrix<double, B, B> V_;   // V_(q, k) = b_k(s_q)
+  Eigen::Matrix<double, B, B> Dw_;  // Dw_(q, k) = w_q * b_k'(s_q)
+  BlockVector bl_, br_;             // b_k at left/right cell boundary
+  Eigen::VectorXd k_, y_;           // stage workspace
+};
+
+/**
+ * @brief Creates a DGBlockSolver for polynomial degree P, deducing the types of
+ * the flux functions.
+ */
+template <int P, typename FUNCTOR, typename NUMFLUX>
+DGBlockSolver<P, std::decay_t<FUNCTOR>, std::decay_t<NUMFLUX>>
+makeDGBlockSolver(FUNCTOR &&f, NUMFLUX &&F, int Ml, int Mr, double h) {
+  return {std::forward<FUNCTOR>(f), std::forward<NUMFLUX>(F), Ml, Mr, h};
+}
+
+}  // namespace DiscontinuousGalerkin1D
+
+#endif  // DGBLOCKSOLVER_H_
@@ -6,12 +6,45 @@
  * @copyright Developed at ETH Zurich
  */
 
+#include <chrono>
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
 
+#include "dgblocksolver.h"
 #include "discontinuousgalerkin1d.h"
 
+/**
+ * @brief Measures the throughput of the DG timestepping for the traffic flow
+ * problem on a fine mesh in degrees of freedom times timesteps per second.
+ * @param evolve callable performing m timesteps on given initial coefficients
+ */
+template <typename EVOLVE>
+double dofsPerSecond(EVOLVE &&evolve, Eigen::VectorXd mu0, unsigned int m) {
+  auto start = std::chrono::high_resolution_clock::now();
+  evolve(mu0, m);
+  auto end = std::chrono::high_resolution_clock::now();
+  return mu0.size() * m / std::chrono::duration<double>(end - start).count();
+}
+
+template <int P>
+double dofsPerSecondBlockSolver(int Ml, int Mr, double h, unsigned int m) {
+  auto f = [](double u) { return u * (1.0 - u); };
+  auto solver = DiscontinuousGalerkin1D::makeDGBlockSolver<P>(
+      f, DiscontinuousGalerkin1D::Feo, Ml, Mr, h);
+  // initial data: cell averages of characteristic function of [0, 1]
+  const int N_half = Ml + Mr + 1;
+  Eigen::VectorXd mu0 = Eigen::VectorXd::Zero((P + 1) * N_half);
+  for (int i = Ml; i < Ml + int(1.0 / h); ++i) mu0((P + 1) * i) = 1.0;
+  // timestep respecting the CFL condition for degree P
+  const double tau = h / (3.0 * (2 * P + 1));
+  return dofsPerSecond(
+      [&](Eigen::VectorXd &mu, unsigned int steps) {
+        solver.evolve(mu, steps * tau, steps);
+      },
+      mu0, m);
+}
+
 int main() {
   DiscontinuousGalerkin1D::Solution solution =
       DiscontinuousGalerkin1D::solveTrafficFlow();
@@ -30,5 +63,35 @@ int main() {
               "/plot_solution.py " CURRENT_BINARY_DIR
               "/solution.csv " CURRENT_BINARY_DIR "/solution.eps");
 
+  // Throughput of dgcl(...), based on Eigen::SparseMatrix, and of the
+  // block-diagonal DGBlockSolver for various polynomial degrees
+  {
+    const int Ml = 20000;
+    const int Mr = 20000;
+    const double h = 2.0 / Ml;
+    const unsigned int m = 100;
+    auto f = [](double u) { return u * (1.0 - u); };
+    Eigen::VectorXd mu0 = Eigen::VectorXd::Zero(2 * (Ml + Mr + 1));
+    for (int i = Ml; i < Ml + int(1.0 / h); ++i) mu0(2 * i) = 1.0;
+    const double tau = h / 3.0;
+    std::cout << "DG throughput on " << Ml + Mr + 1 << " cells, " << m
+              << " timesteps [dofs * steps / s]" << std::endl;
+    std::cout << "dgcl (SparseMatrix, P = 1): "
+              << dofsPerSecond(
+                     [&](Eigen::VectorXd &mu, unsigned int steps) {
+                       mu = DiscontinuousGalerkin1D::dgcl(
+                           mu, f, DiscontinuousGalerkin1D::Feo, steps * tau,
+                           Ml, Mr, h, steps);
+                     },
+                     mu0, m)
+              << std::endl;
+    std::cout << "DGBlockSolver, P = 1:       "
+              << dofsPerSecondBlockSolver<1>(Ml, Mr, h, m) << std::endl;
+    std::cout << "DGBlockSolver, P = 2:       "
+              << dofsPerSecondBlockSolver<2>(Ml, Mr, h, m) << std::endl;
+    std::cout << "DGBlockSolver, P = 3:       "
+              << dofsPerSecondBlockSolver<3>(Ml, Mr, h, m) << std::endl;
+  }
+
   return 0;
 }
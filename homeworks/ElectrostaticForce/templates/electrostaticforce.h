@@ -9,6 +9,9 @@
 #include <math.h>
 
 #include <iostream>
+#include <memory>
+#include <utility>
+#include <vector>
 
 // Lehrfem++ includes
 #include <lf/assemble/assemble.h>
@@ -55,4 +58,63 @@ Eigen::Vector2d computeForceDomainFunctional(
     const std::shared_ptr<lf::uscalfe::FeSpaceLagrangeO1<double>> &fe_space_p,
     Eigen::VectorXd approx_sol);
 
+/** @brief Solver for the Dirichlet problem for the Laplacian on a fixed mesh
+ * with many different sets of boundary data
+ *
+ * The constructor assembles the Galerkin matrix once, splits it into the
+ * block A_II of the interior dofs and the coupling block A_IB to the
+ * boundary dofs, and factorizes A_II. It also precomputes the gradient
+ * operators and quadrature weights of the two force functionals. Boundary
+ * data are the columns of a matrix whose rows are ordered like
+ * boundaryDofs(); all columns are solved and evaluated at once. */
+class PoissonBVPSolver {
+ public:
+  explicit PoissonBVPSolver(
+      std::shared_ptr<lf::uscalfe::FeSpaceLagrangeO1<double>> fe_space_p);
+
+  /** @brief Global indices of the boundary dofs */
+  const std::vector<lf::assemble::glb_idx_t> &boundaryDofs() const {
+    return bd_dofs_;
+  }
+
+  /** @brief Values of g at the boundary nodes, a column of boundary data */
+  template <typename FUNCTOR>
+  Eigen::VectorXd boundaryValues(FUNCTOR &&g) const {
+    const lf::assemble::DofHandler &dofh{fe_space_p_->LocGlobMap()};
+    Eigen::VectorXd values(bd_dofs_.size());
+    for (std::size_t k = 0; k < bd_dofs_.size(); ++k) {
+      const lf::mesh::Entity &node{dofh.Entity(bd_dofs_[k])};
+      values[k] = g(Eigen::Vector2d(
+          lf::geometry::Corners(*(node.Geometry())).col(0)));
+    }
+    return values;
+  }
+
+  /** @brief Basis coefficient vectors of the solutions, one column for every
+   * column of the boundary data G */
+  Eigen::MatrixXd solve(const Eigen::MatrixXd &G) const;
+
+  /** @brief computeForceBoundaryFunctional() for every column of U */
+  Eigen::Matrix2Xd computeForceBoundaryFunctional(
+      const Eigen::MatrixXd &U) const;
+  /** @brief computeForceDomainFunctional() for every column of U */
+  Eigen::Matrix2Xd computeForceDomainFunctional(const Eigen::MatrixXd &U) const;
+
+ private:
+  std::shared_ptr<lf::uscalfe::FeSpaceLagrangeO1<double>> fe_space_p_;
+  std::vector<lf::assemble::glb_idx_t> bd_dofs_;
+  std::vector<lf::assemble::glb_idx_t> int_dofs_;
+  Eigen::SparseMatrix<double> A_IB_;
+  Eigen::SparseLU<Eigen::SparseMatrix<double>> solver_;
+  // Rows 2k and 2k+1 of grad_bd_ map basis coefficients to the gradient on
+  // the cell adjacent to the k-th edge of the interior boundary. The column
+  // k of weights_bd_ is (1/2) * |e| * n.
+  Eigen::SparseMatrix<double> grad_bd_;
+  Eigen::Matrix2Xd weights_bd_;
+  // The same for the k-th cell. The column k of weights_dom_ is
+  // |K|/3 * (sum of grad(uExact) at the quadrature points).
+  Eigen::SparseMatrix<double> grad_dom_;
+  Eigen::Matrix2Xd weights_dom_;
+};
+
 }  // namespace ElectrostaticForce
@@ -91,4 +91,41 @@ TEST(ElectrostaticForce, solvePoissonBVPBoundaryConditions) {
   }
 }
 
+TEST(ElectrostaticForce, PoissonBVPSolver) {
+  std::string mesh_file =
+      CURRENT_SOURCE_DIR "/../../meshes/emforce" + std::to_string(2) + ".msh";
+  auto mesh_factory = std::make_unique<lf::mesh::hybrid2d::MeshFactory>(2);
+  const lf::io::GmshReader reader(std::move(mesh_factory), mesh_file);
+  auto mesh_p = reader.mesh();
+  auto fe_space_p =
+      std::make_shared<lf::uscalfe::FeSpaceLagrangeO1<double>>(mesh_p);
+
+  Eigen::VectorXd approx_sol = ElectrostaticForce::solvePoissonBVP(fe_space_p);
+  Eigen::Vector2d force_bd =
+      ElectrostaticForce::computeForceBoundaryFunctional(fe_space_p,
+                                                         approx_sol);
+  Eigen::Vector2d force_dom =
+      ElectrostaticForce::computeForceDomainFunctional(fe_space_p, approx_sol);
+
+  // Data of solvePoissonBVP() and twice that data
+  ElectrostaticForce::PoissonBVPSolver solver(fe_space_p);
+  Eigen::MatrixXd G(solver.boundaryDofs().size(), 2);
+  G.col(0) = solver.boundaryValues(
+      [](Eigen::Vector2d x) -> double { return x.norm() < 0.27 ? 1.0 : 0.0; });
+  G.col(1) = 2.0 * G.col(0);
+  Eigen::MatrixXd U = solver.solve(G);
+  Eigen::Matrix2Xd forces_bd = solver.computeForceBoundaryFunctional(U);
+  Eigen::Matrix2Xd forces_dom = solver.computeForceDomainFunctional(U);
+
+  double tol = 1.0e-10;
+  ASSERT_NEAR(0.0, (U.col(0) - approx_sol).lpNorm<Eigen::Infinity>(), tol);
+  ASSERT_NEAR(0.0, (U.col(1) - 2.0 * approx_sol).lpNorm<Eigen::Infinity>(),
+              tol);
+  // The forces are quadratic in the potential
+  ASSERT_NEAR(0.0, (forces_bd.col(0) - force_bd).norm(), tol);
+  ASSERT_NEAR(0.0, (forces_bd.col(1) - 4.0 * force_bd).norm(), tol);
+  ASSERT_NEAR(0.0, (forces_dom.col(0) - force_dom).norm(), tol);
+  ASSERT_NEAR(0.0, (forces_dom.col(1) - 4.0 * force_dom).norm(), tol);
+}
+
 }  // namespace ElectrostaticForce::test
@@ -0,0 +1,151 @@
+#ifndef KRYLOVPHI_H_
+#define KRYLOVPHI_H_
+
+/**
+ * @file krylovphi.h
+ * @brief NPDE homework ExponentialIntegrator code
+ * @author agent
+ * @date 18.10.2026
+ * @copyright Developed at ETH Zurich
+ */
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <cmath>
+#include <unsupported/Eigen/MatrixFunctions>
+
+namespace ExponentialIntegrator {
+
+/**
+ * @brief Computes the action phi(h*J)*v of the function phi(z) = (e^z - 1)/z
+ * by the Arnoldi method, using only matrix-vector products with J.
+ *
+ * An orthonormal basis V_m of the Krylov space K_m(J, v) and the Hessenberg
+ * matrix H_m = V_m^T J V_m yield the approximation
+ *   phi(h*J)*v ~ |v| V_m phi(h*H_m) e_1,
+ * where phi(h*H_m) e_1 is computed with the small dense matrix exponential.
+ * The Krylov dimension m is increased until the estimated relative error is
+ * below the tolerance. It is remembered for the next call, so that a sequence
+ * of similar problems (e.g. the steps of the exponential Euler method) mostly
+ * builds the right basis at the first attempt. If m_max does not suffice,
+ * [0, h] is split into substeps, using that w(t) = t*phi(t*J)*v solves
+ * w' = J*w + v, w(0) = 0.
+ */
+class KrylovPhi {
+ public:
+  /**
+   * @param tol relative tolerance
+   * @param m_max maximal dimension of the Krylov spaces; the basis needs
+   * memory for m_max + 1 vectors
+   */
+  explicit KrylovPhi(double tol = 1.0E-8, int m_max = 30)
+      : tol_(tol), m_max_(m_max) {}
+
+  /**
+   * @brief Returns phi(h*J)*v
+   * @tparam MatrixType any (dense or sparse) matrix type providing J * x
+   */
+  template <class MatrixType>
+  Eigen::VectorXd apply(const MatrixType &J, double h,
+                        const Eigen::VectorXd &v);
+
+  /** @brief Krylov dimension used in the last Arnoldi process */
+  int krylovDimension() const { return m_; }
+
+ private:
+  // Computes y ~ tau*phi(tau*J)*u in a Krylov space, returns the error
+  // estimate relative to tau*|u|
+  template <class MatrixType>
+  double arnoldi(const MatrixType &J, double tau, const Eigen::VectorXd &u,
+                 Eigen::VectorXd &y);
+
+  double tol_;
+  int m_max_;
+  int m_ = 8;              // initial dimension of the Krylov space
+  double substep_ = 1.0;   // length of substeps relative to h
+  Eigen::MatrixXd V_, H_;  // Arnoldi basis and Hessenberg matrix
+};
+
+template <class MatrixType>
+double KrylovPhi::arnoldi(const MatrixType &J, double tau,
+                          const Eigen::VectorXd &u, Eigen::VectorXd &y) {
+  const int n = u.size();
+  const double beta = u.norm();
+  if (beta == 0.0) {
+    y = Eigen::VectorXd::Zero(n);
+    return 0.0;
+  }
+  if (V_.rows() != n || V_.cols() != m_max_ + 1) {
+    V_.resize(n, m_max_ + 1);
+  }
+  H_.setZero(m_max_ + 1, m_max_);
+  V_.col(0) = u / beta;
+
+  int m = std::min(m_, m_max_);
+  int j = 0;  // current dimension of the Krylov space
+  bool breakdown = false;
+  double err;
+  Eigen::VectorXd w(n), phi1;
+  while (true) {
+    // Extend the basis to dimension m by modified Gram-Schmidt
+    for (; j < m && !breakdown; ++j) {
+      w.noalias() = J * V_.col(j);
+      for (int i = 0; i <= j; ++i) {
+        H_(i, j) = w.dot(V_.col(i));
+        w -= H_(i, j) * V_.col(i);
+      }
+      H_(j + 1, j) = w.norm();
+      // Happy breakdown: the Krylov space is invariant under J
+      breakdown = H_(j + 1, j) <= 1.0E-12 * H_.col(j).head(j + 1).norm();
+      if (!breakdown) V_.col(j + 1) = w / H_(j + 1, j);
+    }
+    // Columns j and j+1 of exp(Hhat) contain phi_1(tau*H_j)e_1 and
+    // phi_2(tau*H_j)e_1 (Sidje, Expokit)
+    Eigen::MatrixXd Hhat = Eigen::MatrixXd::Zero(j + 2, j + 2);
+    Hhat.topLeftCorner(j, j) = tau * H_.topLeftCorner(j, j);
+    Hhat(0, j) = 1.0;
+    Hhat(j, j + 1) = 1.0;
+    const Eigen::MatrixXd E = Hhat.exp();
+    phi1 = E.col(j).head(j);
+    err = breakdown ? 0.0 : tau * H_(j, j - 1) * std::abs(E(j - 1, j + 1));
+    if (err <= tol_ || j == m_max_) break;
+    m = std::min(m_max_, j + std::max(2, j / 4));
+  }
+  // Remember the dimension for the next call; shrink it if it was too large
+  m_ = (err < 1.0E-3 * tol_) ? std::max(4, (3 * j) / 4) : j;
+
+  y = (tau * beta) * (V_.leftCols(j) * phi1);
+  return err;
+}
+
+/* SAM_LISTING_BEGIN_0 */
+template <class MatrixType>
+Eigen::VectorXd KrylovPhi::apply(const MatrixType &J, double h,
+                                 const Eigen::VectorXd &v) {
+  // w(t) = t*phi(t*J)*v solves w' = J*w + v, w(0) = 0, so that
+  // w(t + tau) = w(t) + tau*phi(tau*J)*(J*w(t) + v)
+  Eigen::VectorXd w = Eigen::VectorXd::Zero(v.size());
+  Eigen::VectorXd y;
+  double t = 0.0;
+  double tau = substep_ * h;
+  while (t < h) {
+    const double tau_t = std::min(tau, h - t);
+    const Eigen::VectorXd u = (t == 0.0) ? v : Eigen::VectorXd(J * w + v);
+    if (arnoldi(J, tau_t, u, y) > tol_) {
+      // The maximal Krylov dimension does not suffice
+      tau *= 0.5;
+      continue;
+    }
+    w += y;
+    t += tau_t;
+    // Try longer substeps again if the Krylov spaces are small
+    if (2 * m_ < m_max_) tau *= 2.0;
+  }
+  substep_ = std::min(1.0, tau / h);
+  return w / h;
+}
+/* SAM_LISTING_END_0 */
+
+}  // namespace ExponentialIntegrator
+
+#endif  // #ifndef KRYLOVPHI_H_
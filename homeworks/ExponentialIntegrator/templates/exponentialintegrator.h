@@ -11,6 +11,8 @@
 
 #include <Eigen/Core>
 
+#include "krylovphi.h"
+
 namespace ExponentialIntegrator {
 
 Eigen::MatrixXd phim(const Eigen::MatrixXd &Z);
@@ -28,8 +30,20 @@ Eigen::VectorXd exponentialEulerStep(const Eigen::VectorXd &y0, Function &&f,
 }
 /* SAM_LISTING_END_0 */
 
+// Single step of the exponential Euler method for large (sparse) Jacobians:
+// only the action of phi(h*Df(y0)) on f(y0) is computed by a Krylov method.
+// The Jacobian may be of any matrix type supporting matrix-vector products.
+template <class Function, class Jacobian>
+Eigen::VectorXd exponentialEulerStepKrylov(const Eigen::VectorXd &y0,
+                                           Function &&f, Jacobian &&df,
+                                           double h, KrylovPhi &phi) {
+  return y0 + h * phi.apply(df(y0), h, f(y0));
+}
+
 void testExpEulerLogODE();
 
+void benchmarkKrylovPhi();
+
 }  // namespace ExponentialIntegrator
 
 #endif  // #ifndef EXPONENTIALINTEGRATOR_H_
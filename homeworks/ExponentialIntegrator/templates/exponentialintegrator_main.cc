@@ -11,5 +11,7 @@
 int main() {
   ExponentialIntegrator::testExpEulerLogODE();
 
+  ExponentialIntegrator::benchmarkKrylovPhi();
+
   return 0;
 }
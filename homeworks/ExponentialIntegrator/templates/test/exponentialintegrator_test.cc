@@ -11,6 +11,8 @@
 #include <gtest/gtest.h>
 
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
+#include <vector>
 
 namespace ExponentialIntegrator::test {
 
@@ -53,4 +55,67 @@ TEST(exponentialEulerStep, vector) {
   EXPECT_NEAR(y[1], y1[1], 1e-8);
 }
 
+TEST(KrylovPhi, dense) {
+  // Nonsymmetric matrix with eigenvalues of different magnitude
+  const int n = 40;
+  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(n, n);
+  for (int i = 0; i < n; ++i) {
+    A(i, i) = -1.0 - i;
+    if (i + 1 < n) A(i, i + 1) = 2.0;
+    if (i > 0) A(i, i - 1) = -1.0;
+  }
+  const Eigen::VectorXd v = Eigen::VectorXd::LinSpaced(n, -1.0, 2.0);
+  KrylovPhi phi(1e-10);
+  for (double h : {0.01, 0.1, 1.0}) {
+    const Eigen::VectorXd y = phi.apply(A, h, v);
+    const Eigen::VectorXd y_ref = phim(h * A) * v;
+    EXPECT_NEAR((y - y_ref).norm() / y_ref.norm(), 0.0, 1e-8);
+  }
+}
+
+TEST(KrylovPhi, sparse) {
+  // Stiff 1D Laplacian, which needs substeps for small m_max
+  const int n = 200;
+  std::vector<Eigen::Triplet<double>> triplets;
+  for (int i = 0; i < n; ++i) {
+    triplets.emplace_back(i, i, -2.0 * n * n);
+    if (i > 0) triplets.emplace_back(i, i - 1, 1.0 * n * n);
+    if (i < n - 1) triplets.emplace_back(i, i + 1, 1.0 * n * n);
+  }
+  Eigen::SparseMatrix<double> L(n, n);
+  L.setFromTriplets(triplets.begin(), triplets.end());
+  const Eigen::VectorXd v = Eigen::VectorXd::Ones(n);
+  const double h = 1e-3;
+  const Eigen::VectorXd y_ref = phim(h * Eigen::MatrixXd(L)) * v;
+
+  for (int m_max : {10, 40}) {
+    KrylovPhi phi(1e-10, m_max);
+    // repeated calls reuse the Krylov dimension of the previous call
+    for (int k = 0; k < 3; ++k) {
+      const Eigen::VectorXd y = phi.apply(L, h, v);
+      EXPECT_NEAR((y - y_ref).norm() / y_ref.norm(), 0.0, 1e-8);
+      EXPECT_LE(phi.krylovDimension(), m_max);
+    }
+  }
+}
+
+TEST(exponentialEulerStepKrylov, vector) {
+  Eigen::MatrixXd A(2, 2);
+  A << -1.0, 1.0, 0.0, -2.0;
+  auto f = [&](const Eigen::VectorXd &y) { return A * y; };
+  auto df = [&](const Eigen::VectorXd &y) { return A; };
+
+  Eigen::VectorXd y0(2);
+  y0 << 2.0, 1.0;
+  // For linear ODEs the exponential Euler method is exact
+  const Eigen::VectorXd y1 = (A.exp() * y0).eval();
+
+  KrylovPhi phi;
+  const Eigen::VectorXd y =
+      ExponentialIntegrator::exponentialEulerStepKrylov(y0, f, df, 1, phi);
+
+  EXPECT_NEAR(y[0], y1[0], 1e-8);
+  EXPECT_NEAR(y[1], y1[1], 1e-8);
+}
+
 }  // namespace ExponentialIntegrator::test
@@ -42,5 +42,7 @@ int main() {
     std::cout << M(i) << "\t" << (y_approx - y_ref).norm() << "\t" << std::endl;
   }
 
+  GradientFlow::BenchmarkFrozenJacobian();
+
   return 0;
 }
@@ -9,7 +9,10 @@
 #include "gradientflow.h"
 
 #include <Eigen/Core>
+#include <chrono>
 #include <cmath>
+#include <iomanip>
+#include <iostream>
 #include <vector>
 
 namespace GradientFlow {
@@ -30,10 +33,9 @@ Eigen::MatrixXd ButcherMatrix() {
 /* SAM_LISTING_END_0 */
 
 /* SAM_LISTING_BEGIN_1 */
-std::vector<Eigen::VectorXd> SolveGradientFlow(const Eigen::VectorXd &d,
-                                               double lambda,
-                                               const Eigen::VectorXd &y0,
-                                               double T, unsigned int M) {
+std::vector<Eigen::VectorXd> SolveGradientFlow(
+    const Eigen::VectorXd &d, double lambda, const Eigen::VectorXd &y0,
+    double T, unsigned int M, bool frozen_jacobian, NewtonStatistics *stats) {
   // initialize solution vector
   std::vector<Eigen::VectorXd> sol(M + 1, Eigen::VectorXd::Zero(y0.size()));
 
@@ -44,4 +46,41 @@ std::vector<Eigen::VectorXd> SolveGradientFlow(const Eigen::VectorXd &d,
 }
 /* SAM_LISTING_END_1 */
 
+/* SAM_LISTING_BEGIN_2 */
+void BenchmarkFrozenJacobian() {
+  const double T = 1.0;
+  const double lambda = 10.0;
+  std::cout << "Full vs. frozen-Jacobian Newton method, T = " << T
+            << ", lambda = " << lambda << std::endl;
+  std::cout << std::setw(5) << "dim" << std::setw(6) << "M" << std::setw(8)
+            << "frozen" << std::setw(10) << "df/step" << std::setw(10)
+            << "LU/step" << std::setw(10) << "it/step" << std::setw(12)
+            << "time [ms]" << std::setw(14) << "difference" << std::endl;
+  for (int dim : {2, 50, 200}) {
+    const Eigen::VectorXd d = Eigen::VectorXd::Ones(dim) / std::sqrt(dim);
+    const Eigen::VectorXd y0 =
+        Eigen::VectorXd::LinSpaced(dim, 1.0, -0.5).normalized();
+    for (unsigned int M : {10, 100}) {
+      Eigen::VectorXd yT[2];
+      for (bool frozen : {false, true}) {
+        NewtonStatistics stats;
+        auto start = std::chrono::high_resolution_clock::now();
+        yT[frozen] =
+            SolveGradientFlow(d, lambda, y0, T, M, frozen, &stats).back();
+        auto end = std::chrono::high_resolution_clock::now();
+        const double ms =
+            std::chrono::duration<double, std::milli>(end - start).count();
+        const double steps = stats.steps > 0 ? stats.steps : 1;
+        std::cout << std::setw(5) << dim << std::setw(6) << M << std::setw(8)
+                  << frozen << std::setw(10) << stats.jacobians / steps
+                  << std::setw(10) << stats.factorizations / steps
+                  << std::setw(10) << stats.iterations / steps
+                  << std::setw(12) << ms << std::setw(14)
+                  << (frozen ? (yT[1] - yT[0]).norm() : 0.0) << std::endl;
+      }
+    }
+  }
+}
+/* SAM_LISTING_END_2 */
+
 }  // namespace GradientFlow
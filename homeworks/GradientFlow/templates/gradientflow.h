@@ -19,13 +19,22 @@ namespace GradientFlow {
 // Compute the Buther scheme of the SDIRK scheme
 Eigen::MatrixXd ButcherMatrix();
 
+// Cost counters of the Newton methods for the stages, summed over all calls
+struct NewtonStatistics {
+  unsigned int steps = 0;           // SDIRK steps
+  unsigned int jacobians = 0;       // evaluations of df
+  unsigned int factorizations = 0;  // LU-factorizations
+  unsigned int iterations = 0;      // Newton iterations (linear solves)
+};
+
 /* SAM_LISTING_BEGIN_0 */
 // Use Newton method to approximate a stage.
 template <typename Functor, typename Jacobian>
 Eigen::VectorXd SolveGenStageEquation(Functor &&f, Jacobian &&df,
                                       const Eigen::VectorXd &y,
                                       const Eigen::VectorXd &b, double h,
-                                      double rtol = 1E-6, double atol = 1E-8) {
+                                      double rtol = 1E-6, double atol = 1E-8,
+                                      NewtonStatistics *stats = nullptr) {
   // Need to solve the equation lhs(g) = g - h*f(y+g)/4 - b = 0.
   // lhs and its Jacobian Jlhs
   auto lhs = [f, y, b, h](const Eigen::VectorXd &g) {
@@ -52,6 +61,12 @@ Eigen::VectorXd SolveGenStageEquation(Functor &&f, Jacobian &&df,
     delta = -Jlhs(g).lu().solve(lhs(g));
     iter++;
   }
+  if (stats) {
+    // Every iteration evaluates and factorizes the Jacobian
+    stats->jacobians += iter + 1;
+    stats->factorizations += iter + 1;
+    stats->iterations += iter + 1;
+  }
   return g + delta;  // Perform the final step
 }
 /* SAM_LISTING_END_0 */
@@ -60,10 +75,9 @@ Eigen::VectorXd SolveGenStageEquation(Functor &&f, Jacobian &&df,
 // Compute the stages [g_1, ... , g_5] of the SDIRK method based on Newtons
 // method
 template <typename Func, typename Jac>
-std::array<Eigen::VectorXd, 5> ComputeStages(Func &&f, Jac &&df,
-                                             const Eigen::VectorXd &y, double h,
-                                             double rtol = 1E-6,
-                                             double atol = 1E-8) {
+std::array<Eigen::VectorXd, 5> ComputeStages(
+    Func &&f, Jac &&df, const Eigen::VectorXd &y, double h,
+    double rtol = 1E-6, double atol = 1E-8, NewtonStatistics *stats = nullptr) {
   std::array<Eigen::VectorXd, 5> G;  // array of stages
   int dim = y.size();
   Eigen::MatrixXd coeffs = ButcherMatrix();
@@ -76,19 +90,92 @@ std::array<Eigen::VectorXd, 5> ComputeStages(Func &&f, Jac &&df,
     }
     b *= h;
     // Compute stage i and store in G.at(i):
-    G[i] = SolveGenStageEquation(f, df, y, b, h, rtol, atol);
+    G[i] = SolveGenStageEquation(f, df, y, b, h, rtol, atol, stats);
   }
 
   return G;
 }
 /* SAM_LISTING_END_1 */
 
+/* SAM_LISTING_BEGIN_2 */
+// Same as ComputeStages(), but with a simplified Newton method: all stages
+// share the diagonal coefficient 1/4, so a single LU-factorization of
+// I - h/4*df(y) serves all Newton iterations of all five stages. The
+// Jacobian is only re-evaluated (at the current iterate) and refactorized if
+// the contraction rate |delta_k|/|delta_{k-1}| exceeds theta_max.
+template <typename Func, typename Jac>
+std::array<Eigen::VectorXd, 5> ComputeStagesFrozen(
+    Func &&f, Jac &&df, const Eigen::VectorXd &y, double h,
+    double rtol = 1E-6, double atol = 1E-8, NewtonStatistics *stats = nullptr,
+    double theta_max = 0.5) {
+  std::array<Eigen::VectorXd, 5> G;  // array of stages
+  int dim = y.size();
+  Eigen::MatrixXd coeffs = ButcherMatrix();
+  NewtonStatistics count;
+
+  // Frozen iteration matrix I - h/4*df
+  Eigen::PartialPivLU<Eigen::MatrixXd> lu;
+  auto factorize = [&](const Eigen::VectorXd &x) {
+    lu.compute(Eigen::MatrixXd::Identity(dim, dim) - 0.25 * h * df(x));
+    count.jacobians++;
+    count.factorizations++;
+  };
+  factorize(y);
+
+  for (int i = 0; i < 5; i++) {
+    Eigen::VectorXd b = Eigen::VectorXd::Zero(dim);
+    for (int j = 0; j < i; j++) {
+      b += coeffs(i, j) * f(y + G[j]);
+    }
+    b *= h;
+    auto lhs = [&](const Eigen::VectorXd &g) {
+      Eigen::VectorXd val = g - 0.25 * h * f(y + g) - b;
+      return val;
+    };
+
+    Eigen::VectorXd g = Eigen::VectorXd::Zero(dim);  // initial guess g=0.
+    Eigen::VectorXd delta = -lu.solve(lhs(g));
+    count.iterations++;
+    double delta_old = -1.0;  // no previous correction yet
+    int maxiter = 100;  // If correction based termination does not work.
+    for (int iter = 0; iter < maxiter; iter++) {
+      if (delta.norm() <= atol || delta.norm() <= rtol * (g + delta).norm()) {
+        break;
+      }
+      if (delta_old >= 0.0 && delta.norm() > theta_max * delta_old) {
+        // Poor contraction: the frozen Jacobian is too far off
+        factorize(y + g);
+        delta = -lu.solve(lhs(g));
+        count.iterations++;
+        delta_old = -1.0;
+        continue;
+      }
+      g += delta;
+      delta_old = delta.norm();
+      delta = -lu.solve(lhs(g));
+      count.iterations++;
+    }
+    G[i] = g + delta;  // Perform the final step
+  }
+
+  if (stats) {
+    stats->jacobians += count.jacobians;
+    stats->factorizations += count.factorizations;
+    stats->iterations += count.iterations;
+  }
+  return G;
+}
+/* SAM_LISTING_END_2 */
+
 /* SAM_LISTING_BEGIN_4 */
-// Compute one step of the SDIRK scheme
+// Compute one step of the SDIRK scheme. The stages are computed by
+// ComputeStagesFrozen() if frozen_jacobian is true, by ComputeStages()
+// otherwise; stats, if given, accumulates the cost of the Newton methods.
 template <typename Func, typename Jac>
 Eigen::VectorXd DiscEvolSDIRK(Func &&f, Jac &&df, const Eigen::VectorXd &y,
-                              double h, double rtol = 1E-6,
-                              double atol = 1E-8) {
+                              double h, double rtol = 1E-6, double atol = 1E-8,
+                              bool frozen_jacobian = false,
+                              NewtonStatistics *stats = nullptr) {
   // The b weights are in the last row of coeffs.
   Eigen::MatrixXd coeffs = ButcherMatrix();
   int n_stages = coeffs.cols();
@@ -105,10 +192,13 @@ Eigen::VectorXd DiscEvolSDIRK(Func &&f, Jac &&df, const Eigen::VectorXd &y,
 /* SAM_LISTING_END_4 */
 // Solve the gradient flow problem based on the SDIRK scheme using M uniform
 // timesteps. Return the full approximated solution trajectory
-std::vector<Eigen::VectorXd> SolveGradientFlow(const Eigen::VectorXd &d,
-                                               double lambda,
-                                               const Eigen::VectorXd &y0,
-                                               double T, unsigned int M);
+std::vector<Eigen::VectorXd> SolveGradientFlow(
+    const Eigen::VectorXd &d, double lambda, const Eigen::VectorXd &y0,
+    double T, unsigned int M, bool frozen_jacobian = false,
+    NewtonStatistics *stats = nullptr);
+
+// Compare the cost of full and frozen-Jacobian Newton methods for the stages
+void BenchmarkFrozenJacobian();
 
 }  // namespace GradientFlow
 
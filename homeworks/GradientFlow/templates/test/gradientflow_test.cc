@@ -58,6 +58,29 @@ TEST(GradientFlow, DiscEvolSDIRK) {
   ASSERT_NEAR(0.0, (yh - yh_reference).lpNorm<Eigen::Infinity>(), tol);
 }
 
+TEST(GradientFlow, computeStagesFrozen) {
+  double h = 0.5;
+  Eigen::Vector2d y0(1.0, 0.5);
+
+  NewtonStatistics full, frozen;
+  std::array<Eigen::VectorXd, 5> stages_full =
+      ComputeStages(f, df, y0, h, 1E-10, 1E-12, &full);
+  std::array<Eigen::VectorXd, 5> stages =
+      ComputeStagesFrozen(f, df, y0, h, 1E-10, 1E-12, &frozen);
+
+  double tol = 1.0e-8;
+  for (std::size_t i = 0; i < stages.size(); ++i) {
+    ASSERT_NEAR(0.0, (stages[i] - stages_full[i]).lpNorm<Eigen::Infinity>(),
+                tol);
+  }
+  // One Jacobian per Newton iteration vs. (at least) one per step
+  EXPECT_EQ(full.jacobians, full.iterations);
+  EXPECT_EQ(full.factorizations, full.iterations);
+  EXPECT_GE(frozen.jacobians, 1);
+  EXPECT_EQ(frozen.factorizations, frozen.jacobians);
+  EXPECT_LT(frozen.factorizations, full.factorizations);
+}
+
 constexpr double SQRT2 = 1.41421356237309504880;
 
 TEST(GradientFlow, SolveGradientFlow) {
@@ -83,6 +106,16 @@ TEST(GradientFlow, SolveGradientFlow) {
 
   double tol = 1.0e-6;
   ASSERT_NEAR(0.0, (Y - Y_reference).lpNorm<Eigen::Infinity>(), tol);
+
+  // Same trajectory with the frozen-Jacobian Newton method
+  NewtonStatistics stats;
+  yvector = SolveGradientFlow(d, lambda, y0, T, M, true, &stats);
+  for (std::size_t i = 0; i < yvector.size(); ++i) {
+    Y.row(i) = yvector[i];
+  }
+  ASSERT_NEAR(0.0, (Y - Y_reference).lpNorm<Eigen::Infinity>(), tol);
+  EXPECT_EQ(stats.steps, M);
+  EXPECT_LE(stats.factorizations, 2 * M);
 }
 
 }  // namespace GradientFlow::test
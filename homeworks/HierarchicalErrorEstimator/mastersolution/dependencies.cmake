@@ -17,4 +17,5 @@ set(LIBRARIES
   LF::lf.io
   LF::lf.fe
   LF::lf.uscalfe
+  Threads::Threads
 )
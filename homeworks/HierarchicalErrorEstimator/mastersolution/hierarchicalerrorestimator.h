@@ -11,11 +11,20 @@
 #include <lf/fe/fe.h>
 #include <lf/geometry/geometry.h>
 #include <lf/mesh/mesh.h>
+#include <lf/quad/quad.h>
 #include <lf/uscalfe/uscalfe.h>
 
 #include <Eigen/Core>
+#include <Eigen/LU>
 #include <Eigen/Sparse>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
 #include <memory>
+#include <vector>
+
+#include "../../../lecturecodes/helperfiles/parallelchunks.h"
 
 namespace HEST {
 
@@ -223,6 +232,145 @@ Eigen::VectorXd compHierSurplusSolution(
 }
 /* SAM_LISTING_END_3 */
 
+/** @brief Localized hierarchical surplus, indexed by edges */
+struct LocalHierSurplus {
+  Eigen::VectorXd coeffs;  // coefficient of the edge bubble b_e
+  Eigen::VectorXd eta_sq;  // squared local estimate coeffs[e]^2*a(b_e,b_e)
+  double estimate;  // square root of the sum of eta_sq
+};
+
+/**
+ * @brief Localized hierarchical error estimator on a TRIANGULAR mesh
+ *
+ * Instead of the coupled surplus problem of compHierSurplusSolution, one
+ * scalar problem per interior edge e is solved: the coefficient of the
+ * quadratic edge bubble b_e = 4*lambda_i*lambda_j is
+ *
+ *   nu_e = (f(b_e) - a(u_h, b_e)) / a(b_e, b_e),
+ *
+ * i.e. the diagonal of the surplus Galerkin matrix replaces the matrix. The
+ * estimate sqrt(sum_e nu_e^2 a(b_e, b_e)) is equivalent to the one of the
+ * global surplus problem, with constants depending only on the shape
+ * regularity of the mesh.
+ *
+ * No quadratic Galerkin matrix is assembled. A parallel sweep over the cells
+ * computes the contributions of every cell to its three edges, a parallel
+ * sweep over the edges gathers them. The cost is linear in the number of
+ * edges.
+ *
+ * @param mu coefficient vector of the linear FE solution
+ * @param threads number of threads of both sweeps
+ */
+/* SAM_LISTING_BEGIN_4 */
+template <typename MESHFUNCTION_ALPHA, typename MESHFUNCTION_F>
+LocalHierSurplus compLocalHierSurplus(
+    const MESHFUNCTION_ALPHA &mf_alpha, const MESHFUNCTION_F &mf_f,
+    std::shared_ptr<const lf::uscalfe::FeSpaceLagrangeO1<double>> fes_lin_p,
+    const Eigen::VectorXd &mu, unsigned int threads = 1) {
+  const lf::assemble::DofHandler &dh_lfe{fes_lin_p->LocGlobMap()};
+  LF_ASSERT_MSG(dh_lfe.NumDofs() == mu.size(), "Vector length mismatch");
+  std::shared_ptr<const lf::mesh::Mesh> mesh_p{dh_lfe.Mesh()};
+  const lf::mesh::Mesh &mesh{*mesh_p};
+  const lf::base::size_type n_cells = mesh.NumEntities(0);
+  const lf::base::size_type n_edges = mesh.NumEntities(1);
+  constexpr lf::base::size_type kNone =
+      std::numeric_limits<lf::base::size_type>::max();
+
+  // Slots 3*k+l of the cells adjacent to an edge, filled sequentially
+  std::vector<std::array<lf::base::size_type, 2>> edge_slots(n_edges,
+                                                            {kNone, kNone});
+  for (const lf::mesh::Entity *cell : mesh.Entities(0)) {
+    LF_VERIFY_MSG(cell->RefEl() == lf::base::RefEl::kTria(),
+                  "Only implemented for triangular cells");
+    const lf::base::size_type k = mesh.Index(*cell);
+    auto edges = cell->SubEntities(1);
+    for (int l = 0; l < 3; ++l) {
+      std::array<lf::base::size_type, 2> &slots =
+          edge_slots[mesh.Index(*edges[l])];
+      slots[slots[0] == kNone ? 0 : 1] = 3 * k + l;
+    }
+  }
+
+  LocalHierSurplus result;
+  result.coeffs = Eigen::VectorXd::Zero(n_edges);
+  result.eta_sq = Eigen::VectorXd::Zero(n_edges);
+  // Contributions of cell k to its local edge l: residual and diagonal entry
+  std::vector<double> cell_res(3 * n_cells);
+  std::vector<double> cell_diag(3 * n_cells);
+  // Degree 4 is exact for a(b_e, b_e) with piecewise constant alpha and
+  // for f(b_e) with piecewise quadratic f
+  const lf::quad::QuadRule qr =
+      lf::quad::make_QuadRule(lf::base::RefEl::kTria(), 4);
+  const Eigen::MatrixXd &zeta{qr.Points()};
+  // Barycentric coordinates of the quadrature points
+  Eigen::MatrixXd lambda(3, qr.NumPoints());
+  lambda.row(0) = Eigen::RowVectorXd::Ones(qr.NumPoints()) -
+                  zeta.row(0) - zeta.row(1);
+  lambda.bottomRows(2) = zeta;
+
+  // Cell sweep: every cell writes only its own three slots
+  auto cell_sweep = [&](unsigned int /*t*/, lf::base::size_type begin,
+                        lf::base::size_type end) {
+    for (lf::base::size_type k = begin; k < end; ++k) {
+      const lf::mesh::Entity &cell{*mesh.EntityByIndex(0, k)};
+      const Eigen::MatrixXd corners = lf::geometry::Corners(*cell.Geometry());
+      Eigen::Matrix3d X;
+      X.col(0).setOnes();
+      X.rightCols(2) = corners.transpose();
+      const double area = 0.5 * std::abs(X.determinant());
+      // Columns: gradients of the barycentric coordinate functions
+      const Eigen::Matrix<double, 2, 3> grad_bary =
+          X.inverse().bottomRows(2);
+      // Constant gradient of the linear FE solution
+      nonstd::span<const lf::assemble::gdof_idx_t> dofs{
+          dh_lfe.GlobalDofIndices(cell)};
+      const Eigen::Vector2d grad_uh = grad_bary.col(0) * mu[dofs[0]] +
+                                      grad_bary.col(1) * mu[dofs[1]] +
+                                      grad_bary.col(2) * mu[dofs[2]];
+      const auto alpha_q = mf_alpha(cell, zeta);
+      const auto f_q = mf_f(cell, zeta);
+      for (int l = 0; l < 3; ++l) {
+        // Local edge l connects the vertices l and l+1
+        const int i = l;
+        const int j = (l + 1) % 3;
+        double res = 0.0;
+        double diag = 0.0;
+        for (lf::base::size_type q = 0; q < qr.NumPoints(); ++q) {
+          const double w = 2.0 * area * qr.Weights()[q];
+          const double b = 4.0 * lambda(i, q) * lambda(j, q);
+          const Eigen::Vector2d grad_b =
+              4.0 * (lambda(i, q) * grad_bary.col(j) +
+                     lambda(j, q) * grad_bary.col(i));
+          // Scalar or tensor-valued diffusion coefficient
+          const Eigen::Vector2d flux_b = alpha_q[q] * grad_b;
+          res += w * (f_q[q] * b - grad_uh.dot(flux_b));
+          diag += w * grad_b.dot(flux_b);
+        }
+        cell_res[3 * k + l] = res;
+        cell_diag[3 * k + l] = diag;
+      }
+    }
+  };
+  parallelChunks(n_cells, threads, cell_sweep);
+
+  // Edge sweep: independent 1x1 problems, boundary edges carry no bubble
+  auto edge_sweep = [&](unsigned int /*t*/, lf::base::size_type begin,
+                        lf::base::size_type end) {
+    for (lf::base::size_type e = begin; e < end; ++e) {
+      const std::array<lf::base::size_type, 2> &slots = edge_slots[e];
+      if (slots[1] == kNone) continue;
+      const double res = cell_res[slots[0]] + cell_res[slots[1]];
+      const double diag = cell_diag[slots[0]] + cell_diag[slots[1]];
+      result.coeffs[e] = res / diag;
+      result.eta_sq[e] = res * res / diag;
+    }
+  };
+  parallelChunks(n_edges, threads, edge_sweep);
+  result.estimate = std::sqrt(result.eta_sq.sum());
+  return result;
+}
+/* SAM_LISTING_END_4 */
+
 std::tuple<double, double, double> solveAndEstimate(
     std::shared_ptr<const lf::mesh::Mesh> mesh_p);
 
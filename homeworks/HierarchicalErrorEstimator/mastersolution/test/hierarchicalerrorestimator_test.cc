@@ -14,6 +14,7 @@
 #include <lf/mesh/mesh.h>
 #include <lf/mesh/test_utils/test_meshes.h>
 
+#include <cmath>
 #include <iostream>
 
 namespace HEST::test {
@@ -87,4 +88,54 @@ TEST(HEST, compHierSurplusSolution) {
   // Still no idea how to test the other components
 }
 
+TEST(HEST, compLocalHierSurplus) {
+  // Obtain triangular test mesh of the unit square
+  std::shared_ptr<lf::mesh::Mesh> mesh_ptr =
+      lf::mesh::test_utils::GenerateHybrid2DTestMesh(3, 1.0 / 3.0);
+  std::shared_ptr<lf::uscalfe::FeSpaceLagrangeO2<double>> quad_space_p =
+      std::make_shared<lf::uscalfe::FeSpaceLagrangeO2<double>>(mesh_ptr);
+  std::shared_ptr<lf::uscalfe::FeSpaceLagrangeO1<double>> lfe_space_p =
+      std::make_shared<lf::uscalfe::FeSpaceLagrangeO1<double>>(mesh_ptr);
+  const lf::assemble::DofHandler &dh_quad{quad_space_p->LocGlobMap()};
+  const lf::base::size_type N_qdofs = dh_quad.NumDofs();
+  // Constant coefficient and linear source: all quadrature rules are exact
+  lf::mesh::utils::MeshFunctionConstant mf_alpha(1.0);
+  lf::mesh::utils::MeshFunctionGlobal mf_f(
+      [](Eigen::Vector2d x) -> double { return 1.0 + x[0] - 2.0 * x[1]; });
+  const Eigen::VectorXd mu{solveBVPWithLinFE(mf_alpha, mf_f, lfe_space_p)};
+
+  // Reference: residual and diagonal of the quadratic Galerkin matrix
+  lf::assemble::COOMatrix<double> A(N_qdofs, N_qdofs);
+  lf::fe::DiffusionElementMatrixProvider<double, decltype(mf_alpha)>
+      elmat_builder(quad_space_p, mf_alpha);
+  lf::assemble::AssembleMatrixLocally(0, dh_quad, dh_quad, elmat_builder, A);
+  Eigen::VectorXd phi = Eigen::VectorXd::Zero(N_qdofs);
+  lf::uscalfe::ScalarLoadElementVectorProvider<double, decltype(mf_f)>
+      elvec_builder(quad_space_p, mf_f);
+  lf::assemble::AssembleVectorLocally(0, dh_quad, elvec_builder, phi);
+  const Eigen::VectorXd residual =
+      phi + A.MatVecMult(-1.0, trfLinToQuad(lfe_space_p, quad_space_p, mu));
+  const Eigen::SparseMatrix<double> A_crs = A.makeSparse();
+
+  for (unsigned int threads : {1u, 3u}) {
+    const LocalHierSurplus local =
+        compLocalHierSurplus(mf_alpha, mf_f, lfe_space_p, mu, threads);
+    auto bd_flags{lf::mesh::utils::flagEntitiesOnBoundary(mesh_ptr, 1)};
+    double eta_sq = 0.0;
+    for (const lf::mesh::Entity *edge : mesh_ptr->Entities(1)) {
+      const lf::base::size_type e = mesh_ptr->Index(*edge);
+      if (bd_flags(*edge)) {
+        EXPECT_EQ(local.coeffs[e], 0.0);
+        continue;
+      }
+      const lf::assemble::gdof_idx_t q{
+          dh_quad.InteriorGlobalDofIndices(*edge)[0]};
+      const double a_ee = A_crs.coeff(q, q);
+      EXPECT_NEAR(local.coeffs[e], residual[q] / a_ee, 1.0E-10);
+      eta_sq += residual[q] * residual[q] / a_ee;
+    }
+    EXPECT_NEAR(local.estimate, std::sqrt(eta_sq), 1.0E-10);
+  }
+}
+
 }  // namespace HEST::test
@@ -11,11 +11,20 @@
 #include <lf/fe/fe.h>
 #include <lf/geometry/geometry.h>
 #include <lf/mesh/mesh.h>
+#include <lf/quad/quad.h>
 #include <lf/uscalfe/uscalfe.h>
 
 #include <Eigen/Core>
+#include <Eigen/LU>
 #include <Eigen/Sparse>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
 #include <memory>
+#include <vector>
+
+#include "../../../lecturecodes/helperfiles/parallelchunks.h"
 
 namespace HEST {
 
@@ -153,6 +162,79 @@ Eigen::VectorXd compHierSurplusSolution(
 }
 /* SAM_LISTING_END_3 */
 
+/** @brief Localized hierarchical surplus, indexed by edges */
+struct LocalHierSurplus {
+  Eigen::VectorXd coeffs;  // coefficient of the edge bubble b_e
+  Eigen::VectorXd eta_sq;  // squared local estimate coeffs[e]^2*a(b_e,b_e)
+  double estimate;  // square root of the sum of eta_sq
+};
+
+/**
+ * @brief Localized hierarchical error estimator on a TRIANGULAR mesh
+ *
+ * Instead of the coupled surplus problem of compHierSurplusSolution, one
+ * scalar problem per interior edge e is solved: the coefficient of the
+ * quadratic edge bubble b_e = 4*lambda_i*lambda_j is
+ *
+ *   nu_e = (f(b_e) - a(u_h, b_e)) / a(b_e, b_e),
+ *
+ * i.e. the diagonal of the surplus Galerkin matrix replaces the matrix. The
+ * estimate sqrt(sum_e nu_e^2 a(b_e, b_e)) is equivalent to the one of the
+ * global surplus problem, with constants depending only on the shape
+ * regularity of the mesh.
+ *
+ * No quadratic Galerkin matrix is assembled. A parallel sweep over the cells
+ * computes the contributions of every cell to its three edges, a parallel
+ * sweep over the edges gathers them. The cost is linear in the number of
+ * edges.
+ *
+ * @param mu coefficient vector of the linear FE solution
+ * @param threads number of threads of both sweeps
+ */
+/* SAM_LISTING_BEGIN_4 */
+template <typename MESHFUNCTION_ALPHA, typename MESHFUNCTION_F>
+LocalHierSurplus compLocalHierSurplus(
+    const MESHFUNCTION_ALPHA &mf_alpha, const MESHFUNCTION_F &mf_f,
+    std::shared_ptr<const lf::uscalfe::FeSpaceLagrangeO1<double>> fes_lin_p,
+    const Eigen::VectorXd &mu, unsigned int threads = 1) {
+  const lf::assemble::DofHandler &dh_lfe{fes_lin_p->LocGlobMap()};
+  LF_ASSERT_MSG(dh_lfe.NumDofs() == mu.size(), "Vector length mismatch");
+  std::shared_ptr<const lf::mesh::Mesh> mesh_p{dh_lfe.Mesh()};
+  const lf::mesh::Mesh &mesh{*mesh_p};
+  const lf::base::size_type n_cells = mesh.NumEntities(0);
+  const lf::base::size_type n_edges = mesh.NumEntities(1);
+  constexpr lf::base::size_type kNone =
+      std::numeric_limits<lf::base::size_type>::max();
+
+  // Slots 3*k+l of the cells adjacent to an edge, filled sequentially
+  std::vector<std::array<lf::base::size_type, 2>> edge_slots(n_edges,
+                                                            {kNone, kNone});
+  for (const lf::mesh::Entity *cell : mesh.Entities(0)) {
+    LF_VERIFY_MSG(cell->RefEl() == lf::base::RefEl::kTria(),
+                  "Only implemented for triangular cells");
+    const lf::base::size_type k = mesh.Index(*cell);
+    auto edges = cell->SubEntities(1);
+    for (int l = 0; l < 3; ++l) {
+      std::array<lf::base::size_type, 2> &slots =
+          edge_slots[mesh.Index(*edges[l])];
+      slots[slots[0] == kNone ? 0 : 1] = 3 * k + l;
+    }
+  }
+
+  LocalHierSurplus result;
+  result.coeffs = Eigen::VectorXd::Zero(n_edges);
+  result.eta_sq = Eigen::VectorXd::Zero(n_edges);
+  // Contributions of cell k to its local edge l: residual and diagonal entry
+  std::vector<double> cell_res(3 * n_cells);
+  std::vector<double> cell_diag(3 * n_cells);
+  //====================
+  // Your code goes here
+  //====================
+  result.estimate = std::sqrt(result.eta_sq.sum());
+  return result;
+}
+/* SAM_LISTING_END_4 */
+
 std::tuple<double, double, double> solveAndEstimate(
     std::shared_ptr<const lf::mesh::Mesh> mesh_p);
 
@@ -7,11 +7,22 @@
  * @copyright Developed at ETH Zurich
  */
 
+#include "initcondlv.h"
+
 #include <Eigen/Core>
+#include <Eigen/LU>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cmath>
+#include <iomanip>
 #include <iostream>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "../../../lecturecodes/Ode45/ode45.h"
+#include "../../../lecturecodes/helperfiles/parallelchunks.h"
 
 namespace InitCondLV {
 
@@ -53,6 +64,134 @@ std::pair<Eigen::Vector2d, Eigen::Matrix2d> PhiAndW(double u0, double v0,
 }
 /* SAM_LISTING_END_1 */
 
+/* SAM_LISTING_BEGIN_3 */
+Eigen::Vector2d MultipleShooting(const Eigen::Vector2d &y, double T,
+                                 unsigned int segments, unsigned int threads,
+                                 double tol, unsigned int *iterations) {
+  const unsigned int m = std::max(1u, segments);
+  const double dt = T / m;
+  // Initial values s_j of the segments, matching residuals
+  // F_j = Phi(dt, s_j) - s_{j+1} (indices modulo m) and W_j = W(dt, s_j)
+  std::vector<Eigen::Vector2d> s(m), F(m);
+  std::vector<Eigen::Matrix2d> W(m);
+  auto shoot = [&](unsigned int j) {
+    std::pair<Eigen::Vector2d, Eigen::Matrix2d> PaW =
+        PhiAndW(s[j](0), s[j](1), dt);
+    F[j] = PaW.first;
+    W[j] = PaW.second;
+  };
+  auto match = [&]() {
+    for (unsigned int j = 0; j < m; ++j) F[j] -= s[(j + 1) % m];
+  };
+  // Start on the trajectory through y: F_j = 0 except for F_{m-1}
+  s[0] = y;
+  for (unsigned int j = 0; j < m; ++j) {
+    shoot(j);
+    if (j + 1 < m) s[j + 1] = F[j];
+  }
+  match();
+
+  auto norm = [&F]() {
+    double sum = 0.0;
+    for (const Eigen::Vector2d &Fj : F) sum += Fj.squaredNorm();
+    return std::sqrt(sum);
+  };
+  unsigned int iter = 0;
+  const unsigned int maxiter = 50;
+  while (norm() > tol && iter < maxiter) {
+    // The Newton system W_j ds_j - ds_{j+1} = -F_j gives
+    // ds_{j+1} = W_j ds_j + F_j, hence (I - W_{m-1}...W_0) ds_0 = r with
+    // r = F_{m-1} + W_{m-1}(F_{m-2} + W_{m-2}(... + W_1 F_0))
+    Eigen::Matrix2d M = Eigen::Matrix2d::Identity();
+    Eigen::Vector2d r = Eigen::Vector2d::Zero();
+    for (unsigned int j = 0; j < m; ++j) {
+      r = W[j] * r + F[j];
+      M = W[j] * M;
+    }
+    Eigen::Vector2d ds = (Eigen::Matrix2d::Identity() - M).lu().solve(r);
+    // Update the initial values in place by the same recursion
+    for (unsigned int j = 0; j < m; ++j) {
+      s[j] += ds;
+      ds = W[j] * ds + F[j];
+    }
+    parallelFor(m, threads, shoot);
+    match();
+    ++iter;
+  }
+  if (iterations) *iterations = iter;
+  return s[0];
+}
+/* SAM_LISTING_END_3 */
+
+std::vector<Eigen::Vector2d> MultipleShootingBatch(
+    const std::vector<Eigen::Vector2d> &guesses, double T, unsigned int threads,
+    unsigned int segments, double tol) {
+  std::vector<Eigen::Vector2d> y(guesses.size());
+  parallelFor(guesses.size(), threads, [&](std::size_t k) {
+    y[k] = MultipleShooting(guesses[k], T, segments, 1, tol);
+  });
+  return y;
+}
+
+/* SAM_LISTING_BEGIN_4 */
+void BenchmarkShooting() {
+  const double T = 5.0;
+  const Eigen::Vector2d y0(3, 2);
+  const unsigned int hw = std::max(1u, std::thread::hardware_concurrency());
+  auto time = [](auto &&f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+  };
+  // First integral of the Lotka-Volterra ODE, identifies the orbit
+  auto H = [](const Eigen::Vector2d &y) {
+    return y(0) - std::log(y(0)) + y(1) - 2.0 * std::log(y(1));
+  };
+  const Eigen::Vector2d ref(3.1098751029156, 2.08097564048345);
+
+  std::cout << "Multiple shooting, T = " << T << ", " << hw
+            << " hardware threads" << std::endl;
+  std::cout << std::setw(10) << "segments" << std::setw(10) << "threads"
+            << std::setw(8) << "iter" << std::setw(12) << "time [ms]"
+            << std::setw(14) << "|H - H_ref|" << std::setw(14) << "|y(T) - y|"
+            << std::endl;
+  for (unsigned int m : {1, 2, 4, 8}) {
+    for (unsigned int threads : {1u, m}) {
+      Eigen::Vector2d y;
+      unsigned int iter;
+      const double ms =
+          time([&] { y = MultipleShooting(y0, T, m, threads, 1e-10, &iter); });
+      const Eigen::Vector2d yT = PhiAndW(y(0), y(1), T).first;
+      std::cout << std::setw(10) << m << std::setw(10) << threads
+                << std::setw(8) << iter << std::setw(12) << ms << std::setw(14)
+                << std::abs(H(y) - H(ref)) << std::setw(14) << (yT - y).norm()
+                << std::endl;
+      if (m == 1) break;
+    }
+  }
+
+  // Batch of guesses on a grid around (3, 2)
+  std::vector<Eigen::Vector2d> guesses;
+  for (double u = 2.6; u < 3.5; u += 0.1) {
+    for (double v = 1.6; v < 2.5; v += 0.1) guesses.emplace_back(u, v);
+  }
+  std::cout << "Batch of " << guesses.size() << " initial guesses"
+            << std::endl;
+  std::cout << std::setw(10) << "threads" << std::setw(12) << "time [ms]"
+            << std::setw(10) << "speedup" << std::endl;
+  double ms1 = 0.0;
+  for (unsigned int threads : {1, 2, 4, 8}) {
+    std::vector<Eigen::Vector2d> y;
+    const double ms =
+        time([&] { y = MultipleShootingBatch(guesses, T, threads); });
+    if (threads == 1) ms1 = ms;
+    std::cout << std::setw(10) << threads << std::setw(12) << ms
+              << std::setw(10) << ms1 / ms << std::endl;
+  }
+}
+/* SAM_LISTING_END_4 */
+
 }  // namespace InitCondLV
 
 #endif  // #define InitCondLV_CC_
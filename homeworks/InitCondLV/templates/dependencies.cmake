@@ -10,4 +10,5 @@ set(SOURCES
 
 set(LIBRARIES
   Eigen3::Eigen
+  Threads::Threads
 )
@@ -45,5 +45,7 @@ int main() {
   }
 
   /* SAM_LISTING_END_2 */
+
+  InitCondLV::BenchmarkShooting();
   return 0;
 }
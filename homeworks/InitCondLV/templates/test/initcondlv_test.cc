@@ -11,7 +11,9 @@
 #include <gtest/gtest.h>
 
 #include <Eigen/Core>
+#include <cmath>
 #include <utility>
+#include <vector>
 
 namespace InitCondLV::test {
 
@@ -37,4 +39,34 @@ TEST(InitCondLV, PhiAndW) {
   ASSERT_NEAR(0.0, error, tol);
 }
 
+TEST(InitCondLV, MultipleShooting) {
+  double T = 5.0;
+  Eigen::Vector2d y0(3, 2);
+  // First integral of the Lotka-Volterra ODE
+  auto H = [](const Eigen::Vector2d &y) {
+    return y(0) - std::log(y(0)) + y(1) - 2.0 * std::log(y(1));
+  };
+  Eigen::Vector2d reference(3.1098751029156, 2.08097564048345);
+
+  double tol = 1.0e-8;
+  for (unsigned int segments : {1, 4}) {
+    Eigen::Vector2d y = MultipleShooting(y0, T, segments, 2);
+    // T-periodic and on the same orbit as the reference solution
+    Eigen::Vector2d yT = PhiAndW(y(0), y(1), T).first;
+    ASSERT_NEAR(0.0, (yT - y).lpNorm<Eigen::Infinity>(), tol);
+    ASSERT_NEAR(H(reference), H(y), tol);
+  }
+}
+
+TEST(InitCondLV, MultipleShootingBatch) {
+  double T = 5.0;
+  std::vector<Eigen::Vector2d> guesses = {{3, 2}, {2.8, 1.9}, {3.2, 2.2}};
+  std::vector<Eigen::Vector2d> y = MultipleShootingBatch(guesses, T, 3);
+  ASSERT_EQ(y.size(), guesses.size());
+  for (std::size_t k = 0; k < guesses.size(); ++k) {
+    Eigen::Vector2d yk = MultipleShooting(guesses[k], T);
+    ASSERT_NEAR(0.0, (y[k] - yk).lpNorm<Eigen::Infinity>(), 1.0e-14);
+  }
+}
+
 }  // namespace InitCondLV::test
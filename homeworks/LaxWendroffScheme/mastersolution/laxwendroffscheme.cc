@@ -213,6 +213,70 @@ Eigen::VectorXd solveGodunov(const Eigen::VectorXd &u0, double T,
 
 /* SAM_LISTING_END_7 */
 
+void LaxWendroffStep(const Eigen::VectorXd &mu, double gamma,
+                     Eigen::ArrayXd &expmu, Eigen::VectorXd &mu_next) {
+  const int N = mu.size();
+  const Eigen::ArrayXd &E = expmu;
+  const auto m = mu.array();
+  auto r = mu_next.array();
+  const double g1 = 0.5 * gamma;
+  const double g2 = 0.5 * Square(gamma);
+  // The only evaluation of exp() in this step, vectorized
+  expmu = m.exp();
+
+  // Interior cells: f(mu(j)) = E(j) and f'(0.5 * (mu(j) + mu(j+1)))^2 =
+  // E(j) * E(j+1)
+  const int n = N - 2;
+  r.segment(1, n) =
+      m.segment(1, n) - g1 * (E.tail(n) - E.head(n)) +
+      g2 * E.segment(1, n) *
+          (E.tail(n) * (m.tail(n) - m.segment(1, n)) -
+           E.head(n) * (m.segment(1, n) - m.head(n)));
+
+  // mu is extended by mu(0) to the left and by mu(N-1) to the right
+  r(0) = m(0) - g1 * (E(1) - E(0)) + g2 * E(0) * E(1) * (m(1) - m(0));
+  r(N - 1) = m(N - 1) - g1 * (E(N - 1) - E(N - 2)) -
+             g2 * E(N - 2) * E(N - 1) * (m(N - 1) - m(N - 2));
+}
+
+void GodunovStep(const Eigen::VectorXd &mu, double gamma,
+                 Eigen::ArrayXd &expmu, Eigen::VectorXd &mu_next) {
+  const int N = mu.size();
+  expmu = mu.array().exp();
+  // Upwind flux F(v, w) = exp(v), first cell is kept fixed
+  mu_next(0) = mu(0);
+  mu_next.tail(N - 1).array() =
+      mu.tail(N - 1).array() - gamma * (expmu.tail(N - 1) - expmu.head(N - 1));
+}
+
+Eigen::VectorXd solveLaxWendroffInPlace(const Eigen::VectorXd &u0, double T,
+                                        unsigned int M) {
+  const double gamma = 1.0 / Constant::e;
+  // Two state buffers, which swap their roles (no copying) in each step
+  Eigen::VectorXd mu = u0;
+  Eigen::VectorXd mu_next(u0.size());
+  Eigen::ArrayXd expmu(u0.size());
+  for (unsigned int k = 0; k < M; ++k) {
+    LaxWendroffStep(mu, gamma, expmu, mu_next);
+    mu.swap(mu_next);
+  }
+  return mu;
+}
+
+Eigen::VectorXd solveGodunovInPlace(const Eigen::VectorXd &u0, double T,
+                                    unsigned int M) {
+  const double tau = T / M;
+  const double h = Constant::e * tau;
+  Eigen::VectorXd mu = u0;
+  Eigen::VectorXd mu_next(u0.size());
+  Eigen::ArrayXd expmu(u0.size());
+  for (unsigned int k = 0; k < M; ++k) {
+    GodunovStep(mu, tau / h, expmu, mu_next);
+    mu.swap(mu_next);
+  }
+  return mu;
+}
+
 /* SAM_LISTING_BEGIN_8 */
 Eigen::VectorXd numexpGodunovSmoothU0(const Eigen::VectorXi &M) {
   const double T = 1.0;
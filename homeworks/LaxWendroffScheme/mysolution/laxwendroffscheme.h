@@ -69,6 +69,44 @@ Eigen::VectorXd numexpLaxWendroffSmoothU0(const Eigen::VectorXi &M);
 Eigen::VectorXd solveGodunov(const Eigen::VectorXd &u0, double T,
                              unsigned int M);
 
+/**
+ * @brief One step of the Lax-Wendroff scheme for f() = exp() without memory
+ * allocation. Since f'(u)^2 = exp(2u), the squared derivatives at the
+ * midpoints are exp(mu(j)) * exp(mu(j+1)), so only one exponential per cell
+ * has to be computed.
+ * @param mu mu^(k-1) (i.e. mu at timestep k-1)
+ * @param gamma tau / h, where tau = timestep size and h = spatial meshwidth
+ * @param expmu workspace of same size as mu, returns exp(mu)
+ * @param mu_next returns mu^(k), same size as mu, must not alias mu
+ */
+void LaxWendroffStep(const Eigen::VectorXd &mu, double gamma,
+                     Eigen::ArrayXd &expmu, Eigen::VectorXd &mu_next);
+
+/**
+ * @brief One step of the Godunov scheme for f() = exp() (upwind flux, explicit
+ * Euler) without memory allocation, one exponential per cell.
+ * @param mu mu^(k-1) (i.e. mu at timestep k-1)
+ * @param gamma tau / h, where tau = timestep size and h = spatial meshwidth
+ * @param expmu workspace of same size as mu, returns exp(mu)
+ * @param mu_next returns mu^(k), same size as mu, must not alias mu
+ */
+void GodunovStep(const Eigen::VectorXd &mu, double gamma,
+                 Eigen::ArrayXd &expmu, Eigen::VectorXd &mu_next);
+
+/**
+ * @brief Same as solveLaxWendroff(...), but timestepping with
+ * LaxWendroffStep(...) alternating between two preallocated buffers.
+ */
+Eigen::VectorXd solveLaxWendroffInPlace(const Eigen::VectorXd &u0, double T,
+                                        unsigned int M);
+
+/**
+ * @brief Same as solveGodunov(...), but timestepping with GodunovStep(...)
+ * alternating between two preallocated buffers.
+ */
+Eigen::VectorXd solveGodunovInPlace(const Eigen::VectorXd &u0, double T,
+                                    unsigned int M);
+
 /**
  * @brief Same as numexpLaxWendroffSmoothU0(...), but with solveGodunov(...)
  * instead of solveLaxWendroff(...).
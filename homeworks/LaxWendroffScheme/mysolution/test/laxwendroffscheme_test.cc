@@ -158,4 +158,22 @@ TEST(LaxWendroffScheme, numexpGodunovSmoothU0) {
   EXPECT_NEAR(max_diff, 0.0, tol);
 }
 
+TEST(LaxWendroffScheme, solveInPlace) {
+  double T = 1.0;
+  unsigned int M = 80;
+  Eigen::VectorXd x = getXValues(T, M);
+  auto u_initial = [](double x) { return x >= 0 ? 1.0 : 0.0; };
+  Eigen::VectorXd u0 = x.unaryExpr(u_initial);
+
+  // double-buffered versions have to agree with the reference implementations
+  double tol = 1.0e-12;
+  Eigen::VectorXd u_lw = solveLaxWendroff(u0, T, M);
+  Eigen::VectorXd u_lwip = solveLaxWendroffInPlace(u0, T, M);
+  EXPECT_NEAR((u_lw - u_lwip).lpNorm<Eigen::Infinity>(), 0.0, tol);
+
+  Eigen::VectorXd u_god = solveGodunov(u0, T, M);
+  Eigen::VectorXd u_godip = solveGodunovInPlace(u0, T, M);
+  EXPECT_NEAR((u_god - u_godip).lpNorm<Eigen::Infinity>(), 0.0, tol);
+}
+
 }  // namespace LaxWendroffScheme::test
@@ -6,6 +6,8 @@ set(SOURCES
   ${DIR}/linfereactdiff_main.cc
   ${DIR}/linfereactdiff.h
   ${DIR}/linfereactdiff.cc
+  ${DIR}/multigrid.h
+  ${DIR}/multigrid.cc
 )
 
 set(LIBRARIES
@@ -17,4 +19,5 @@ set(LIBRARIES
   LF::lf.mesh.utils
   LF::lf.refinement
   LF::lf.uscalfe
+  Threads::Threads
 )
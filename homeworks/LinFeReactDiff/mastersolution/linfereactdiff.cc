@@ -44,12 +44,13 @@ std::shared_ptr<lf::refinement::MeshHierarchy> generateMeshHierarchy(
 }
 
 /**
- * @brief solve the linear variational problem
+ * @brief assemble the linear variational problem
  *        int_{\Omgea} grad(u)grad(v) dx = \int_{\Omgea} cv dx for all v
  *        with 0 Dirichlet boundary condition.
- * @param mesh: mesh discretization of computational Domain \Omega
+ * @param fe_space: linear Lagrangian finite elements on a mesh of \Omega
  */
-Eigen::VectorXd solveFE(std::shared_ptr<const lf::mesh::Mesh> mesh) {
+std::pair<Eigen::SparseMatrix<double>, Eigen::VectorXd> assembleFE(
+    std::shared_ptr<const lf::uscalfe::FeSpaceLagrangeO1<double>> fe_space) {
   // Initialize mesh functions for solving the BVP:
   // \int_{\Omega} grad(u)grad(v) + uv dx = \_int(\Omega}cv dx
   // with Dirichlet boundary conditions fixed to 0.
@@ -65,8 +66,6 @@ Eigen::VectorXd solveFE(std::shared_ptr<const lf::mesh::Mesh> mesh) {
   auto c = [](Eigen::Vector2d x) -> double { return x[0] * x[1]; };
   lf::mesh::utils::MeshFunctionGlobal mf_c{c};
 
-  auto fe_space =
-      std::make_shared<lf::uscalfe::FeSpaceLagrangeO1<double>>(mesh);
   const lf::mesh::Mesh &mesh_p{*(fe_space->Mesh())};
 
   // Initialize dof handler
@@ -114,9 +113,22 @@ Eigen::VectorXd solveFE(std::shared_ptr<const lf::mesh::Mesh> mesh) {
       },
       A, phi);
 
+  return {A.makeSparse(), phi};
+}
+
+/**
+ * @brief solve the linear variational problem
+ *        int_{\Omgea} grad(u)grad(v) dx = \int_{\Omgea} cv dx for all v
+ *        with 0 Dirichlet boundary condition.
+ * @param mesh: mesh discretization of computational Domain \Omega
+ */
+Eigen::VectorXd solveFE(std::shared_ptr<const lf::mesh::Mesh> mesh) {
+  auto fe_space =
+      std::make_shared<lf::uscalfe::FeSpaceLagrangeO1<double>>(mesh);
+  auto [A_crs, phi] = assembleFE(fe_space);
+
   // Solve System
   Eigen::VectorXd mu;
-  Eigen::SparseMatrix<double> A_crs = A.makeSparse();
   Eigen::SparseLU<Eigen::SparseMatrix<double>> solver;
   solver.compute(A_crs);
   mu = solver.solve(phi);
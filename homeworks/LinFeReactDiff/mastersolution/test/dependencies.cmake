@@ -15,4 +15,5 @@ set(LIBRARIES
   LF::lf.mesh
   LF::lf.mesh.hybrid2d
   LF::lf.mesh.utils
+  LF::lf.refinement
 )
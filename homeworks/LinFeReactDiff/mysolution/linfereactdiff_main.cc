@@ -8,30 +8,61 @@
 #include <lf/refinement/refinement.h>
 
 #include <Eigen/Core>
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <iostream>
 #include <memory>
+#include <vector>
 
+#include "../../../lecturecodes/helperfiles/convergencestudy.h"
 #include "linfereactdiff.h"
+#include "multigrid.h"
 
 int main() {
   const lf::base::size_type num_levels = 5;
-  std::shared_ptr<lf::refinement::MeshHierarchy> multi_mesh_p =
+  // The hierarchy is only read once it is built, so that its levels can be
+  // treated concurrently
+  std::shared_ptr<const lf::refinement::MeshHierarchy> multi_mesh_p =
       LinFeReactDiff::generateMeshHierarchy(num_levels);
-  lf::refinement::MeshHierarchy &multi_mesh{*multi_mesh_p};
-  // get pointer to finest mesh used as ground truth
-  std::shared_ptr<const lf::mesh::Mesh> mesh_p =
-      multi_mesh.getMesh(num_levels - 1);
-  Eigen::VectorXd finest_sol = LinFeReactDiff::solveFE(mesh_p);
-  double ground_truth_energy =
-      LinFeReactDiff::computeEnergy(mesh_p, finest_sol);
+  const lf::refinement::MeshHierarchy &multi_mesh{*multi_mesh_p};
+  // The levels are identified by their number of cells
+  std::vector<int> Ns(num_levels);
+  for (lf::base::size_type level = 0; level < num_levels; ++level) {
+    Ns[level] = static_cast<int>(multi_mesh.getMesh(level)->NumEntities(0));
+  }
+
+  // Energy of the solution on one level. Multigrid-preconditioned CG,
+  // SparseLU would run out of memory on fine meshes
+  auto solveLevel = [&](int N, ConvergenceStudy::PhaseTimer &timer) {
+    const auto level = static_cast<lf::base::size_type>(
+        std::find(Ns.begin(), Ns.end(), N) - Ns.begin());
+    const Eigen::VectorXd sol = LinFeReactDiff::solveFEMultigrid(
+        multi_mesh, level, 1.0E-10, nullptr, &timer);
+    const double energy =
+        LinFeReactDiff::computeEnergy(multi_mesh.getMesh(level), sol);
+    timer.lap(ConvergenceStudy::kError);
+    return Eigen::VectorXd::Constant(1, energy);
+  };
+  // Galerkin matrices of all coarser levels and a few vectors, roughly 1 kB
+  // per cell
+  auto memory = [](int N) -> std::size_t {
+    return std::size_t{1024} * static_cast<std::size_t>(N);
+  };
+  std::vector<ConvergenceStudy::Level> levels =
+      ConvergenceStudy::run(Ns, solveLevel, memory);
 
-  // compute error for the other meshes
-  for (int i = 0; i < num_levels - 1; i++) {
-    mesh_p = multi_mesh.getMesh(i);
-    Eigen::VectorXd sol = LinFeReactDiff::solveFE(mesh_p);
-    double energy = LinFeReactDiff::computeEnergy(mesh_p, sol);
-    std::cout << "Mesh " << i + 1
-              << " error: " << std::abs(energy - ground_truth_energy) << "\n";
+  // The finest mesh is used as ground truth, compute the error for the other
+  // meshes
+  const double ground_truth_energy = levels.back().errors[0];
+  levels.pop_back();
+  for (std::size_t i = 0; i < levels.size(); ++i) {
+    levels[i].errors[0] = std::abs(levels[i].errors[0] - ground_truth_energy);
+    std::cout << "Mesh " << i + 1 << " error: " << levels[i].errors[0] << "\n";
   }
+  ConvergenceStudy::write(CURRENT_BINARY_DIR "/energy_errors.csv", {"energy"},
+                          levels);
+
+  // Iterations and memory of the multigrid solver compared to SparseLU
+  LinFeReactDiff::compareSolvers(multi_mesh);
 }
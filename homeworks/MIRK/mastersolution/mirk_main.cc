@@ -10,6 +10,7 @@
 #include <iostream>
 
 #include "mirk.h"
+#include "mirkbvp.h"
 
 /* SAM_LISTING_BEGIN_0 */
 int main() {
@@ -39,6 +40,9 @@ int main() {
     // Print table
     std::cout << M << "\t" << yend << "\t" << err << std::endl;
   }
+
+  // Global MIRK collocation for boundary value problems
+  MIRK::BenchmarkMIRKBVP();
   return 0;
 }
 /* SAM_LISTING_END_0 */
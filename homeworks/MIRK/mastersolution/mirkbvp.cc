@@ -0,0 +1,196 @@
+/**
+ * @file mirkbvp.cc
+ * @brief NPDE homework MIRK code
+ * @copyright Developed at ETH Zurich
+ */
+
+#include "mirkbvp.h"
+
+#include <Eigen/Core>
+#include <Eigen/LU>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+
+namespace MIRK {
+
+Eigen::MatrixXd ShootingBVPSolve(
+    const std::function<Eigen::VectorXd(double, const Eigen::VectorXd &)> &f,
+    const std::function<Eigen::MatrixXd(double, const Eigen::VectorXd &)> &df,
+    const std::function<Eigen::VectorXd(const Eigen::VectorXd &,
+                                        const Eigen::VectorXd &)> &g,
+    const std::function<std::pair<Eigen::MatrixXd, Eigen::MatrixXd>(
+        const Eigen::VectorXd &, const Eigen::VectorXd &)> &dg,
+    double a, double b, const Eigen::VectorXd &s0, unsigned int M,
+    double newton_tol, unsigned int max_newton) {
+  const Eigen::Index n = s0.size();
+  const double h = (b - a) / M;
+  Eigen::MatrixXd Y(n, M + 1);
+  Eigen::MatrixXd Z;
+  // Classical Runge-Kutta method for y' = f(t, y), Z' = df(t, y) Z with
+  // y(a) = s, Z(a) = I, storing the grid values in Y
+  auto integrate = [&](const Eigen::VectorXd &s) {
+    Y.col(0) = s;
+    Z = Eigen::MatrixXd::Identity(n, n);
+    for (unsigned int k = 0; k < M; ++k) {
+      const double t = a + k * h;
+      const Eigen::VectorXd y = Y.col(k);
+      const Eigen::VectorXd k1 = f(t, y);
+      const Eigen::MatrixXd K1 = df(t, y) * Z;
+      const Eigen::VectorXd y2 = y + 0.5 * h * k1;
+      const Eigen::VectorXd k2 = f(t + 0.5 * h, y2);
+      const Eigen::MatrixXd K2 = df(t + 0.5 * h, y2) * (Z + 0.5 * h * K1);
+      const Eigen::VectorXd y3 = y + 0.5 * h * k2;
+      const Eigen::VectorXd k3 = f(t + 0.5 * h, y3);
+      const Eigen::MatrixXd K3 = df(t + 0.5 * h, y3) * (Z + 0.5 * h * K2);
+      const Eigen::VectorXd y4 = y + h * k3;
+      const Eigen::VectorXd k4 = f(t + h, y4);
+      const Eigen::MatrixXd K4 = df(t + h, y4) * (Z + h * K3);
+      Y.col(k + 1) = y + h / 6.0 * (k1 + 2 * k2 + 2 * k3 + k4);
+      Z += h / 6.0 * (K1 + 2 * K2 + 2 * K3 + K4);
+    }
+  };
+
+  Eigen::VectorXd s = s0;
+  for (unsigned int iter = 0; iter < max_newton; ++iter) {
+    integrate(s);
+    // G(s) = g(s, y(b; s)), DG(s) = dg/dya + dg/dyb Z(b)
+    const Eigen::VectorXd G = g(s, Y.col(M));
+    const auto [Ba, Bb] = dg(s, Y.col(M));
+    const Eigen::VectorXd ds = (Ba + Bb * Z).lu().solve(G);
+    s -= ds;
+    if (ds.lpNorm<Eigen::Infinity>() <=
+        newton_tol * (1.0 + s.lpNorm<Eigen::Infinity>())) {
+      break;
+    }
+  }
+  integrate(s);
+  return Y;
+}
+
+/* SAM_LISTING_BEGIN_6 */
+void BenchmarkMIRKBVP() {
+  auto time = [](auto &&F) {
+    auto start = std::chrono::high_resolution_clock::now();
+    F();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+  };
+  // Dirichlet conditions y_1(0) = alpha, y_1(1) = beta for n = 2
+  auto dirichlet = [](double alpha, double beta) {
+    return [alpha, beta](const Eigen::VectorXd &ya, const Eigen::VectorXd &yb) {
+      return Eigen::VectorXd(Eigen::Vector2d(ya(0) - alpha, yb(0) - beta));
+    };
+  };
+  auto ddirichlet = [](const Eigen::VectorXd &, const Eigen::VectorXd &) {
+    Eigen::MatrixXd Ba = Eigen::MatrixXd::Zero(2, 2);
+    Eigen::MatrixXd Bb = Eigen::MatrixXd::Zero(2, 2);
+    Ba(0, 0) = 1.0;
+    Bb(1, 0) = 1.0;
+    return std::make_pair(Ba, Bb);
+  };
+  // Maximum error of the first component on a mesh
+  auto error = [](const Eigen::VectorXd &t, const Eigen::MatrixXd &Y,
+                  auto &&yex) {
+    double err = 0.0;
+    for (Eigen::Index k = 0; k < t.size(); ++k) {
+      err = std::max(err, std::abs(Y(0, k) - yex(t(k))));
+    }
+    return err;
+  };
+
+  // Bratu problem y'' = -exp(y), y(0) = y(1) = 0, lower solution
+  auto fB = [](double, const Eigen::VectorXd &y) {
+    return Eigen::VectorXd(Eigen::Vector2d(y(1), -std::exp(y(0))));
+  };
+  auto dfB = [](double, const Eigen::VectorXd &y) {
+    Eigen::MatrixXd J(2, 2);
+    J << 0.0, 1.0, -std::exp(y(0)), 0.0;
+    return J;
+  };
+  // y(x) = -2 log(cosh((x - 1/2) theta / 2) / cosh(theta / 4)) with
+  // theta = sqrt(2) cosh(theta / 4)
+  double theta = 1.0;
+  for (int i = 0; i < 50; ++i) theta = std::sqrt(2.0) * std::cosh(theta / 4);
+  auto yB = [theta](double x) {
+    return -2.0 * std::log(std::cosh((x - 0.5) * theta / 2) /
+                           std::cosh(theta / 4));
+  };
+
+  std::cout << "Bratu problem: MIRK collocation vs. shooting (RK4)"
+            << std::endl;
+  std::cout << std::setw(8) << "M" << std::setw(8) << "Newton" << std::setw(12)
+            << "MIRK [ms]" << std::setw(14) << "MIRK error" << std::setw(12)
+            << "shoot [ms]" << std::setw(14) << "shoot error" << std::endl;
+  for (unsigned int M = 100; M <= 100000; M *= 10) {
+    const Eigen::VectorXd t = Eigen::VectorXd::LinSpaced(M + 1, 0.0, 1.0);
+    Eigen::MatrixXd Y = Eigen::MatrixXd::Zero(2, M + 1);
+    unsigned int iter;
+    const double ms_mirk = time([&] {
+      iter = MIRKCollocation(fB, dfB, dirichlet(0, 0), ddirichlet, t, Y);
+    });
+    Eigen::MatrixXd Ys;
+    const double ms_shoot = time([&] {
+      Ys = ShootingBVPSolve(fB, dfB, dirichlet(0, 0), ddirichlet, 0.0, 1.0,
+                            Eigen::Vector2d(0, 0), M);
+    });
+    std::cout << std::setw(8) << M << std::setw(8) << iter << std::setw(12)
+              << ms_mirk << std::setw(14) << error(t, Y, yB) << std::setw(12)
+              << ms_shoot << std::setw(14) << error(t, Ys, yB) << std::endl;
+  }
+
+  // Linear problem y'' = mu^2 y, y(0) = 1, y(1) = 0 with boundary layer at 0
+  const double mu = 50.0;
+  auto fL = [mu](double, const Eigen::VectorXd &y) {
+    return Eigen::VectorXd(Eigen::Vector2d(y(1), mu * mu * y(0)));
+  };
+  auto dfL = [mu](double, const Eigen::VectorXd &) {
+    Eigen::MatrixXd J(2, 2);
+    J << 0.0, 1.0, mu * mu, 0.0;
+    return J;
+  };
+  // sinh(mu(1-x))/sinh(mu), written without overflow
+  auto yL = [mu](double x) {
+    return std::exp(-mu * x) * (1.0 - std::exp(-2.0 * mu * (1.0 - x))) /
+           (1.0 - std::exp(-2.0 * mu));
+  };
+
+  std::cout << "Boundary layer y'' = mu^2 y, mu = " << mu << std::endl;
+  std::cout << std::setw(8) << "M" << std::setw(14) << "MIRK error"
+            << std::setw(14) << "shoot error" << std::endl;
+  for (unsigned int M = 1000; M <= 100000; M *= 10) {
+    const Eigen::VectorXd t = Eigen::VectorXd::LinSpaced(M + 1, 0.0, 1.0);
+    Eigen::MatrixXd Y = Eigen::MatrixXd::Zero(2, M + 1);
+    MIRKCollocation(fL, dfL, dirichlet(1, 0), ddirichlet, t, Y);
+    const Eigen::MatrixXd Ys = ShootingBVPSolve(
+        fL, dfL, dirichlet(1, 0), ddirichlet, 0.0, 1.0, Eigen::Vector2d(1, 0),
+        M);
+    std::cout << std::setw(8) << M << std::setw(14) << error(t, Y, yL)
+              << std::setw(14) << error(t, Ys, yL) << std::endl;
+  }
+
+  std::cout << "Adaptive MIRK collocation, starting from M = 10" << std::endl;
+  std::cout << std::setw(8) << "tol" << std::setw(8) << "M" << std::setw(8)
+            << "meshes" << std::setw(8) << "Newton" << std::setw(12)
+            << "time [ms]" << std::setw(14) << "error" << std::endl;
+  for (double tol : {1e-4, 1e-6, 1e-8}) {
+    Eigen::VectorXd t = Eigen::VectorXd::LinSpaced(11, 0.0, 1.0);
+    Eigen::MatrixXd Y = Eigen::MatrixXd::Zero(2, 11);
+    MIRKBVPOptions options;
+    options.tol = tol;
+    MIRKBVPStatistics stats;
+    const double ms = time([&] {
+      stats = MIRKBVPSolve(fL, dfL, dirichlet(1, 0), ddirichlet, t, Y,
+                           options);
+    });
+    std::cout << std::setw(8) << tol << std::setw(8) << t.size() - 1
+              << std::setw(8) << stats.meshes << std::setw(8)
+              << stats.newton_iterations << std::setw(12) << ms
+              << std::setw(14) << error(t, Y, yL) << std::endl;
+  }
+}
+/* SAM_LISTING_END_6 */
+
+}  // namespace MIRK
@@ -5,6 +5,8 @@
 set(SOURCES
   ${DIR}/test/mirk_test.cc
   ${DIR}/mirk.h
+  ${DIR}/mirkbvp.h
+  ${DIR}/mirkbvp.cc
 )
 
 set(LIBRARIES
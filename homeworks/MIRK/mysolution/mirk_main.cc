@@ -10,6 +10,7 @@
 #include <iostream>
 
 #include "mirk.h"
+#include "mirkbvp.h"
 
 /* SAM_LISTING_BEGIN_0 */
 int main() {
@@ -29,6 +30,9 @@ int main() {
   // Your code goes here
   // TODO: problem h: solve IVP y' = f(y) up to T
   //====================
+
+  // Global MIRK collocation for boundary value problems
+  MIRK::BenchmarkMIRKBVP();
   return 0;
 }
 /* SAM_LISTING_END_0 */
@@ -0,0 +1,265 @@
+#ifndef MIRKBVP_H_
+#define MIRKBVP_H_
+
+/**
+ * @file mirkbvp.h
+ * @brief NPDE homework MIRK code
+ * @copyright Developed at ETH Zurich
+ */
+
+#include <Eigen/Core>
+#include <Eigen/SparseCore>
+#include <Eigen/SparseLU>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace MIRK {
+
+/** Global collocation with the MIRK scheme of mirk.h for two-point boundary
+ * value problems
+ *   y' = f(t, y) on [a, b],  g(y(a), y(b)) = 0,
+ * with states y in R^n. On a mesh a = t_0 < ... < t_M = b all grid values
+ * y_0, ..., y_M are unknowns. They have to satisfy g and the M interval
+ * equations Phi_k(y_k, y_{k+1}) = 0 of the (mono-implicit) scheme. The
+ * Jacobian of this system is almost block diagonal: every block row couples
+ * only y_k and y_{k+1}, apart from the n rows of g. It is assembled as a
+ * sparse matrix and factorized by Eigen::SparseLU, so a Newton step costs
+ * O(M n^3) instead of O((Mn)^3).
+ *
+ * Callables: f(t, y) and df(t, y) return f and its Jacobian w.r.t. y,
+ * g(ya, yb) returns the boundary residual in R^n and dg(ya, yb) returns the
+ * pair of Jacobians (dg/dya, dg/dyb).
+ *
+ * The grid values are stored as columns of an n x (M+1) matrix Y.
+ */
+
+/** Options and statistics of MIRKBVPSolve() */
+struct MIRKBVPOptions {
+  double tol = 1e-6;                     // tolerance for the defect estimates
+  double newton_tol = 1e-10;             // relative size of the Newton update
+  unsigned int max_newton = 20;          // Newton iterations per mesh
+  unsigned int max_intervals = 1000000;  // refinement stops beyond this
+};
+struct MIRKBVPStatistics {
+  unsigned int meshes = 0;             // meshes on which Newton was run
+  unsigned int newton_iterations = 0;  // total over all meshes
+  bool converged = false;              // Newton and defect below tolerance
+};
+
+/** Residual Phi_k and its Jacobian blocks L = dPhi_k/dy_k and
+ * R = dPhi_k/dy_{k+1} on the interval [t, t+h] */
+/* SAM_LISTING_BEGIN_3 */
+template <class Func, class Jac>
+void MIRKIntervalResidual(Func &&f, Jac &&df, double t, double h,
+                          const Eigen::VectorXd &yk, const Eigen::VectorXd &yk1,
+                          Eigen::VectorXd &Phi, Eigen::MatrixXd &L,
+                          Eigen::MatrixXd &R) {
+  // Coefficients of MIRK, nodes c_i = v_i + sum_j d_ij
+  const double v2 = 344.0 / 2025.0;
+  const double d21 = -164.0 / 2025.0;
+  const double b1 = 37.0 / 82.0;
+  const double b2 = 45.0 / 82.0;
+  const double c2 = v2 + d21;
+  const Eigen::Index n = yk.size();
+  const Eigen::MatrixXd I = Eigen::MatrixXd::Identity(n, n);
+
+  //====================
+  // Your code goes here
+  //====================
+  Phi = yk1 - yk;
+  L = -I;
+  R = I;
+}
+/* SAM_LISTING_END_3 */
+
+/** Newton's method for the collocation system on the fixed mesh t, starting
+ * from and overwriting Y. Returns the number of iterations, or max_newton + 1
+ * if the iteration did not converge. */
+/* SAM_LISTING_BEGIN_4 */
+template <class Func, class Jac, class BC, class BCJac>
+unsigned int MIRKCollocation(Func &&f, Jac &&df, BC &&g, BCJac &&dg,
+                             const Eigen::VectorXd &t, Eigen::MatrixXd &Y,
+                             double newton_tol = 1e-10,
+                             unsigned int max_newton = 20) {
+  const Eigen::Index n = Y.rows();
+  const Eigen::Index M = t.size() - 1;
+  const Eigen::Index N = n * (M + 1);
+
+  // Residual of the collocation system: rows 0..n-1 for g, then block k+1
+  // for interval k. The Jacobian triplets are only collected if requested.
+  Eigen::VectorXd Phi;
+  Eigen::MatrixXd L, R;
+  std::vector<Eigen::Triplet<double>> triplets;
+  auto addBlock = [&triplets](Eigen::Index row, Eigen::Index col,
+                              const Eigen::MatrixXd &B) {
+    for (Eigen::Index j = 0; j < B.cols(); ++j) {
+      for (Eigen::Index i = 0; i < B.rows(); ++i) {
+        if (B(i, j) != 0.0) triplets.emplace_back(row + i, col + j, B(i, j));
+      }
+    }
+  };
+  auto residual = [&](const Eigen::MatrixXd &Z, bool jacobian) {
+    Eigen::VectorXd F(N);
+    if (jacobian) {
+      triplets.clear();
+      triplets.reserve(3 * n * n * (M + 1));
+    }
+    F.head(n) = g(Z.col(0), Z.col(M));
+    if (jacobian) {
+      const auto [Ba, Bb] = dg(Z.col(0), Z.col(M));
+      addBlock(0, 0, Ba);
+      addBlock(0, n * M, Bb);
+    }
+    for (Eigen::Index k = 0; k < M; ++k) {
+      MIRKIntervalResidual(f, df, t(k), t(k + 1) - t(k), Z.col(k),
+                           Z.col(k + 1), Phi, L, R);
+      F.segment(n * (k + 1), n) = Phi;
+      if (jacobian) {
+        addBlock(n * (k + 1), n * k, L);
+        addBlock(n * (k + 1), n * (k + 1), R);
+      }
+    }
+    return F;
+  };
+
+  Eigen::SparseMatrix<double> J(N, N);
+  Eigen::SparseLU<Eigen::SparseMatrix<double>> solver;
+  Eigen::VectorXd F = residual(Y, true);
+  for (unsigned int iter = 1; iter <= max_newton; ++iter) {
+    J.setFromTriplets(triplets.begin(), triplets.end());
+    // The sparsity pattern does not change on a fixed mesh
+    if (iter == 1) solver.analyzePattern(J);
+    solver.factorize(J);
+    if (solver.info() != Eigen::Success) break;
+    const Eigen::VectorXd dz = solver.solve(F);
+    const Eigen::Map<const Eigen::MatrixXd> dY(dz.data(), n, M + 1);
+    if (dY.lpNorm<Eigen::Infinity>() <=
+        newton_tol * (1.0 + Y.lpNorm<Eigen::Infinity>())) {
+      Y -= dY;
+      return iter;
+    }
+    // Damped Newton: halve the step until the residual decreases
+    double lambda = 1.0;
+    Eigen::MatrixXd Ynew = Y - dY;
+    Eigen::VectorXd Fnew = residual(Ynew, false);
+    while (Fnew.norm() > F.norm() && lambda > 1.0 / 64) {
+      lambda /= 2;
+      Ynew = Y - lambda * dY;
+      Fnew = residual(Ynew, false);
+    }
+    Y = std::move(Ynew);
+    F = residual(Y, true);
+  }
+  return max_newton + 1;
+}
+/* SAM_LISTING_END_4 */
+
+/** Defect estimates r_k = h_k max_theta |u'(t) - f(t, u(t))|_inf of the
+ * piecewise cubic Hermite interpolant u of (t_k, y_k, f(t_k, y_k)), sampled at
+ * t = t_k + theta h_k for theta = 1/4, 1/2, 3/4. */
+template <class Func>
+Eigen::VectorXd MIRKDefect(Func &&f, const Eigen::VectorXd &t,
+                           const Eigen::MatrixXd &Y) {
+  const Eigen::Index M = t.size() - 1;
+  Eigen::VectorXd r(M);
+  Eigen::VectorXd fk = f(t(0), Y.col(0));
+  for (Eigen::Index k = 0; k < M; ++k) {
+    const double h = t(k + 1) - t(k);
+    const Eigen::VectorXd fk1 = f(t(k + 1), Y.col(k + 1));
+    const Eigen::VectorXd dy = Y.col(k + 1) - Y.col(k);
+    double rk = 0.0;
+    for (double s : {0.25, 0.5, 0.75}) {
+      // Hermite basis functions and their derivatives
+      const double h00 = (1 + 2 * s) * (1 - s) * (1 - s);
+      const double h10 = s * (1 - s) * (1 - s);
+      const double h11 = -s * s * (1 - s);
+      const double d10 = (1 - s) * (1 - 3 * s);
+      const double d11 = s * (3 * s - 2);
+      const double dd = 6 * s * (1 - s);  // derivative of 1 - h00
+      const Eigen::VectorXd u = h00 * Y.col(k) + (1 - h00) * Y.col(k + 1) +
+                                h * (h10 * fk + h11 * fk1);
+      const Eigen::VectorXd du = dd / h * dy + d10 * fk + d11 * fk1;
+      const Eigen::VectorXd delta = du - f(t(k) + s * h, u);
+      rk = std::max(rk, delta.lpNorm<Eigen::Infinity>());
+    }
+    r(k) = h * rk;
+    fk = fk1;
+  }
+  return r;
+}
+
+/** Adaptive MIRK collocation: Newton on the current mesh, then bisection of
+ * all intervals whose defect estimate exceeds tol, with the Hermite
+ * interpolant at the new midpoints as initial guess. On entry t and Y hold the
+ * initial mesh and guess, on exit the final mesh and solution. */
+/* SAM_LISTING_BEGIN_5 */
+template <class Func, class Jac, class BC, class BCJac>
+MIRKBVPStatistics MIRKBVPSolve(Func &&f, Jac &&df, BC &&g, BCJac &&dg,
+                               Eigen::VectorXd &t, Eigen::MatrixXd &Y,
+                               const MIRKBVPOptions &options = {}) {
+  MIRKBVPStatistics stats;
+  const Eigen::Index n = Y.rows();
+  while (true) {
+    const unsigned int iter = MIRKCollocation(f, df, g, dg, t, Y,
+                                              options.newton_tol,
+                                              options.max_newton);
+    ++stats.meshes;
+    stats.newton_iterations += std::min(iter, options.max_newton);
+    if (iter > options.max_newton) return stats;
+
+    const Eigen::VectorXd r = MIRKDefect(f, t, Y);
+    const Eigen::Index M = t.size() - 1;
+    const Eigen::Index refine = (r.array() > options.tol).count();
+    if (refine == 0) {
+      stats.converged = true;
+      return stats;
+    }
+    if (M + refine > options.max_intervals) return stats;
+
+    // Bisect the intervals with large defect
+    Eigen::VectorXd t_new(M + refine + 1);
+    Eigen::MatrixXd Y_new(n, M + refine + 1);
+    Eigen::Index j = 0;
+    for (Eigen::Index k = 0; k < M; ++k) {
+      t_new(j) = t(k);
+      Y_new.col(j++) = Y.col(k);
+      if (r(k) > options.tol) {
+        const double h = t(k + 1) - t(k);
+        t_new(j) = t(k) + 0.5 * h;
+        Y_new.col(j++) = 0.5 * (Y.col(k) + Y.col(k + 1)) +
+                         0.125 * h * (f(t(k), Y.col(k)) -
+                                      f(t(k + 1), Y.col(k + 1)));
+      }
+    }
+    t_new(j) = t(M);
+    Y_new.col(j) = Y.col(M);
+    t = std::move(t_new);
+    Y = std::move(Y_new);
+  }
+}
+/* SAM_LISTING_END_5 */
+
+/** Simple shooting for the same boundary value problem: Newton's method for
+ * the initial value s = y(a), where y(b) and its sensitivity dy(b)/ds come
+ * from M equidistant steps of the classical Runge-Kutta method applied to the
+ * variational equations. Returns the grid values. */
+Eigen::MatrixXd ShootingBVPSolve(
+    const std::function<Eigen::VectorXd(double, const Eigen::VectorXd &)> &f,
+    const std::function<Eigen::MatrixXd(double, const Eigen::VectorXd &)> &df,
+    const std::function<Eigen::VectorXd(const Eigen::VectorXd &,
+                                        const Eigen::VectorXd &)> &g,
+    const std::function<std::pair<Eigen::MatrixXd, Eigen::MatrixXd>(
+        const Eigen::VectorXd &, const Eigen::VectorXd &)> &dg,
+    double a, double b, const Eigen::VectorXd &s0, unsigned int M,
+    double newton_tol = 1e-10, unsigned int max_newton = 20);
+
+/** Timing of MIRK collocation against shooting for up to M = 10^5 intervals
+ * and of the adaptive solver for a boundary layer problem */
+void BenchmarkMIRKBVP();
+
+}  // namespace MIRK
+
+#endif  // #ifndef MIRKBVP_H_
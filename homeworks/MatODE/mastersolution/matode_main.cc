@@ -53,5 +53,7 @@ int main(int /*argc*/, char** /*argv*/) {
               << std::endl;
   }
   /* SAM_LISTING_END_6 */
+
+  MatODE::benchmarkMatODEStepper();
   return 0;
 }
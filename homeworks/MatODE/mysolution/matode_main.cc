@@ -26,5 +26,7 @@ int main(int /*argc*/, char** /*argv*/) {
   // Your code goes here
   //====================
   /* SAM_LISTING_END_6 */
+
+  MatODE::benchmarkMatODEStepper();
   return 0;
 }
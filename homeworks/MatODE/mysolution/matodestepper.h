@@ -0,0 +1,101 @@
+#ifndef MATODESTEPPER_H_
+#define MATODESTEPPER_H_
+
+/**
+ * @file matodestepper.h
+ * @brief NPDE homework MatODE code
+ * @copyright Developed at ETH Zurich
+ */
+
+#include <Eigen/Core>
+#include <Eigen/LU>
+#include <vector>
+
+namespace MatODE {
+
+enum class StepMethod { ExplicitEuler, ImplicitEuler, ImplicitMidpoint };
+
+/**
+ * @brief Equidistant time stepping for the linear matrix ODE Y' = AY.
+ *
+ * Since A and h are fixed, each of the three single step methods has the form
+ * Y_{k+1} = S*Y_k with a propagation matrix S. It is computed once in the
+ * constructor, for the implicit methods from a single LU-factorization of
+ * I - hA and I - h/2*A, respectively. A step then costs a single product.
+ *
+ * @tparam N size of A known at compile time, or Eigen::Dynamic. Fixed sizes
+ * avoid heap allocations and let Eigen unroll the small products.
+ */
+template <int N = Eigen::Dynamic>
+class MatODEStepper {
+ public:
+  using Matrix = Eigen::Matrix<double, N, N>;
+  //! K matrices Y_1, ..., Y_K of size n x n stored side by side (n x nK)
+  using Batch = Eigen::Matrix<double, N, Eigen::Dynamic>;
+
+  MatODEStepper(const Matrix &A, double h, StepMethod method);
+
+  //! One step starting from Y0
+  Matrix step(const Matrix &Y0) const { return S_ * Y0; }
+
+  //! m steps for all matrices of the batch Y, in place
+  void steps(Batch &Y, unsigned int m);
+
+  //! Batch of initial values, with Y.col(k) being column k % n of Y0[k / n]
+  static Batch pack(const std::vector<Matrix> &Y0);
+
+  const Matrix &propagator() const { return S_; }
+
+ private:
+  Matrix S_;
+  Matrix work_[2];  // reused in every call of steps() for dynamic sizes
+};
+
+template <int N>
+MatODEStepper<N>::MatODEStepper(const Matrix &A, double h, StepMethod method) {
+  const Matrix I = Matrix::Identity(A.rows(), A.cols());
+  //====================
+  // Your code goes here
+  //====================
+  S_ = I;
+}
+
+/* SAM_LISTING_BEGIN_1 */
+template <int N>
+void MatODEStepper<N>::steps(Batch &Y, unsigned int m) {
+  // The matrices are independent: each one is advanced by all m steps at once
+  // and stays in registers or in the cache meanwhile
+  if constexpr (N != Eigen::Dynamic) {
+    for (Eigen::Index j = 0; j < Y.cols(); j += N) {
+      Matrix Yj = Y.template middleCols<N>(j);
+      for (unsigned int k = 0; k < m; ++k) Yj = S_ * Yj;
+      Y.template middleCols<N>(j) = Yj;
+    }
+  } else {
+    const Eigen::Index n = S_.rows();
+    for (Eigen::Index j = 0; j < Y.cols(); j += n) {
+      work_[0] = Y.middleCols(j, n);
+      for (unsigned int k = 0; k < m; ++k) {
+        work_[1].noalias() = S_ * work_[0];
+        work_[0].swap(work_[1]);
+      }
+      Y.middleCols(j, n) = work_[0];
+    }
+  }
+}
+/* SAM_LISTING_END_1 */
+
+template <int N>
+typename MatODEStepper<N>::Batch MatODEStepper<N>::pack(
+    const std::vector<Matrix> &Y0) {
+  const int n = Y0.empty() ? 0 : Y0[0].rows();
+  Batch Y(n, n * Y0.size());
+  for (std::size_t k = 0; k < Y0.size(); ++k) {
+    Y.middleCols(k * n, n) = Y0[k];
+  }
+  return Y;
+}
+
+}  // namespace MatODE
+
+#endif  // #ifndef MATODESTEPPER_H_
@@ -17,4 +17,10 @@ Eigen::MatrixXd ieulstep(const Eigen::MatrixXd& A, const Eigen::MatrixXd& Y0,
 Eigen::MatrixXd impstep(const Eigen::MatrixXd& A, const Eigen::MatrixXd& Y0,
                         double h);
 
+/**
+ * @brief Measures steps per second for 5 x 5 matrices: the step functions
+ * above, MatODEStepper with dynamic and fixed size, and batched stepping
+ */
+void benchmarkMatODEStepper();
+
 }  // namespace MatODE
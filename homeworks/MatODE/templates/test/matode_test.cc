@@ -7,6 +7,7 @@
  */
 
 #include "../matode.h"
+#include "../matodestepper.h"
 
 #include <gtest/gtest.h>
 
@@ -118,4 +119,34 @@ TEST(MatODE, impstep) {
   ASSERT_NEAR(0.0, error.lpNorm<Eigen::Infinity>(), tol);
 }
 
+TEST(MatODE, MatODEStepper) {
+  Eigen::Matrix3d A;
+  A << 0.0, 1.0, 0.0, 1.0, 0.0, 1.0, 1.0, 1.0, 0.0;
+  Eigen::Matrix3d Y0;
+  Y0 << 1.0, 2.0, 0.0, 0.5, 1.0, 3.0, 1.0, -1.0, 2.0;
+  const double h = 0.1;
+  const double tol = 1.0e-12;
+
+  MatODEStepper<3> eeul(A, h, StepMethod::ExplicitEuler);
+  MatODEStepper<3> ieul(A, h, StepMethod::ImplicitEuler);
+  MatODEStepper<> imp(A, h, StepMethod::ImplicitMidpoint);
+  ASSERT_NEAR(0.0, (eeul.step(Y0) - eeulstep(A, Y0, h)).norm(), tol);
+  ASSERT_NEAR(0.0, (ieul.step(Y0) - ieulstep(A, Y0, h)).norm(), tol);
+  ASSERT_NEAR(0.0, (imp.step(Y0) - impstep(A, Y0, h)).norm(), tol);
+
+  // Batch of three initial values, advanced by 10 steps
+  const std::vector<Eigen::Matrix3d> Y0s = {Y0, 2.0 * Y0,
+                                            Eigen::Matrix3d::Identity()};
+  MatODEStepper<3>::Batch Y = MatODEStepper<3>::pack(Y0s);
+  ieul.steps(Y, 10);
+  for (int k = 0; k < 3; ++k) {
+    Eigen::Matrix3d ref = Y0s[k];
+    for (int j = 0; j < 10; ++j) ref = ieulstep(A, ref, h);
+    ASSERT_NEAR(0.0, (Y.middleCols<3>(3 * k) - ref).norm(), tol);
+  }
+  Eigen::MatrixXd Ydyn = MatODEStepper<>::pack({Y0, 2.0 * Y0});
+  imp.steps(Ydyn, 10);
+  ASSERT_NEAR(0.0, (2.0 * Ydyn.leftCols(3) - Ydyn.rightCols(3)).norm(), tol);
+}
+
 }  // namespace MatODE::test
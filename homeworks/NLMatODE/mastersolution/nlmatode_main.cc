@@ -34,5 +34,7 @@ int main() {
   double rate = NLMatODE::cvgDiscreteGradientMethod();
   std::cout << "\nThe fitted rate for the discrete gradient method is:\n"
             << rate << std::endl;
+
+  NLMatODE::benchmarkMatodeBatch();
   return 0;
 }
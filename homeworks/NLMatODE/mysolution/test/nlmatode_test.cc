@@ -11,6 +11,8 @@
 #include <gtest/gtest.h>
 
 #include <Eigen/Core>
+#include <cstddef>
+#include <vector>
 
 namespace NLMatODE::test {
 
@@ -35,6 +37,20 @@ TEST(NLMatODE, matode) {
   ASSERT_NEAR(0.0, error, tol);
 }
 
+TEST(NLMatODE, matodeBatch) {
+  const std::vector<Eigen::Matrix3d> Y0 = {getY0(), 0.5 * getY0(),
+                                           getY0().transpose()};
+  const std::vector<Eigen::Matrix3d> result = matodeBatch(Y0, T);
+  ASSERT_EQ(result.size(), Y0.size());
+
+  double tol = 1.0e-7;
+  for (std::size_t k = 0; k < Y0.size(); ++k) {
+    Eigen::Matrix3d reference = matode(Y0[k], T);
+    double error = (reference - result[k]).lpNorm<Eigen::Infinity>();
+    ASSERT_NEAR(0.0, error, tol);
+  }
+}
+
 TEST(NLMatODE, checkinvariant) {
   bool result = checkinvariant(getY0(), T);  // ode45 does not preserve the norm
   ASSERT_TRUE(!result);
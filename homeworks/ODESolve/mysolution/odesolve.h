@@ -14,6 +14,8 @@
 #include <iostream>
 #include <vector>
 
+#include "../../../lecturecodes/Ode45/stepsizecontrol.h"
+
 namespace ODESolve {
 
 /**
@@ -21,6 +23,7 @@ namespace ODESolve {
  * step-size y0.
  * @tparam DiscEvlOp type for evolution operator (e.g. lambda
  * function type)
+ * @tparam State type of the state, e.g. double or Eigen::VectorXd
  * @param Psi original evolution operator
  * @param p parameter p for construction of Psi tilde
  * @param h step-size
@@ -28,8 +31,9 @@ namespace ODESolve {
  * @return Evolved step \f$ \tilde{\Psi}^h y0 \f$
  */
 /* SAM_LISTING_BEGIN_0 */
-template <class DiscEvlOp>
-double PsiTilde(const DiscEvlOp& Psi, unsigned int p, double h, double y0) {
+template <class DiscEvlOp, class State>
+State PsiTilde(const DiscEvlOp& Psi, unsigned int p, double h,
+               const State& y0) {
   // TODO: implement psi tilde operator and replace the dummy return value y0
   //====================
   // Your code goes here
@@ -72,6 +76,7 @@ double TestCvpExtrapolatedEuler();
  * @brief Evolves the vector y0 using the evolution operator from time 0 to T
  * using adaptive error control
  * @tparam DiscEvlOp type of the evolution operator
+ * @tparam State type of the state, e.g. double or Eigen::VectorXd
  * @param Psi original evolution operator
  * @param p parameter p for construction of Psi tilde
  * @param y0 initial data
@@ -84,21 +89,21 @@ double TestCvpExtrapolatedEuler();
  * @return pair of vectors (t_k,y_k)
  */
 /* SAM_LISTING_BEGIN_3 */
-template <class DiscEvlOp>
-std::pair<std::vector<double>, std::vector<double>> OdeIntSsCtrl(
-    const DiscEvlOp& Psi, unsigned int p, double y0, double T, double h0,
+template <class DiscEvlOp, class State>
+std::pair<std::vector<double>, std::vector<State>> OdeIntSsCtrl(
+    const DiscEvlOp& Psi, unsigned int p, const State& y0, double T, double h0,
     double reltol, double abstol, double hmin) {
+  std::vector<double> t;
+  std::vector<State> Y;
+
   double h = h0;
-  std::vector<double> Y, t;
   Y.push_back(y0);
   t.push_back(0.0);
-
-  double y = y0;
-
+  State y = y0;
   while (t.back() < T && h > hmin) {
-    double y_high = 1.0;  // TODO: fix this line
-    double y_low = 0.0;   // TODO: fix this line
-    double est = std::abs(y_high - y_low);
+    State y_high = y0;  // TODO: fix this line
+    State y_low = y0;   // TODO: fix this line
+    double est = StepSizeControl::defaultNorm(State(y_high - y_low));
     if (true /* TODO: fix this line */) {
       y = y_high;
       t.push_back(t.back() + std::min(T - t.back(), h));
@@ -1,5 +1,9 @@
 #include "ordnotall.h"
 
+#include <chrono>
+#include <string>
+#include <utility>
+
 namespace OrdNotAll {
 
 /* SAM_LISTING_BEGIN_1 */
@@ -109,4 +113,88 @@ void cmpCvgRKSSM() {
 }
 /* SAM_LISTING_END_2 */
 
+/* SAM_LISTING_BEGIN_3 */
+void benchmarkRKEngine() {
+  // Lotka-Volterra equations y1' = (a - y2) y1, y2' = (y1 - 1) y2 for
+  // many values of the parameter a; only y(T) is needed for each a
+  const unsigned int n_param = 2000;
+  const unsigned int N = 1000;
+  const double T = 10.0;
+  const Eigen::Vector2d y0(1.0, 2.0);
+
+  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(4, 4);
+  A(1, 0) = .5;
+  A(2, 1) = .5;
+  A(3, 2) = 1;
+  Eigen::VectorXd b(4);
+  b << 1. / 6, 1. / 3, 1. / 3, 1. / 6;
+
+  // Runs the parameter study, returns the time in seconds and the sum of the
+  // final states as a checksum
+  auto study = [&](auto &&solver) {
+    Eigen::Vector2d sum = Eigen::Vector2d::Zero();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (unsigned int i = 0; i < n_param; ++i) {
+      const double a = 1.0 + i / double(n_param);
+      auto f = [a](const Eigen::Vector2d &y) {
+        return Eigen::Vector2d((a - y(1)) * y(0), (y(0) - 1.0) * y(1));
+      };
+      sum += solver(f);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::make_pair(std::chrono::duration<double>(end - start).count(),
+                          sum);
+  };
+
+  RKIntegrator<Eigen::Vector2d> rk(A, b);
+  ExplicitRKEngine<DynamicTableau, Eigen::Vector2d> dynamic(
+      DynamicTableau(A, b));
+  ExplicitRKEngine<ClassicalRK4Tableau, Eigen::Vector2d> rk4;
+  ExplicitRKEngine<RK3Tableau, Eigen::Vector2d> rk3;
+  ExplicitRKEngine<BogackiShampineTableau, Eigen::Vector2d> bs3;
+
+  // Counts the evaluations of f in addition to solving
+  unsigned int evals = 0;
+  auto counted = [&](auto &engine) {
+    return [&](const auto &f) {
+      auto fc = [&evals, &f](const Eigen::Vector2d &y) {
+        ++evals;
+        return f(y);
+      };
+      return engine.solve(fc, T, y0, N);
+    };
+  };
+
+  std::cout << "Lotka-Volterra parameter study, " << n_param
+            << " parameters, N = " << N << std::endl;
+  std::cout << std::left << std::setw(44) << "method" << std::setw(12)
+            << "time [s]" << std::setw(12) << "f-evals"
+            << "checksum" << std::endl;
+  auto print = [](const std::string &name, std::pair<double, Eigen::Vector2d> r,
+                  unsigned int fevals) {
+    std::cout << std::left << std::setw(44) << name << std::setw(12)
+              << r.first << std::setw(12) << fevals << r.second.sum()
+              << std::endl;
+  };
+  print("RK4, RKIntegrator (all states)", study([&](const auto &f) {
+          return rk.solve(f, T, y0, N).back();
+        }),
+        4 * N * n_param);
+  print("RK4, run-time tableau (final state)", study([&](const auto &f) {
+          return dynamic.solve(f, T, y0, N);
+        }),
+        4 * N * n_param);
+  print("RK4, compile-time tableau (final state)", study([&](const auto &f) {
+          return rk4.solve(f, T, y0, N);
+        }),
+        4 * N * n_param);
+  evals = 0;
+  auto r = study(counted(rk3));
+  print("RK3, compile-time tableau (final state)", r, evals);
+  evals = 0;
+  r = study(counted(bs3));
+  print("Bogacki-Shampine with FSAL (final state)", r, evals);
+}
+/* SAM_LISTING_END_3 */
+
 }  // namespace OrdNotAll
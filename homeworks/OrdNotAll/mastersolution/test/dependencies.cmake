@@ -0,0 +1,14 @@
+# Dependencies of mastersolution:
+
+# DIR will be provided by the calling file.
+
+set(SOURCES
+  ${DIR}/rkengine.h
+  ${DIR}/rkintegrator.h
+  ${DIR}/test/ordnotall_test.cc
+)
+
+set(LIBRARIES
+  Eigen3::Eigen
+  GTest::gtest_main
+)
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <Eigen/Core>
+#include <cmath>
+#include <vector>
+
+#include "../rkengine.h"
+#include "../rkintegrator.h"
+
+namespace OrdNotAll::test {
+
+TEST(ExplicitRKEngine, StaticAndDynamicTableau) {
+  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(4, 4);
+  A(1, 0) = .5;
+  A(2, 1) = .5;
+  A(3, 2) = 1;
+  Eigen::VectorXd b(4);
+  b << 1. / 6, 1. / 3, 1. / 3, 1. / 6;
+  auto f = [](const Eigen::Vector2d &y) {
+    return Eigen::Vector2d(-y(1), y(0));
+  };
+  const Eigen::Vector2d y0(1.0, 0.0);
+
+  ExplicitRKEngine<ClassicalRK4Tableau, Eigen::Vector2d> rk4;
+  RKIntegrator<Eigen::Vector2d> rk(A, b);
+  const Eigen::Vector2d y_static = rk4.solve(f, 1.0, y0, 50);
+  const std::vector<Eigen::Vector2d> y_dynamic = rk.solve(f, 1.0, y0, 50);
+  ASSERT_EQ(y_dynamic.size(), 51);
+  EXPECT_NEAR((y_static - y_dynamic.back()).norm(), 0.0, 1.0E-14);
+  EXPECT_NEAR(y_static(0), std::cos(1.0), 1.0E-8);
+  EXPECT_NEAR(y_static(1), std::sin(1.0), 1.0E-8);
+}
+
+TEST(ExplicitRKEngine, FSAL) {
+  static_assert(isFSAL<BogackiShampineTableau>());
+  static_assert(!isFSAL<ClassicalRK4Tableau>());
+
+  unsigned int evals = 0;
+  auto f = [&evals](double y) {
+    ++evals;
+    return (1. - y) * y;
+  };
+  auto y_exact = [](double t) { return 1.0 / (1.0 + std::exp(-t)); };
+
+  // Third order convergence with s - 1 = 3 evaluations per step
+  ExplicitRKEngine<BogackiShampineTableau, double> bs3;
+  double err_old = 0.0;
+  for (unsigned int N : {10, 20, 40, 80}) {
+    evals = 0;
+    const double err = std::abs(bs3.solve(f, 1.0, 0.5, N) - y_exact(1.0));
+    EXPECT_EQ(evals, 3 * N + 1);
+    if (err_old > 0.0) {
+      EXPECT_NEAR(std::log2(err_old / err), 3.0, 0.1);
+    }
+    err_old = err;
+  }
+
+  // The same for a run-time tableau
+  Eigen::MatrixXd A(4, 4);
+  A << 0, 0, 0, 0, .5, 0, 0, 0, 0, .75, 0, 0, 2. / 9, 1. / 3, 4. / 9, 0;
+  Eigen::VectorXd b(4);
+  b << 2. / 9, 1. / 3, 4. / 9, 0;
+  ExplicitRKEngine<DynamicTableau, double> dynamic(DynamicTableau(A, b));
+  evals = 0;
+  const double y_dynamic = dynamic.solve(f, 1.0, 0.5, 40);
+  EXPECT_EQ(evals, 3 * 40 + 1);
+  EXPECT_NEAR(y_dynamic, bs3.solve(f, 1.0, 0.5, 40), 1.0E-15);
+}
+
+TEST(ExplicitRKEngine, Output) {
+  auto f = [](double y) { return -y; };
+  ExplicitRKEngine<RK3Tableau, double> rk3;
+  const std::vector<double> every = rk3.solveEvery(f, 1.0, 1.0, 10, 4);
+  // n = 0, 4, 8 and the final state n = 10
+  ASSERT_EQ(every.size(), 4);
+  EXPECT_EQ(every.back(), rk3.solve(f, 1.0, 1.0, 10));
+
+  std::vector<unsigned int> steps;
+  rk3.solve(f, 1.0, 1.0, 10,
+            [&steps](unsigned int n, double) { steps.push_back(n); });
+  ASSERT_EQ(steps.size(), 11);
+  EXPECT_EQ(steps.back(), 10);
+}
+
+}  // namespace OrdNotAll::test
@@ -1,15 +1,16 @@
 #include <Eigen/Dense>
-#include <cassert>
-#include <utility>
 #include <vector>
 
+#include "rkengine.h"
+
 namespace OrdNotAll {
 
 //! \file rkintegrator.hpp Implementation of RkIntegrator class.
 
 /*!
  *! \brief A Runge-Kutta explicit solver for a given
- *! Butcher tableau for autonomous ODEs.
+ *! Butcher tableau for autonomous ODEs. Thin wrapper around
+ *! ExplicitRKEngine for tableaux given at run time.
  *! \tparam State a type representing the space in which the solution
  *! lies, e.g. R^d, represented by e.g. Eigen::VectorXd.
  */
@@ -26,10 +27,7 @@ class RKIntegrator {
    *! part of Butcher tableau.
    */
   RKIntegrator(const Eigen::MatrixXd &A, const Eigen::VectorXd &b)
-      : A(A), b(b), s(b.size()) {
-    assert(A.cols() == A.rows() && "Matrix must be square.");
-    assert(A.cols() == b.size() && "Incompatible matrix/vector size.");
-  }
+      : tableau(A, b) {}
 
   /*!
    *! \brief Perform the solution of the ODE.
@@ -51,72 +49,15 @@ class RKIntegrator {
   template <class Function>
   std::vector<State> solve(const Function &f, double T, const State &y0,
                            unsigned int N) const {
-    std::vector<State> res;
-    // Iniz step size
-    double h = T / N;
-
-    // Will contain all steps, reserve memory for efficiency
-    res.reserve(N + 1);
-
-    // Store initial data
-    res.push_back(y0);
-
-    // Initialize some memory to store temporary values
-    State ytemp1 = y0;
-    State ytemp2 = y0;
-    // Pointers to swap previous value
-    State *yold = &ytemp1;
-    State *ynew = &ytemp2;
-
-    // Loop over all fixed steps
-    for (unsigned int k = 0; k < N; ++k) {
-      // Compute, save and swap next step
-      step(f, h, *yold, *ynew);
-      res.push_back(*ynew);
-      std::swap(yold, ynew);
-    }
-    return res;
+    // The engine holds the stage storage for the steps of this call only, so
+    // that concurrent calls do not share it
+    ExplicitRKEngine<DynamicTableau, State> engine(tableau);
+    // Store all steps; for final values only use ExplicitRKEngine::solve()
+    return engine.solveEvery(f, T, y0, N, 1);
   }
 
  private:
-  /*!
-   *! \brief Perform a single step of the RK method.
-   *! Solve an autonomous ODE using an explicit Runge Kutta Method.
-   *! Compute a single explicit RK step $y^{n+1} = y_n + \sum \dots$
-   *! starting from value $y_0$ and storing next value in $y_1$.
-   *! \tparam Function type for function implementing the rhs.
-   *! Must have State operator()(State x)
-   *! \param[in] $f$ function handle for rhs $f$, s.t. $y' = f(y)$
-   *! \param[in] $h$ step size
-   *! \param[in] $y_0$ initial state
-   *! \param[out] $y_1$ next step $y^{n+1} = y^n + \dots$
-   */
-  template <class Function>
-  void step(const Function &f, double h, const State &y0, State &y1) const {
-    // create vector holding next value
-    y1 = y0;
-    // Reserve space for increments
-    std::vector<State> k;
-    k.reserve(s);
-
-    // Loop over the size of RK
-    for (unsigned int i = 0; i < s; ++i) {
-      // Compute increments and save them to $k$
-      State incr = y0;
-      for (unsigned int j = 0; j < i; ++j) {
-        incr += h * A(i, j) * k.at(j);
-      }
-      k.push_back(f(incr));
-      y1 += h * b(i) * k.back();
-    }
-  }
-
-  //! Matrix $\VA$ in Butcher scheme
-  const Eigen::MatrixXd A;
-  //! Vector $\Vb$ in Butcher scheme
-  const Eigen::VectorXd b;
-  //! Size of Butcher matrix and vector $\VA$ and $\Vb$
-  unsigned int s;
+  DynamicTableau tableau;
 };
 /* SAM_LISTING_END_0 */
 
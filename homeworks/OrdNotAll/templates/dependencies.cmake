@@ -6,6 +6,7 @@ set(SOURCES
   ${DIR}/ordnotall_main.cc
   ${DIR}/ordnotall.h
   ${DIR}/ordnotall.cc
+  ${DIR}/rkengine.h
   ${DIR}/rkintegrator.h
 )
 
@@ -6,6 +6,7 @@
 #include <iostream>
 #include <vector>
 
+#include "rkengine.h"
 #include "rkintegrator.h"
 
 namespace OrdNotAll {
@@ -28,6 +29,12 @@ void testCvgRKSSM(const Function &f, double T, double y0,
 
 void cmpCvgRKSSM();
 
+/*!
+ * \brief Times RKIntegrator and ExplicitRKEngine in a parameter study for the
+ * Lotka-Volterra equations.
+ */
+void benchmarkRKEngine();
+
 }  // namespace OrdNotAll
 
 #endif
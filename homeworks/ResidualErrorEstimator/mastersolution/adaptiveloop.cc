@@ -0,0 +1,338 @@
+/**
+ * @file
+ * @brief NPDE homework ResidualErrorEstimator: adaptive finite element method
+ * @author agent
+ * @date October 2026
+ * @copyright Developed at SAM, ETH Zurich
+ */
+
+#include "adaptiveloop.h"
+
+#include <lf/mesh/hybrid2d/hybrid2d.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "../../HierarchicalErrorEstimator/mastersolution/hierarchicalerrorestimator.h"
+#include "../../ZienkiewiczZhuEstimator/mastersolution/zienkiewiczzhuestimator.h"
+
+namespace REE {
+
+std::shared_ptr<lf::mesh::Mesh> generateLShapedMesh() {
+  lf::mesh::hybrid2d::MeshFactory mesh_factory(2);
+  // clang-format off
+  const std::array<std::array<double, 2>, 8> node_coord{{
+      {-1, -1}, {0, -1}, {0, 0}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}}};
+  const std::array<std::array<lf::base::size_type, 3>, 6> triangles{{
+      {0, 1, 2}, {0, 2, 7}, {7, 2, 5}, {7, 5, 6}, {2, 3, 4}, {2, 4, 5}}};
+  // clang-format on
+  for (const auto &node : node_coord) {
+    mesh_factory.AddPoint(Eigen::Vector2d(node[0], node[1]));
+  }
+  for (const auto &tria : triangles) {
+    mesh_factory.AddEntity(lf::base::RefEl::kTria(),
+                           std::vector<lf::base::size_type>(tria.begin(),
+                                                            tria.end()),
+                           std::unique_ptr<lf::geometry::Geometry>(nullptr));
+  }
+  return mesh_factory.Build();
+}
+
+/* SAM_LISTING_BEGIN_1 */
+std::vector<double> cellIndicators(const lf::mesh::Mesh &mesh,
+                                   const ResidualEstimate &est) {
+  std::vector<double> eta(mesh.NumEntities(0), 0.0);
+  // Every edge residual is shared by the two adjacent cells
+  for (const lf::mesh::Entity *cell : mesh.Entities(0)) {
+    double eta_K = est.vol_res(*cell);
+    for (const lf::mesh::Entity *edge : cell->SubEntities(1)) {
+      eta_K += 0.5 * est.edge_res(*edge);
+    }
+    eta[mesh.Index(*cell)] = eta_K;
+  }
+  return eta;
+}
+/* SAM_LISTING_END_1 */
+
+CellEstimator residualCellEstimator(unsigned int threads) {
+  return [threads](const dataDiscreteBVP &disc_bvp,
+                   const Eigen::VectorXd &mu) -> std::vector<double> {
+    std::shared_ptr<const lf::mesh::Mesh> mesh_p{
+        disc_bvp.pwlinfespace_p_->Mesh()};
+    const EstimatorGeometry geo(mesh_p);
+    return cellIndicators(*mesh_p,
+                          estimateResiduals(disc_bvp, geo, mu, threads));
+  };
+}
+
+CellEstimator zzCellEstimator(unsigned int threads) {
+  return [threads](const dataDiscreteBVP &disc_bvp,
+                   const Eigen::VectorXd &mu) -> std::vector<double> {
+    std::shared_ptr<const lf::mesh::Mesh> mesh_p{
+        disc_bvp.pwlinfespace_p_->Mesh()};
+    // Two dofs per node for the recovered gradient
+    const lf::assemble::UniformFEDofHandler vec_dofh(
+        mesh_p, {{lf::base::RefEl::kPoint(), 2},
+                 {lf::base::RefEl::kSegment(), 0},
+                 {lf::base::RefEl::kTria(), 0},
+                 {lf::base::RefEl::kQuad(), 0}});
+    const ZienkiewiczZhuEstimator::GradientRecovery recovery(
+        disc_bvp.pwlinfespace_p_->LocGlobMap(), vec_dofh);
+    const Eigen::VectorXd eta{recovery.cellDeviations(
+        mu, recovery.lumpedProjection(mu, threads), threads)};
+    return std::vector<double>(eta.data(), eta.data() + eta.size());
+  };
+}
+
+CellEstimator hierarchicalCellEstimator(unsigned int threads) {
+  return [threads](const dataDiscreteBVP &disc_bvp,
+                   const Eigen::VectorXd &mu) -> std::vector<double> {
+    const lf::mesh::Mesh &mesh{*disc_bvp.pwlinfespace_p_->Mesh()};
+    const HEST::LocalHierSurplus surplus{HEST::compLocalHierSurplus(
+        disc_bvp.mf_alpha_, disc_bvp.mf_f_, disc_bvp.pwlinfespace_p_, mu,
+        threads)};
+    // Boundary edges carry no bubble and contribute zero
+    std::vector<double> eta(mesh.NumEntities(0), 0.0);
+    for (const lf::mesh::Entity *cell : mesh.Entities(0)) {
+      for (const lf::mesh::Entity *edge : cell->SubEntities(1)) {
+        eta[mesh.Index(*cell)] += 0.5 * surplus.eta_sq[mesh.Index(*edge)];
+      }
+    }
+    return eta;
+  };
+}
+
+/* SAM_LISTING_BEGIN_2 */
+std::vector<bool> doerflerMarking(const std::vector<double> &eta,
+                                  double theta) {
+  std::vector<bool> marked(eta.size(), false);
+  // Visit the indicators in descending order until their sum reaches theta
+  // times the total
+  std::vector<std::size_t> order(eta.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&eta](std::size_t i, std::size_t j) { return eta[i] > eta[j]; });
+  const double bound = theta * std::accumulate(eta.begin(), eta.end(), 0.0);
+  double sum = 0.0;
+  for (std::size_t i : order) {
+    if (sum >= bound) break;
+    marked[i] = true;
+    sum += eta[i];
+  }
+  return marked;
+}
+/* SAM_LISTING_END_2 */
+
+Eigen::VectorXd prolongateP1(const lf::refinement::MeshHierarchy &hierarchy,
+                             lf::base::size_type level,
+                             const lf::assemble::DofHandler &dofh_coarse,
+                             const lf::assemble::DofHandler &dofh_fine,
+                             const Eigen::VectorXd &u_coarse) {
+  const lf::mesh::Mesh &fine_mesh{*hierarchy.getMesh(level + 1)};
+  const std::vector<lf::refinement::ParentInfo> &parents{
+      hierarchy.ParentInfos(level + 1, 2)};
+  auto coarse_value = [&](const lf::mesh::Entity &node) -> double {
+    return u_coarse[dofh_coarse.GlobalDofIndices(node)[0]];
+  };
+  Eigen::VectorXd u_fine(dofh_fine.NumDofs());
+  for (const lf::mesh::Entity *node : fine_mesh.Entities(2)) {
+    const lf::mesh::Entity *parent = parents[fine_mesh.Index(*node)].parent_ptr;
+    double value;
+    if (parent->RefEl() == lf::base::RefEl::kPoint()) {
+      // Node of the coarse mesh
+      value = coarse_value(*parent);
+    } else {
+      // Midpoint of a coarse edge
+      LF_ASSERT_MSG(parent->RefEl() == lf::base::RefEl::kSegment(),
+                    "New nodes must be located on edges");
+      nonstd::span<const lf::mesh::Entity *const> endpoints{
+          parent->SubEntities(1)};
+      value = 0.5 * (coarse_value(*endpoints[0]) + coarse_value(*endpoints[1]));
+    }
+    u_fine[dofh_fine.GlobalDofIndices(*node)[0]] = value;
+  }
+  return u_fine;
+}
+
+/* SAM_LISTING_BEGIN_3 */
+std::vector<AdaptiveStep> adaptiveLoop(
+    std::shared_ptr<lf::mesh::Mesh> mesh_p,
+    std::function<double(Eigen::Vector2d)> alpha,
+    std::function<double(Eigen::Vector2d)> f,
+    std::function<Eigen::Vector2d(Eigen::Vector2d)> grad_u,
+    const CellEstimator &estimator, const AdaptiveOptions &options) {
+  using clock = std::chrono::high_resolution_clock;
+  auto elapsed = [](clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(clock::now() - start)
+        .count();
+  };
+  lf::refinement::MeshHierarchy hierarchy(
+      mesh_p, std::make_unique<lf::mesh::hybrid2d::MeshFactory>(2));
+  const lf::mesh::utils::MeshFunctionGlobal mf_grad_u{grad_u};
+
+  std::vector<AdaptiveStep> steps;
+  // Discrete problem and solution on the previous level
+  std::unique_ptr<dataDiscreteBVP> disc_bvp_prev;
+  Eigen::VectorXd mu_prev;
+  double time_ms = 0.0;
+  for (lf::base::size_type level = 0;; ++level) {
+    clock::time_point start = clock::now();
+    std::shared_ptr<const lf::mesh::Mesh> mesh_l{hierarchy.getMesh(level)};
+    auto disc_bvp = std::make_unique<dataDiscreteBVP>(mesh_l, alpha, f);
+    const lf::assemble::DofHandler &dofh{
+        disc_bvp->pwlinfespace_p_->LocGlobMap()};
+
+    // SOLVE, starting from the solution of the previous level
+    Eigen::VectorXd guess = Eigen::VectorXd::Zero(dofh.NumDofs());
+    if (options.warm_start && disc_bvp_prev) {
+      guess = prolongateP1(hierarchy, level - 1,
+                           disc_bvp_prev->pwlinfespace_p_->LocGlobMap(), dofh,
+                           mu_prev);
+    }
+    unsigned int iterations = 0;
+    Eigen::VectorXd mu{solveBVP(*disc_bvp, guess, options.cg_tol, &iterations)};
+
+    // ESTIMATE
+    const std::vector<double> eta{estimator(*disc_bvp, mu)};
+    time_ms += elapsed(start);
+
+    // Monitor the error, not included in the timings
+    const lf::fe::MeshFunctionGradFE mf_grad_sol(disc_bvp->pwlinfespace_p_,
+                                                 mu);
+    const double H1serr = std::sqrt(lf::fe::IntegrateMeshFunction(
+        *mesh_l, lf::mesh::utils::squaredNorm(mf_grad_sol - mf_grad_u), 2));
+    steps.push_back({dofh.NumDofs(), iterations,
+                     std::sqrt(std::accumulate(eta.begin(), eta.end(), 0.0)),
+                     H1serr, time_ms});
+    if (dofh.NumDofs() > options.max_dofs) break;
+
+    start = clock::now();
+    if (options.uniform) {
+      hierarchy.RefineRegular();
+    } else {
+      // MARK the cells by the Doerfler criterion and all their edges
+      const std::vector<bool> marked_cells{doerflerMarking(eta, options.theta)};
+      std::vector<bool> marked_edges(mesh_l->NumEntities(1), false);
+      bool any = false;
+      for (const lf::mesh::Entity *cell : mesh_l->Entities(0)) {
+        if (marked_cells[mesh_l->Index(*cell)]) {
+          any = true;
+          for (const lf::mesh::Entity *edge : cell->SubEntities(1)) {
+            marked_edges[mesh_l->Index(*edge)] = true;
+          }
+        }
+      }
+      // Vanishing estimate: the solution is exact
+      if (!any) break;
+      hierarchy.MarkEdges(
+          [&marked_edges](const lf::mesh::Mesh &mesh,
+                          const lf::mesh::Entity &edge) -> bool {
+            return marked_edges[mesh.Index(edge)];
+          });
+      // REFINE the marked edges, the refinement closure is done by
+      // LehrFEM++
+      hierarchy.RefineMarked();
+    }
+    time_ms += elapsed(start);
+    disc_bvp_prev = std::move(disc_bvp);
+    mu_prev = std::move(mu);
+  }
+  return steps;
+}
+/* SAM_LISTING_END_3 */
+
+/* SAM_LISTING_BEGIN_4 */
+void adaptiveVsUniform() {
+  // u = r^{2/3} sin(2 phi / 3) (1 - x^2)(1 - y^2) on the L-shaped domain,
+  // vanishing on the boundary and with a singular gradient at the re-entrant
+  // corner. The first factor s is harmonic, hence
+  // f = -Delta u = -(2 grad s . grad b + s Delta b) for the bubble b.
+  auto polar = [](Eigen::Vector2d x) -> std::pair<double, double> {
+    double phi = std::atan2(x[1], x[0]);
+    if (phi < 0) phi += 2 * M_PI;
+    return {x.norm(), phi};
+  };
+  auto grad_s = [polar](Eigen::Vector2d x) -> Eigen::Vector2d {
+    const auto [r, phi] = polar(x);
+    if (r == 0.0) return Eigen::Vector2d::Zero();
+    return 2.0 / 3.0 * std::pow(r, -1.0 / 3.0) *
+           Eigen::Vector2d(-std::sin(phi / 3), std::cos(phi / 3));
+  };
+  auto s = [polar](Eigen::Vector2d x) -> double {
+    const auto [r, phi] = polar(x);
+    return std::pow(r, 2.0 / 3.0) * std::sin(2 * phi / 3);
+  };
+  auto b = [](Eigen::Vector2d x) -> double {
+    return (1 - x[0] * x[0]) * (1 - x[1] * x[1]);
+  };
+  auto grad_b = [](Eigen::Vector2d x) -> Eigen::Vector2d {
+    return Eigen::Vector2d(-2 * x[0] * (1 - x[1] * x[1]),
+                           -2 * x[1] * (1 - x[0] * x[0]));
+  };
+  std::function<Eigen::Vector2d(Eigen::Vector2d)> grad_u =
+      [=](Eigen::Vector2d x) -> Eigen::Vector2d {
+    return b(x) * grad_s(x) + s(x) * grad_b(x);
+  };
+  std::function<double(Eigen::Vector2d)> f = [=](Eigen::Vector2d x) -> double {
+    const double lapl_b = -2 * (1 - x[1] * x[1]) - 2 * (1 - x[0] * x[0]);
+    return -(2 * grad_s(x).dot(grad_b(x)) + s(x) * lapl_b);
+  };
+  std::function<double(Eigen::Vector2d)> alpha =
+      [](Eigen::Vector2d) -> double { return 1.0; };
+
+  auto print = [](const std::string &title,
+                  const std::vector<AdaptiveStep> &steps) {
+    std::cout << title << std::endl;
+    std::cout << std::setw(10) << "#dofs" << std::setw(8) << "CG it"
+              << std::setw(14) << "estimate" << std::setw(14) << "H1 error"
+              << std::setw(12) << "time [ms]" << std::endl;
+    for (const AdaptiveStep &step : steps) {
+      std::cout << std::setw(10) << step.dofs << std::setw(8)
+                << step.cg_iterations << std::setw(14) << step.eta
+                << std::setw(14) << step.H1serr << std::setw(12)
+                << step.time_ms << std::endl;
+    }
+    // Empirical rate of the error with respect to the number of dofs
+    const AdaptiveStep &first = steps[steps.size() / 2];
+    const AdaptiveStep &last = steps.back();
+    std::cout << "rate: H1 error ~ #dofs^"
+              << std::log(last.H1serr / first.H1serr) /
+                     std::log(static_cast<double>(last.dofs) / first.dofs)
+              << std::endl;
+  };
+
+  const unsigned int threads =
+      std::max(1u, std::thread::hardware_concurrency());
+  const CellEstimator estimator{residualCellEstimator(threads)};
+  AdaptiveOptions options;
+  options.max_dofs = 40000;
+  print("Adaptive refinement, theta = 0.5, warm start",
+        adaptiveLoop(generateLShapedMesh(), alpha, f, grad_u, estimator,
+                     options));
+  print("Adaptive refinement by the Zienkiewicz-Zhu estimator",
+        adaptiveLoop(generateLShapedMesh(), alpha, f, grad_u,
+                     zzCellEstimator(threads), options));
+  print("Adaptive refinement by the hierarchical estimator",
+        adaptiveLoop(generateLShapedMesh(), alpha, f, grad_u,
+                     hierarchicalCellEstimator(threads), options));
+  options.warm_start = false;
+  print("Adaptive refinement, theta = 0.5, cold start",
+        adaptiveLoop(generateLShapedMesh(), alpha, f, grad_u, estimator,
+                     options));
+  options.uniform = true;
+  options.warm_start = true;
+  print("Uniform refinement, warm start",
+        adaptiveLoop(generateLShapedMesh(), alpha, f, grad_u, estimator,
+                     options));
+}
+/* SAM_LISTING_END_4 */
+
+}  // namespace REE
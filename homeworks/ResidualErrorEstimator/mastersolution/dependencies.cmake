@@ -1,7 +1,10 @@
 set(SOURCES
 ${DIR}/residualerrorestimator_main.cc
 ${DIR}/residualerrorestimator.cc
-${DIR}/residualerrorestimator.h)
+${DIR}/residualerrorestimator.h
+${DIR}/adaptiveloop.cc
+${DIR}/adaptiveloop.h
+${DIR}/../../ZienkiewiczZhuEstimator/mastersolution/zienkiewiczzhuestimator.cc)
 
 set(LIBRARIES
   Eigen3::Eigen
@@ -16,4 +19,5 @@ set(LIBRARIES
   LF::lf.io
   LF::lf.fe
   LF::lf.uscalfe
+  Threads::Threads
 )
@@ -8,8 +8,17 @@
 
 #include "residualerrorestimator.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
 #include <utility>
 
+#include "../../../lecturecodes/helperfiles/parallelchunks.h"
+
 namespace REE {
 
 /* SAM_LISTING_BEGIN_2 */
@@ -24,7 +33,8 @@ dataDiscreteBVP::dataDiscreteBVP(std::shared_ptr<const lf::mesh::Mesh> mesh_p,
 }
 /* SAM_LISTING_END_2 */
 
-Eigen::VectorXd solveBVP(const dataDiscreteBVP &disc_bvp) {
+std::pair<Eigen::SparseMatrix<double>, Eigen::VectorXd> assembleBVP(
+    const dataDiscreteBVP &disc_bvp) {
   // For conveneicne we set up references to essential objects for FE
   // discretization in the lowest-order Lagrangian finite element space
   const lf::uscalfe::FeSpaceLagrangeO1<double> &linfespc{
@@ -64,7 +74,9 @@ Eigen::VectorXd solveBVP(const dataDiscreteBVP &disc_bvp) {
   // Create a predicate selecting nodes on the boundary
   lf::mesh::utils::CodimMeshDataSet<bool> bd_flags{
       lf::mesh::utils::flagEntitiesOnBoundary(mesh_p, 2)};
-  lf::assemble::FixFlaggedSolutionCompAlt<double>(
+  // Drop both the rows and the columns of the boundary dofs, so that the
+  // matrix stays symmetric positive definite
+  lf::assemble::FixFlaggedSolutionComponents<double>(
       [&bd_flags,
        &dofh](lf::assemble::glb_idx_t dof_idx) -> std::pair<bool, double> {
         const lf::mesh::Entity &node{dofh.Entity(dof_idx)};
@@ -74,8 +86,13 @@ Eigen::VectorXd solveBVP(const dataDiscreteBVP &disc_bvp) {
       A, phi);
   // Assembly completed: Convert COO matrix A into CRS format using Eigen's
   // internal conversion routines.
-  Eigen::SparseMatrix<double> A_crs = A.makeSparse();
+  return {A.makeSparse(), phi};
+}
 
+Eigen::VectorXd solveBVP(const dataDiscreteBVP &disc_bvp,
+                         ConvergenceStudy::PhaseTimer *timer) {
+  const auto [A_crs, phi] = assembleBVP(disc_bvp);
+  if (timer != nullptr) timer->lap(ConvergenceStudy::kAssemble);
   // Solve linear system using Eigen's sparse direct elimination
   // Examine return status of solver in case the matrix is singular
   Eigen::SparseLU<Eigen::SparseMatrix<double>> solver;
@@ -83,6 +100,28 @@ Eigen::VectorXd solveBVP(const dataDiscreteBVP &disc_bvp) {
   LF_VERIFY_MSG(solver.info() == Eigen::Success, "LU decomposition failed");
   Eigen::VectorXd sol_vec = solver.solve(phi);
   LF_VERIFY_MSG(solver.info() == Eigen::Success, "Solving LSE failed");
+  if (timer != nullptr) timer->lap(ConvergenceStudy::kSolve);
+  return sol_vec;
+}
+
+Eigen::VectorXd solveBVP(const dataDiscreteBVP &disc_bvp,
+                         const Eigen::VectorXd &guess, double tol,
+                         unsigned int *iterations) {
+  const auto [A_crs, phi] = assembleBVP(disc_bvp);
+  LF_ASSERT_MSG(guess.size() == phi.size(), "Initial guess of wrong size");
+  // assembleBVP() eliminates the Dirichlet dofs symmetrically, so that CG
+  // with an incomplete Cholesky preconditioner can be used
+  Eigen::ConjugateGradient<Eigen::SparseMatrix<double>,
+                           Eigen::Lower | Eigen::Upper,
+                           Eigen::IncompleteCholesky<double>>
+      solver;
+  solver.setTolerance(tol);
+  solver.compute(A_crs);
+  LF_VERIFY_MSG(solver.info() == Eigen::Success,
+                "Incomplete Cholesky factorization failed");
+  Eigen::VectorXd sol_vec = solver.solveWithGuess(phi, guess);
+  LF_VERIFY_MSG(solver.info() == Eigen::Success, "CG did not converge");
+  if (iterations != nullptr) *iterations = solver.iterations();
   return sol_vec;
 }
 
@@ -117,8 +156,194 @@ lf::mesh::utils::CodimMeshDataSet<double> edgeResiduals(
 }
 /* SAM_LISTING_END_4 */
 
+EstimatorGeometry::EstimatorGeometry(
+    std::shared_ptr<const lf::mesh::Mesh> mesh_p)
+    : mesh_p_(std::move(mesh_p)) {
+  const lf::mesh::Mesh &mesh{*mesh_p_};
+  const lf::base::size_type n_cells = mesh.NumEntities(0);
+  const lf::base::size_type n_edges = mesh.NumEntities(1);
+
+  // Edges: unit normals, lengths, boundary flags
+  edge_normal_.resize(n_edges);
+  edge_length_.resize(n_edges);
+  edge_on_bd_.resize(n_edges);
+  std::vector<Eigen::Vector2d> edge_startpt(n_edges);
+  lf::mesh::utils::CodimMeshDataSet<bool> bd_ed_flags{
+      lf::mesh::utils::flagEntitiesOnBoundary(mesh_p_, 1)};
+  for (const lf::mesh::Entity *edge : mesh.Entities(1)) {
+    const lf::base::size_type e = mesh.Index(*edge);
+    const Eigen::MatrixXd corners{lf::geometry::Corners(*(edge->Geometry()))};
+    const Eigen::Vector2d dir = corners.col(1) - corners.col(0);
+    edge_startpt[e] = corners.col(0);
+    edge_length_[e] = dir.norm();
+    edge_normal_[e] = Eigen::Vector2d(dir(1), -dir(0)) / edge_length_[e];
+    edge_on_bd_[e] = bd_ed_flags(*edge);
+  }
+
+  // Cells: diameters, areas, barycentric coordinate gradients, edges and
+  // orientation of the edge normals
+  cell_diam_.resize(n_cells);
+  cell_area_.resize(n_cells);
+  cell_grad_bary_.resize(n_cells);
+  cell_edges_.resize(n_cells);
+  cell_edge_ori_.resize(n_cells);
+  for (const lf::mesh::Entity *cell : mesh.Entities(0)) {
+    LF_ASSERT_MSG(cell->RefEl() == lf::base::RefEl::kTria(),
+                  "Implemented for triangles only");
+    const lf::base::size_type i = mesh.Index(*cell);
+    const Eigen::MatrixXd corners{lf::geometry::Corners(*(cell->Geometry()))};
+    cell_diam_[i] = std::max({(corners.col(1) - corners.col(0)).norm(),
+                              (corners.col(2) - corners.col(1)).norm(),
+                              (corners.col(0) - corners.col(2)).norm()});
+    // The barycentric coordinate functions are the rows of X^{-1}
+    // evaluated at (1, x)
+    Eigen::Matrix3d X;
+    X.col(0) = Eigen::Vector3d::Ones();
+    X.rightCols(2) = corners.transpose();
+    cell_area_[i] = 0.5 * std::abs(X.determinant());
+    cell_grad_bary_[i] = X.inverse().bottomRows(2);
+    // Edge l connects vertices l and l+1, the normal is oriented towards the
+    // opposite vertex l+2 if the sign is +1
+    nonstd::span<const lf::mesh::Entity *const> edges{cell->SubEntities(1)};
+    for (int l = 0; l < 3; ++l) {
+      const lf::base::size_type e = mesh.Index(*edges[l]);
+      cell_edges_[i][l] = e;
+      cell_edge_ori_[i][l] =
+          (edge_normal_[e].dot(corners.col((l + 2) % 3) - edge_startpt[e]) > 0)
+              ? 1.0
+              : -1.0;
+    }
+  }
+}
+
+/* SAM_LISTING_BEGIN_6 */
+ResidualEstimate estimateResiduals(const dataDiscreteBVP &disc_bvp,
+                                   const EstimatorGeometry &geo,
+                                   const Eigen::VectorXd &u_vec,
+                                   unsigned int threads) {
+  std::shared_ptr<const lf::mesh::Mesh> mesh_p =
+      disc_bvp.pwlinfespace_p_->Mesh();
+  LF_ASSERT_MSG(mesh_p == geo.mesh_p_,
+                "Geometric data belong to a different mesh");
+  const lf::mesh::Mesh &mesh{*mesh_p};
+  const lf::assemble::DofHandler &dofh{disc_bvp.pwlinfespace_p_->LocGlobMap()};
+  const lf::base::size_type n_cells = mesh.NumEntities(0);
+  const lf::base::size_type n_edges = mesh.NumEntities(1);
+  threads = std::max(1u, std::min<unsigned int>(threads, n_cells));
+
+  // Cell contributions are written by the thread owning the cell, the edge
+  // quantities are accumulated per thread
+  std::vector<double> vol(n_cells, 0.0);
+  std::vector<double> edge(n_edges, 0.0);
+  std::vector<std::vector<double>> flux_jump(threads);
+  std::vector<std::vector<double>> alpha_max(threads);
+  const lf::quad::QuadRule qr{lf::quad::make_TriaQR_EdgeMidpointRule()};
+  const Eigen::MatrixXd dummy = Eigen::Vector2d(1.0 / 3.0, 1.0 / 3.0);
+
+  // Step I: sweep over the cells of chunk t
+  auto sweep = [&](unsigned int t, lf::base::size_type begin,
+                   lf::base::size_type end) {
+    flux_jump[t].assign(n_edges, 0.0);
+    alpha_max[t].assign(n_edges, 0.0);
+    //====================
+    // Your code goes here
+    //====================
+  };
+  parallelChunks(n_cells, threads, sweep);
+
+  // Step II: reduction of the thread-local edge quantities
+  auto reduce = [&](unsigned int /*t*/, lf::base::size_type begin,
+                    lf::base::size_type end) {
+    //====================
+    // Your code goes here
+    //====================
+  };
+  parallelChunks(n_edges, threads, reduce);
+
+  // Step III: copy into MeshDataSets and sum
+  ResidualEstimate est{
+      lf::mesh::utils::CodimMeshDataSet<double>(mesh_p, 0, 0.0),
+      lf::mesh::utils::CodimMeshDataSet<double>(mesh_p, 1, 0.0), 0.0, 0.0};
+  for (lf::base::size_type i = 0; i < n_cells; ++i) {
+    est.vol_res(*mesh.EntityByIndex(0, i)) = vol[i];
+    est.eta_vol += vol[i];
+  }
+  for (lf::base::size_type e = 0; e < n_edges; ++e) {
+    est.edge_res(*mesh.EntityByIndex(1, e)) = edge[e];
+    est.eta_ed += edge[e];
+  }
+  return est;
+}
+/* SAM_LISTING_END_6 */
+
+/* SAM_LISTING_BEGIN_7 */
+void benchmarkEstimators(std::shared_ptr<const lf::mesh::Mesh> mesh_p) {
+  auto time = [](auto &&F) {
+    auto start = std::chrono::high_resolution_clock::now();
+    F();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+  };
+  std::function<double(Eigen::Vector2d)> alpha =
+      [](Eigen::Vector2d x) -> double { return 1.0 + x.squaredNorm(); };
+  std::function<double(Eigen::Vector2d)> f = [](Eigen::Vector2d x) -> double {
+    return std::exp(x[0] - x[1]);
+  };
+  const dataDiscreteBVP disc_bvp(mesh_p, alpha, f);
+  const Eigen::VectorXd mu{solveBVP(disc_bvp)};
+  const int reps = 10;
+
+  // Two separate sweeps with auxiliary MeshDataSets
+  double eta_ref = 0.0;
+  const double ms_ref = time([&] {
+    for (int r = 0; r < reps; ++r) {
+      const lf::mesh::utils::CodimMeshDataSet<double> vol_res{
+          volumeResiduals(disc_bvp, mu)};
+      const lf::mesh::utils::CodimMeshDataSet<double> ed_res{
+          edgeResiduals(disc_bvp, mu)};
+      eta_ref = 0.0;
+      for (const lf::mesh::Entity *cell : mesh_p->Entities(0)) {
+        eta_ref += vol_res(*cell);
+      }
+      for (const lf::mesh::Entity *edge : mesh_p->Entities(1)) {
+        eta_ref += ed_res(*edge);
+      }
+    }
+  });
+  // Geometric data are computed once
+  std::unique_ptr<EstimatorGeometry> geo;
+  const double ms_geo =
+      time([&] { geo = std::make_unique<EstimatorGeometry>(mesh_p); });
+
+  std::cout << "Residual error estimator on " << mesh_p->NumEntities(0)
+            << " cells, average of " << reps << " runs" << std::endl;
+  std::cout << std::setw(24) << "method" << std::setw(12) << "time [ms]"
+            << std::setw(16) << "estimate" << std::endl;
+  std::cout << std::setw(24) << "two sweeps" << std::setw(12) << ms_ref / reps
+            << std::setw(16) << eta_ref << std::endl;
+  std::cout << std::setw(24) << "geometric data (once)" << std::setw(12)
+            << ms_geo << std::endl;
+  const unsigned int hw = std::max(1u, std::thread::hardware_concurrency());
+  for (unsigned int threads = 1; threads <= hw; threads *= 2) {
+    double eta = 0.0;
+    const double ms = time([&] {
+      for (int r = 0; r < reps; ++r) {
+        const ResidualEstimate est{
+            estimateResiduals(disc_bvp, *geo, mu, threads)};
+        eta = est.eta_vol + est.eta_ed;
+      }
+    });
+    std::cout << std::setw(24)
+              << "single sweep, " + std::to_string(threads) + " thr"
+              << std::setw(12) << ms / reps << std::setw(16) << eta
+              << std::endl;
+  }
+}
+/* SAM_LISTING_END_7 */
+
 std::tuple<double, double, double> solveAndEstimate(
-    std::shared_ptr<const lf::mesh::Mesh> mesh_p) {
+    std::shared_ptr<const lf::mesh::Mesh> mesh_p,
+    ConvergenceStudy::PhaseTimer *timer) {
   // Note: the mesh must cover the unit square for this test setting !
 
   // Define homogeneous Dirichlet boundary value problem
@@ -164,7 +389,7 @@ std::tuple<double, double, double> solveAndEstimate(
   const dataDiscreteBVP disc_bvp(mesh_p, alpha, f);
 
   // Compute basis expansion coefficient vector of finite-element solution
-  Eigen::VectorXd mu{solveBVP(disc_bvp)};
+  Eigen::VectorXd mu{solveBVP(disc_bvp, timer)};
 
   // Compute error norms
   // create *mesh_p functions representing solution / gradient of solution
@@ -178,10 +403,12 @@ std::tuple<double, double, double> solveAndEstimate(
   double H1serr = std::sqrt(lf::fe::IntegrateMeshFunction(  // NOLINT
       *mesh_p, lf::mesh::utils::squaredNorm(mf_grad_sol - mf_grad_u), 2));
 
-  std::cout << "Mesh (" << mesh_p->NumEntities(0) << " cells, "
-            << mesh_p->NumEntities(1) << " edges, " << mesh_p->NumEntities(2)
-            << " nodes): L2err = " << L2err << ", H1serr = " << H1serr
-            << std::endl;
+  // Collect the output, so that the lines of concurrent calls do not
+  // interleave
+  std::ostringstream log;
+  log << "Mesh (" << mesh_p->NumEntities(0) << " cells, "
+      << mesh_p->NumEntities(1) << " edges, " << mesh_p->NumEntities(2)
+      << " nodes): L2err = " << L2err << ", H1serr = " << H1serr << "\n";
 
   // Evaluate a-posteriori error estimator
   // Compute volume contributions
@@ -200,8 +427,10 @@ std::tuple<double, double, double> solveAndEstimate(
     eta_ed += ed_res(*edge);
   }
 
-  std::cout << "Estimated error = " << eta_vol + eta_ed << ", vol = " << eta_vol
-            << ", edge = " << eta_ed << std::endl;
+  log << "Estimated error = " << eta_vol + eta_ed << ", vol = " << eta_vol
+      << ", edge = " << eta_ed << "\n";
+  std::cout << log.str() << std::flush;
+  if (timer != nullptr) timer->lap(ConvergenceStudy::kError);
 
   return {L2err, H1serr, eta_vol + eta_ed};
 }  // end solveAndEstimate
@@ -0,0 +1,109 @@
+#ifndef ADAPTIVELOOP_H
+#define ADAPTIVELOOP_H
+/**
+ * @file
+ * @brief NPDE homework ResidualErrorEstimator: adaptive finite element method
+ * @author agent
+ * @date October 2026
+ * @copyright Developed at SAM, ETH Zurich
+ */
+
+#include <lf/assemble/assemble.h>
+#include <lf/mesh/mesh.h>
+#include <lf/refinement/refinement.h>
+
+#include <Eigen/Core>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "residualerrorestimator.h"
+
+namespace REE {
+
+/** @brief Parameters of the adaptive loop */
+struct AdaptiveOptions {
+  double theta = 0.5;  // Doerfler marking parameter in (0, 1]
+  bool uniform = false;  // refine all cells instead of the marked ones
+  bool warm_start = true;  // start CG from the prolongated solution
+  lf::base::size_type max_dofs = 20000;  // stop beyond this number of dofs
+  double cg_tol = 1.0E-10;  // relative tolerance of CG
+};
+
+/** @brief Data recorded on every level of the adaptive loop */
+struct AdaptiveStep {
+  lf::base::size_type dofs;
+  unsigned int cg_iterations;
+  double eta;  // square root of the sum of all residuals
+  double H1serr;  // error in the H1-seminorm
+  double time_ms;  // wall time since the start of the loop, without the
+                   // computation of the error
+};
+
+/** @brief L-shaped domain (-1,1)^2 \ [0,1)x(-1,0] with 6 triangles */
+std::shared_ptr<lf::mesh::Mesh> generateLShapedMesh();
+
+/** @brief Cell indicators vol_res(K) + 1/2 sum_{e in K} edge_res(e), indexed
+ * by cells; their sum is the total estimate */
+std::vector<double> cellIndicators(const lf::mesh::Mesh &mesh,
+                                   const ResidualEstimate &est);
+
+/** @brief Error estimator driving adaptiveLoop(): returns the indicators of
+ * the finite element solution mu of disc_bvp, indexed by cells; their sum
+ * is the square of the total estimate */
+using CellEstimator = std::function<std::vector<double>(
+    const dataDiscreteBVP &disc_bvp, const Eigen::VectorXd &mu)>;
+
+/** @brief CellEstimator made of estimateResiduals() and cellIndicators() */
+CellEstimator residualCellEstimator(unsigned int threads = 1);
+
+/** @brief CellEstimator of Zienkiewicz-Zhu type: local L2 deviations of the
+ * gradient from its lumped projection, see
+ * ZienkiewiczZhuEstimator::GradientRecovery::cellDeviations() */
+CellEstimator zzCellEstimator(unsigned int threads = 1);
+
+/** @brief CellEstimator made of the localized hierarchical surplus
+ * HEST::compLocalHierSurplus(): the indicator of an interior edge is shared
+ * by its two adjacent cells */
+CellEstimator hierarchicalCellEstimator(unsigned int threads = 1);
+
+/** @brief Doerfler marking: a set of cells of minimal size whose indicators
+ * sum up to at least theta times the total
+ *
+ * @return flags indexed like eta
+ */
+std::vector<bool> doerflerMarking(const std::vector<double> &eta,
+                                  double theta);
+
+/** @brief Prolongation of a piecewise linear finite element function from
+ * level to level+1 of a mesh hierarchy, by linear interpolation at the new
+ * nodes */
+Eigen::VectorXd prolongateP1(const lf::refinement::MeshHierarchy &hierarchy,
+                             lf::base::size_type level,
+                             const lf::assemble::DofHandler &dofh_coarse,
+                             const lf::assemble::DofHandler &dofh_fine,
+                             const Eigen::VectorXd &u_coarse);
+
+/** @brief SOLVE-ESTIMATE-MARK-REFINE loop for -div(alpha grad u) = f with
+ * homogeneous Dirichlet boundary conditions
+ *
+ * Starts on the given TRIANGULAR mesh and refines until the number of dofs
+ * exceeds options.max_dofs. The cells are marked according to the
+ * indicators returned by estimator. The gradient grad_u of the exact
+ * solution is only used for monitoring the error.
+ */
+std::vector<AdaptiveStep> adaptiveLoop(
+    std::shared_ptr<lf::mesh::Mesh> mesh_p,
+    std::function<double(Eigen::Vector2d)> alpha,
+    std::function<double(Eigen::Vector2d)> f,
+    std::function<Eigen::Vector2d(Eigen::Vector2d)> grad_u,
+    const CellEstimator &estimator,
+    const AdaptiveOptions &options = AdaptiveOptions());
+
+/** @brief Compares adaptive and uniform refinement for a solution with a
+ * corner singularity on the L-shaped domain */
+void adaptiveVsUniform();
+
+}  // namespace REE
+
+#endif  // ADAPTIVELOOP_H
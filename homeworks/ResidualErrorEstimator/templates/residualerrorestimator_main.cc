@@ -6,11 +6,16 @@
  * @copyright Developed at SAM, ETH Zurich
  */
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <fstream>
 #include <iomanip>
 #include <string>
+#include <vector>
 
+#include "../../../lecturecodes/helperfiles/convergencestudy.h"
+#include "adaptiveloop.h"
 #include "residualerrorestimator.h"
 
 int main(int /*argc*/, char** /*argv*/) {
@@ -19,33 +24,51 @@ int main(int /*argc*/, char** /*argv*/) {
   std::shared_ptr<lf::mesh::Mesh> mesh_p =
       lf::mesh::test_utils::GenerateHybrid2DTestMesh(3, 1.0 / 3.0);
 
-  // Generate a sequence of meshes by regular refinement.
+  // Generate a sequence of meshes by regular refinement. The hierarchy is
+  // only read from now on, so that its levels can be treated concurrently.
   const int reflevels = 5;
-  std::shared_ptr<lf::refinement::MeshHierarchy> multi_mesh_p =
+  std::shared_ptr<const lf::refinement::MeshHierarchy> multi_mesh_p =
       lf::refinement::GenerateMeshHierarchyByUniformRefinemnt(mesh_p,
                                                               reflevels);
-  lf::refinement::MeshHierarchy& multi_mesh{*multi_mesh_p};
+  const lf::refinement::MeshHierarchy& multi_mesh{*multi_mesh_p};
   // Number of levels
   int L = multi_mesh.NumLevels();
-
-  // Vector for keeping error norms
-  std::vector<std::tuple<int, double, double, double>> errs{};
-
-  // LEVEL LOOP: Do computations on all levels
+  // The levels are identified by their number of cells
+  std::vector<int> Ns(L);
   for (int level = 0; level < L; ++level) {
-    mesh_p = multi_mesh.getMesh(level);
-    auto [L2err, H1serr, ree] = REE::solveAndEstimate(mesh_p);
-    errs.emplace_back(mesh_p->NumEntities(0), L2err, H1serr, ree);
+    Ns[level] = static_cast<int>(multi_mesh.getMesh(level)->NumEntities(0));
   }
 
+  // LEVEL LOOP: Do computations on all levels
+  auto solveLevel = [&](int N, ConvergenceStudy::PhaseTimer& timer) {
+    const auto level = static_cast<lf::base::size_type>(
+        std::find(Ns.begin(), Ns.end(), N) - Ns.begin());
+    auto [L2err, H1serr, ree] =
+        REE::solveAndEstimate(multi_mesh.getMesh(level), &timer);
+    return Eigen::Vector3d(L2err, H1serr, ree);
+  };
+  // Sparse matrix, LU factors and mesh data sets, roughly 2 kB per cell
+  auto memory = [](int N) -> std::size_t {
+    return std::size_t{2048} * static_cast<std::size_t>(N);
+  };
+  const std::vector<ConvergenceStudy::Level> errs =
+      ConvergenceStudy::run(Ns, solveLevel, memory);
+
   std::cout << std::left << std::setw(16) << "#cells" << std::right
             << std::setw(16) << "L2 error" << std::setw(16) << "H1 error"
             << std::setw(16) << "Estimate" << std::endl;
-  for (const auto& err : errs) {
-    auto [N, l2err, h1serr, est] = err;
-    std::cout << std::left << std::setw(16) << N << std::left << std::setw(16)
-              << l2err << std::setw(16) << h1serr << std::setw(16) << est
-              << std::endl;
+  for (const ConvergenceStudy::Level& err : errs) {
+    std::cout << std::left << std::setw(16) << err.N << std::left
+              << std::setw(16) << err.errors[0] << std::setw(16)
+              << err.errors[1] << std::setw(16) << err.errors[2] << std::endl;
   }
+  ConvergenceStudy::write(CURRENT_BINARY_DIR "/errors.csv",
+                          {"L2", "H1s", "estimate"}, errs);
+
+  // Single-sweep estimator with cached geometric data on the finest mesh
+  REE::benchmarkEstimators(multi_mesh.getMesh(L - 1));
+
+  // Adaptive vs. uniform refinement for a corner singularity
+  REE::adaptiveVsUniform();
   return 0;
 }
@@ -15,5 +15,6 @@ set(LIBRARIES
   LF::lf.io
   LF::lf.fe
   LF::lf.uscalfe
+  Threads::Threads
 )
 
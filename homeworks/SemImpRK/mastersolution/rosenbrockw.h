@@ -0,0 +1,217 @@
+#ifndef ROSENBROCKW_H_
+#define ROSENBROCKW_H_
+
+/**
+ * @file rosenbrockw.h
+ * @brief NPDE homework SemImpRK code
+ * @author agent
+ * @date 18.10.2026
+ * @copyright Developed at ETH Zurich
+ */
+
+#include <Eigen/Core>
+#include <Eigen/LU>
+#include <Eigen/SparseCore>
+#include <Eigen/SparseLU>
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace SemImpRK {
+
+/**
+ * @brief Counters collected by RosenbrockW::solve()
+ */
+struct RosenbrockWStats {
+  unsigned int accepted = 0;        // accepted steps
+  unsigned int rejected = 0;        // rejected steps
+  unsigned int jacobians = 0;       // evaluations of the Jacobian
+  unsigned int factorizations = 0;  // factorizations of I - gamma*h*J
+};
+
+/**
+ * @brief Adaptive 2-stage W-method ROS2 of Verwer et al. for autonomous ODEs
+ * y' = f(y), with an embedded first order method for step size control.
+ *
+ * One step of size h with an approximate Jacobian J reads
+ *   (I - gamma*h*J) k1 = f(y0),
+ *   (I - gamma*h*J) k2 = f(y0 + h*k1) - 2*k1,   gamma = 1 + 1/sqrt(2),
+ *   y1 = y0 + h*(1.5*k1 + 0.5*k2),
+ * which is second order for any matrix J. Therefore the Jacobian need not be
+ * evaluated in every step: it is reused for up to jac_reuse steps, and the
+ * factorization of I - gamma*h*J is reused as long as h does not change.
+ * To this end, proposed step size increases by less than a factor of
+ * 1.5 are not carried out.
+ *
+ * @tparam Solver Eigen (sparse) solver for the matrix type returned by the
+ * Jacobian, e.g. Eigen::SparseLU<Eigen::SparseMatrix<double>> (default),
+ * Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> for symmetric
+ * Jacobians, or Eigen::PartialPivLU<Eigen::MatrixXd> for dense ones. For
+ * sparse Jacobians the sparsity pattern is analyzed only once and must not
+ * change.
+ */
+template <class Solver = Eigen::SparseLU<Eigen::SparseMatrix<double>>>
+class RosenbrockW {
+ public:
+  using MatrixType = typename Solver::MatrixType;
+
+  /**
+   * @param rtol relative tolerance for the local error
+   * @param atol absolute tolerance for the local error
+   * @param jac_reuse maximal number of steps with the same Jacobian
+   * @param hmin minimal step size, at least 1e-14 * T is used
+   */
+  RosenbrockW(double rtol, double atol, unsigned int jac_reuse = 10,
+              double hmin = 0.0)
+      : rtol_(rtol), atol_(atol), jac_reuse_(jac_reuse), hmin_(hmin) {}
+
+  /**
+   * @brief Solves y' = f(y), y(0) = y0 on [0, T]
+   * @param f right-hand side, takes and returns Eigen::VectorXd
+   * @param df Jacobian of f, returns a matrix of type MatrixType
+   * @param y0 initial value
+   * @param T final time
+   * @param h0 initial step size
+   * @param observer called as observer(t, y) for t = 0 and after every
+   * accepted step
+   * @return y(T)
+   * @throws std::runtime_error if the step size drops below hmin or the
+   * error estimate is not finite
+   */
+  template <class Func, class Jac, class Observer>
+  Eigen::VectorXd solve(Func &&f, Jac &&df, const Eigen::VectorXd &y0,
+                        double T, double h0, Observer &&observer);
+
+  /**
+   * @brief Same as above, but only the final state is computed
+   */
+  template <class Func, class Jac>
+  Eigen::VectorXd solve(Func &&f, Jac &&df, const Eigen::VectorXd &y0,
+                        double T, double h0) {
+    return solve(f, df, y0, T, h0, [](double, const Eigen::VectorXd &) {});
+  }
+
+  const RosenbrockWStats &stats() const { return stats_; }
+
+ private:
+  static constexpr bool kSparse =
+      std::is_base_of<Eigen::SparseMatrixBase<MatrixType>, MatrixType>::value;
+
+  // Factorizes W = I - gamma*h*J
+  void factorize(double h);
+
+  double rtol_, atol_;
+  unsigned int jac_reuse_;
+  double hmin_;
+  RosenbrockWStats stats_;
+  MatrixType J_;
+  Solver solver_;
+  bool pattern_analyzed_ = false;
+};
+
+template <class Solver>
+void RosenbrockW<Solver>::factorize(double h) {
+  const double gamma = 1.0 + 1.0 / std::sqrt(2.0);
+  if constexpr (kSparse) {
+    MatrixType I(J_.rows(), J_.cols());
+    I.setIdentity();
+    const MatrixType W = I - gamma * h * J_;
+    // The symbolic analysis only depends on the sparsity pattern
+    if (!pattern_analyzed_) {
+      solver_.analyzePattern(W);
+      pattern_analyzed_ = true;
+    }
+    solver_.factorize(W);
+  } else {
+    solver_.compute(MatrixType::Identity(J_.rows(), J_.cols()) -
+                    gamma * h * J_);
+  }
+  ++stats_.factorizations;
+}
+
+/* SAM_LISTING_BEGIN_1 */
+template <class Solver>
+template <class Func, class Jac, class Observer>
+Eigen::VectorXd RosenbrockW<Solver>::solve(Func &&f, Jac &&df,
+                                           const Eigen::VectorXd &y0, double T,
+                                           double h0, Observer &&observer) {
+  const double facmin = 0.2;   // limits for the change of the step size
+  const double facmax = 5.0;
+  const double keep = 1.5;     // keep h if it would grow by less than this
+  // Guards against step sizes underflowing to zero
+  const double hmin = std::max(hmin_, 1.0E-14 * T);
+  stats_ = RosenbrockWStats();
+  pattern_analyzed_ = false;
+
+  Eigen::VectorXd y = y0;
+  Eigen::VectorXd k1, k2, y1, err;
+  double t = 0.0;
+  double h = h0;
+  double h_fac = 0.0;    // step size of the current factorization
+  unsigned int age = 0;  // number of steps with the current Jacobian
+  bool fresh_jac = true;
+  observer(t, y);
+  while (t < T) {
+    // Do not overshoot T; the last step may need a new factorization
+    const double hstep = std::min(h, T - t);
+    if (fresh_jac || age >= jac_reuse_) {
+      J_ = df(y);
+      ++stats_.jacobians;
+      age = 0;
+      fresh_jac = false;
+      h_fac = 0.0;
+    }
+    if (hstep != h_fac) {
+      factorize(hstep);
+      h_fac = hstep;
+    }
+    // The two stages of ROS2
+    k1 = solver_.solve(f(y));
+    k2 = solver_.solve(f(y + hstep * k1) - 2.0 * k1);
+    y1 = y + hstep * (1.5 * k1 + 0.5 * k2);
+    // Difference to the first order solution y + h*k1, smoothed by W^{-1}
+    // to avoid overestimating the error of stiff components
+    err = solver_.solve(0.5 * hstep * (k1 + k2));
+    const double errnorm = std::sqrt(
+        (err.array() /
+         (atol_ + rtol_ * y.cwiseAbs().cwiseMax(y1.cwiseAbs()).array()))
+            .square()
+            .mean());
+    // A NaN would pass through the step size update below and stall t
+    if (!std::isfinite(errnorm)) {
+      std::stringstream ss;
+      ss << "RosenbrockW: non-finite error estimate at t = " << t;
+      throw std::runtime_error(ss.str());
+    }
+    const double fac = std::clamp(
+        0.9 / std::sqrt(std::max(errnorm, 1.0E-10)), facmin, facmax);
+    if (errnorm <= 1.0) {
+      t += hstep;
+      std::swap(y, y1);
+      ++age;
+      ++stats_.accepted;
+      observer(t, y);
+      if (fac < 1.0 || fac > keep) h = hstep * fac;
+    } else {
+      // A stale Jacobian may be the reason for the rejection
+      fresh_jac = age > 0;
+      ++stats_.rejected;
+      h = hstep * std::min(fac, 0.5);
+      if (h < hmin) {
+        std::stringstream ss;
+        ss << "RosenbrockW: step size " << h << " below hmin = " << hmin
+           << " at t = " << t;
+        throw std::runtime_error(ss.str());
+      }
+    }
+  }
+  return y;
+}
+/* SAM_LISTING_END_1 */
+
+}  // namespace SemImpRK
+
+#endif  // #ifndef ROSENBROCKW_H_
@@ -0,0 +1,117 @@
+/**
+ * @file rosenbrockwbenchmark.cc
+ * @brief NPDE homework SemImpRK code
+ * @author agent
+ * @date 18.10.2026
+ * @copyright Developed at ETH Zurich
+ */
+
+#include <Eigen/Core>
+#include <Eigen/SparseCore>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "rosenbrockw.h"
+#include "semimprk.h"
+
+namespace SemImpRK {
+
+/* SAM_LISTING_BEGIN_0 */
+void BenchmarkRosenbrockW() {
+  // Allen-Cahn equation u_t = eps * Laplace(u) + u - u^3 on the unit square
+  // with homogeneous Neumann boundary conditions. Linear finite elements with
+  // mass lumping on a triangular tensor product mesh with n x n squares yield
+  // the ODE u' = Lu + u - u^3, where L is the five-point finite difference
+  // Laplacian (times eps) at the (n+1)^2 nodes, with mirrored values at the
+  // boundary.
+  const double eps = 1.0E-3;
+  const double T = 1.0;
+  auto u0 = [eps](Eigen::Vector2d x) {
+    return std::tanh((0.3 - (x - Eigen::Vector2d(0.5, 0.5)).norm()) /
+                     std::sqrt(2.0 * eps));
+  };
+
+  std::cout << "Allen-Cahn equation, T = " << T << ", times in seconds\n"
+            << std::setw(8) << "dofs" << std::setw(8) << "steps"
+            << std::setw(8) << "jacs" << std::setw(8) << "facs"
+            << std::setw(14) << "W-method" << std::setw(14) << "no reuse"
+            << std::setw(14) << "dense" << std::endl;
+  for (int n : {16, 32, 64, 128, 256}) {
+    const int N_dofs = (n + 1) * (n + 1);
+    const double h = 1.0 / n;
+    auto idx = [n](int i, int j) { return i + j * (n + 1); };
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(5 * N_dofs);
+    for (int j = 0; j <= n; ++j) {
+      for (int i = 0; i <= n; ++i) {
+        // Second differences in x and y direction, a missing neighbour is
+        // replaced by the one on the opposite side
+        for (int dir = 0; dir < 2; ++dir) {
+          const int k = dir == 0 ? i : j;
+          auto neighbour = [&](int step) {
+            return dir == 0 ? idx(i + step, j) : idx(i, j + step);
+          };
+          const int lower = k > 0 ? neighbour(-1) : neighbour(1);
+          const int upper = k < n ? neighbour(1) : neighbour(-1);
+          triplets.emplace_back(idx(i, j), lower, eps / (h * h));
+          triplets.emplace_back(idx(i, j), upper, eps / (h * h));
+          triplets.emplace_back(idx(i, j), idx(i, j), -2.0 * eps / (h * h));
+        }
+      }
+    }
+    Eigen::SparseMatrix<double> L(N_dofs, N_dofs);
+    L.setFromTriplets(triplets.begin(), triplets.end());
+
+    auto f = [&L](const Eigen::VectorXd &u) -> Eigen::VectorXd {
+      return L * u + u - u.array().cube().matrix();
+    };
+    auto df = [&L](const Eigen::VectorXd &u) {
+      Eigen::SparseMatrix<double> J = L;
+      J.diagonal().array() += 1.0 - 3.0 * u.array().square();
+      return J;
+    };
+    Eigen::VectorXd mu0(N_dofs);
+    for (int j = 0; j <= n; ++j) {
+      for (int i = 0; i <= n; ++i) {
+        mu0[idx(i, j)] = u0(Eigen::Vector2d(i * h, j * h));
+      }
+    }
+
+    // Sparse W-method, with and without reuse of the Jacobian
+    RosenbrockW<> ros2w(1.0E-4, 1.0E-6);
+    RosenbrockW<> ros2(1.0E-4, 1.0E-6, 1);
+    auto start = std::chrono::high_resolution_clock::now();
+    ros2w.solve(f, df, mu0, T, 1.0E-3);
+    auto end = std::chrono::high_resolution_clock::now();
+    const double t_w = std::chrono::duration<double>(end - start).count();
+    start = std::chrono::high_resolution_clock::now();
+    ros2.solve(f, df, mu0, T, 1.0E-3);
+    end = std::chrono::high_resolution_clock::now();
+    const double t_ros = std::chrono::duration<double>(end - start).count();
+    std::cout << std::setw(8) << N_dofs << std::setw(8)
+              << ros2w.stats().accepted << std::setw(8)
+              << ros2w.stats().jacobians << std::setw(8)
+              << ros2w.stats().factorizations << std::setw(14) << t_w
+              << std::setw(14) << t_ros;
+
+    // Dense Jacobians and fixed step size: SolveRosenbrock() with the same
+    // number of steps, only for small problems
+    if (N_dofs <= 1200) {
+      auto df_dense = [&df](const Eigen::VectorXd &u) {
+        return Eigen::MatrixXd(df(u));
+      };
+      start = std::chrono::high_resolution_clock::now();
+      SolveRosenbrock(f, df_dense, mu0, ros2w.stats().accepted, T);
+      end = std::chrono::high_resolution_clock::now();
+      std::cout << std::setw(14)
+                << std::chrono::duration<double>(end - start).count();
+    }
+    std::cout << std::endl;
+  }
+}
+/* SAM_LISTING_END_0 */
+
+}  // namespace SemImpRK
@@ -6,6 +6,8 @@ set(SOURCES
   ${DIR}/semimprk_main.cc
   ${DIR}/semimprk.h
   ${DIR}/semimprk.cc
+  ${DIR}/rosenbrockw.h
+  ${DIR}/rosenbrockwbenchmark.cc
 )
 
 set(LIBRARIES
@@ -11,6 +11,15 @@
 #include <gtest/gtest.h>
 
 #include <Eigen/Core>
+#include <Eigen/LU>
+#include <Eigen/SparseCholesky>
+#include <Eigen/SparseCore>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "../rosenbrockw.h"
 
 namespace SemImpRK::test {
 
@@ -45,4 +54,102 @@ TEST(SemImpRK, NumexpBurgersGodunov) {
   ASSERT_NEAR(convergenceRate, convergenceRate_reference, tol);
 }
 
+TEST(SemImpRK, RosenbrockW_dense) {
+  // Limit cycle problem of CvgRosenbrock()
+  Eigen::Matrix2d R;
+  R << 0.0, -1.0, 1.0, 0.0;
+  auto f = [&R](const Eigen::VectorXd &y) -> Eigen::VectorXd {
+    return R * y + (1.0 - y.squaredNorm()) * y;
+  };
+  auto df = [&R](const Eigen::VectorXd &y) -> Eigen::MatrixXd {
+    return R + (1.0 - y.squaredNorm()) * Eigen::Matrix2d::Identity() -
+           2.0 * y * y.transpose();
+  };
+  Eigen::Vector2d y0(1.0, 1.0);
+  double T = 10.0;
+
+  Eigen::VectorXd yT_reference = SolveRosenbrock(f, df, y0, 20000, T).back();
+  RosenbrockW<Eigen::PartialPivLU<Eigen::MatrixXd>> ros2w(1.0e-8, 1.0e-10);
+  unsigned int calls = 0;
+  Eigen::VectorXd yT = ros2w.solve(f, df, y0, T, 0.01,
+                                   [&calls](double, const Eigen::VectorXd &) {
+                                     ++calls;
+                                   });
+
+  double tol = 1.0e-5;
+  ASSERT_NEAR(0.0, (yT - yT_reference).lpNorm<Eigen::Infinity>(), tol);
+  ASSERT_EQ(calls, ros2w.stats().accepted + 1);
+  ASSERT_LT(ros2w.stats().jacobians, ros2w.stats().accepted);
+}
+
+TEST(SemImpRK, RosenbrockW_sparse) {
+  // Method of lines for u_t = u_xx + u - u^3 on (0,1), zero boundary values
+  const int d = 99;
+  const double hx = 1.0 / (d + 1);
+  std::vector<Eigen::Triplet<double>> triplets;
+  for (int i = 0; i < d; ++i) {
+    triplets.emplace_back(i, i, -2.0 / (hx * hx));
+    if (i > 0) triplets.emplace_back(i, i - 1, 1.0 / (hx * hx));
+    if (i < d - 1) triplets.emplace_back(i, i + 1, 1.0 / (hx * hx));
+  }
+  Eigen::SparseMatrix<double> L(d, d);
+  L.setFromTriplets(triplets.begin(), triplets.end());
+  auto f = [&L](const Eigen::VectorXd &y) -> Eigen::VectorXd {
+    return L * y + y - y.array().cube().matrix();
+  };
+  auto df = [&L](const Eigen::VectorXd &y) {
+    Eigen::SparseMatrix<double> J = L;
+    J.diagonal().array() += 1.0 - 3.0 * y.array().square();
+    return J;
+  };
+  auto df_dense = [&df](const Eigen::VectorXd &y) {
+    return Eigen::MatrixXd(df(y));
+  };
+  const Eigen::VectorXd y0 = Eigen::VectorXd::Ones(d);
+  double T = 0.5;
+
+  RosenbrockW<> ros2w_lu(1.0e-4, 1.0e-6);
+  RosenbrockW<Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>>> ros2w_ldlt(
+      1.0e-4, 1.0e-6);
+  RosenbrockW<Eigen::PartialPivLU<Eigen::MatrixXd>> ros2w_dense(1.0e-4,
+                                                                1.0e-6);
+  Eigen::VectorXd yT_lu = ros2w_lu.solve(f, df, y0, T, 1.0e-4);
+  Eigen::VectorXd yT_ldlt = ros2w_ldlt.solve(f, df, y0, T, 1.0e-4);
+  Eigen::VectorXd yT_dense = ros2w_dense.solve(f, df_dense, y0, T, 1.0e-4);
+  Eigen::VectorXd yT_reference = SolveRosenbrock(f, df, y0, 5000, T).back();
+
+  double tol = 1.0e-9;
+  ASSERT_NEAR(0.0, (yT_lu - yT_dense).lpNorm<Eigen::Infinity>(), tol);
+  ASSERT_NEAR(0.0, (yT_ldlt - yT_dense).lpNorm<Eigen::Infinity>(), tol);
+  ASSERT_NEAR(0.0, (yT_lu - yT_reference).lpNorm<Eigen::Infinity>(), 1.0e-4);
+  // the stiff problem is solved without step size restriction, and the
+  // Jacobian is reused
+  ASSERT_LT(ros2w_lu.stats().accepted, 2000);
+  ASSERT_LT(5 * ros2w_lu.stats().jacobians, ros2w_lu.stats().accepted);
+}
+
+TEST(SemImpRK, RosenbrockW_failure) {
+  auto df = [](const Eigen::VectorXd &y) -> Eigen::MatrixXd {
+    return -Eigen::MatrixXd::Identity(y.size(), y.size());
+  };
+  Eigen::Vector2d y0(1.0, 1.0);
+
+  // A NaN in the right-hand side must not make the step size loop forever
+  auto f_nan = [](const Eigen::VectorXd &y) -> Eigen::VectorXd {
+    return Eigen::VectorXd::Constant(y.size(),
+                                     std::numeric_limits<double>::quiet_NaN());
+  };
+  RosenbrockW<Eigen::PartialPivLU<Eigen::MatrixXd>> ros2w(1.0e-8, 1.0e-10);
+  ASSERT_THROW(ros2w.solve(f_nan, df, y0, 1.0, 0.01), std::runtime_error);
+
+  // Blow-up of y' = 100 y^2 requires step sizes below hmin
+  auto f_blowup = [](const Eigen::VectorXd &y) -> Eigen::VectorXd {
+    return 100.0 * y.array().square();
+  };
+  RosenbrockW<Eigen::PartialPivLU<Eigen::MatrixXd>> ros2w_hmin(1.0e-8, 1.0e-10,
+                                                               10, 0.5);
+  ASSERT_THROW(ros2w_hmin.solve(f_blowup, df, y0, 1.0, 0.1),
+               std::runtime_error);
+}
+
 }  // namespace SemImpRK::test
@@ -33,6 +33,11 @@ std::vector<Eigen::VectorXd> SolveRosenbrock(Func &&f, Jac &&df,
 
 double CvgRosenbrock();
 
+// Compares the sparse W-method RosenbrockW (see rosenbrockw.h) with
+// SolveRosenbrock() for a lumped finite element discretization of the 2D
+// Allen-Cahn equation
+void BenchmarkRosenbrockW();
+
 }  // namespace SemImpRK
 
 #endif  // #ifndef SEMIMPRK_H_
@@ -31,5 +31,7 @@ int main() {
   double cvgRate = SemImpRK::CvgRosenbrock();
   std::cout << "Convergence rate: " << cvgRate << std::endl;
 
+  SemImpRK::BenchmarkRosenbrockW();
+
   return 0;
 }
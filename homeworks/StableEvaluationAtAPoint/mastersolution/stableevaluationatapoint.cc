@@ -17,9 +17,16 @@
 
 #include <Eigen/Core>
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <iomanip>
 #include <iostream>
 #include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../../../lecturecodes/helperfiles/parallelchunks.h"
 
 namespace StableEvaluationAtAPoint {
 
@@ -183,6 +190,193 @@ double StablePointEvaluation(
   return res;
 }
 
+BatchEvaluator::BatchEvaluator(
+    std::shared_ptr<lf::uscalfe::FeSpaceLagrangeO1<double>> fe_space)
+    : fe_space_(std::move(fe_space)) {
+  std::shared_ptr<const lf::mesh::Mesh> mesh_p = fe_space_->Mesh();
+
+  // Boundary edges
+  auto bd_flags_edge{lf::mesh::utils::flagEntitiesOnBoundary(mesh_p, 1)};
+  std::vector<const lf::mesh::Entity *> bd_edges;
+  for (const lf::mesh::Entity *e : mesh_p->Entities(1)) {
+    if (bd_flags_edge(*e)) bd_edges.push_back(e);
+  }
+  const Eigen::Index B = bd_edges.size();
+  bd_mid_.resize(2, B);
+  bd_len_.resize(B);
+  bd_normal_.resize(2, B);
+  bd_mid_dot_normal_.resize(B);
+  for (Eigen::Index e = 0; e < B; ++e) {
+    const lf::geometry::Geometry *geo_ptr = bd_edges[e]->Geometry();
+    const Eigen::Matrix2d corners = lf::geometry::Corners(*geo_ptr);
+    bd_mid_.col(e) = 0.5 * (corners.col(0) + corners.col(1));
+    bd_len_[e] = lf::geometry::Volume(*geo_ptr);
+    bd_normal_.col(e) = OuterNormalUnitSquare(bd_mid_.col(e));
+    bd_mid_dot_normal_[e] = bd_mid_.col(e).dot(bd_normal_.col(e));
+  }
+
+  // Quadrature points in the cells, only those where Psi is not constant
+  Psi psi(Eigen::Vector2d(0.5, 0.5));
+  const lf::quad::QuadRule qr = lf::quad::make_TriaQR_MidpointRule();
+  const Eigen::MatrixXd zeta_ref{qr.Points()};
+  const Eigen::VectorXd w_ref{qr.Weights()};
+  const lf::base::size_type P = qr.NumPoints();
+  std::vector<Eigen::Vector2d> pts;
+  std::vector<double> w;
+  std::vector<Eigen::Vector2d> grad_psi;
+  std::vector<double> lapl_psi;
+  for (const lf::mesh::Entity *cell : mesh_p->Entities(0)) {
+    const lf::geometry::Geometry &geo{*cell->Geometry()};
+    const Eigen::MatrixXd zeta{geo.Global(zeta_ref)};
+    const Eigen::VectorXd gram_dets{geo.IntegrationElement(zeta_ref)};
+    bool active = false;
+    for (lf::base::size_type l = 0; l < P; ++l) {
+      const Eigen::Vector2d g = psi.grad(zeta.col(l));
+      const double lapl = psi.lapl(zeta.col(l));
+      active = active || g.squaredNorm() > 0.0 || lapl != 0.0;
+    }
+    if (!active) continue;
+    // Keep all points of the cell, so that the values of uFE can be fetched
+    // cell by cell
+    cells_.push_back(cell);
+    for (lf::base::size_type l = 0; l < P; ++l) {
+      pts.emplace_back(zeta.col(l));
+      w.push_back(w_ref[l] * gram_dets[l]);
+      grad_psi.push_back(psi.grad(zeta.col(l)));
+      lapl_psi.push_back(psi.lapl(zeta.col(l)));
+    }
+  }
+  const Eigen::Index Q = pts.size();
+  vol_pts_.resize(2, Q);
+  vol_w_.resize(Q);
+  vol_grad_psi_.resize(2, Q);
+  vol_lapl_psi_.resize(Q);
+  for (Eigen::Index q = 0; q < Q; ++q) {
+    vol_pts_.col(q) = pts[q];
+    vol_w_[q] = w[q];
+    vol_grad_psi_.col(q) = grad_psi[q];
+    vol_lapl_psi_[q] = lapl_psi[q];
+  }
+}
+
+/* SAM_LISTING_BEGIN_5 */
+Eigen::VectorXd BatchEvaluator::SingleLayer(const Eigen::VectorXd &weights,
+                                            const Eigen::Matrix2Xd &X,
+                                            unsigned int threads) const {
+  Eigen::VectorXd values(X.cols());
+  // G_x(y) = -log(|x - y|^2) / (4 pi)
+  auto eval = [&](unsigned int /*t*/, Eigen::Index begin, Eigen::Index end) {
+    Eigen::ArrayXd r2(bd_len_.size());
+    for (Eigen::Index i = begin; i < end; ++i) {
+      r2 = (bd_mid_.colwise() - X.col(i)).colwise().squaredNorm().transpose();
+      values[i] = -(weights.array() * r2.log()).sum() / (4.0 * M_PI);
+    }
+  };
+  parallelChunks(X.cols(), threads, eval);
+  return values;
+}
+
+Eigen::VectorXd BatchEvaluator::DoubleLayer(const Eigen::VectorXd &weights,
+                                            const Eigen::Matrix2Xd &X,
+                                            unsigned int threads) const {
+  Eigen::VectorXd values(X.cols());
+  // grad(G_x)(m).n = (x - m).n / (2 pi |x - m|^2)
+  auto eval = [&](unsigned int /*t*/, Eigen::Index begin, Eigen::Index end) {
+    Eigen::ArrayXd r2(bd_len_.size());
+    for (Eigen::Index i = begin; i < end; ++i) {
+      r2 = (bd_mid_.colwise() - X.col(i)).colwise().squaredNorm().transpose();
+      values[i] = (weights.array() *
+                   (X(0, i) * bd_normal_.row(0).transpose().array() +
+                    X(1, i) * bd_normal_.row(1).transpose().array() -
+                    bd_mid_dot_normal_) /
+                   r2)
+                      .sum() /
+                  (2.0 * M_PI);
+    }
+  };
+  parallelChunks(X.cols(), threads, eval);
+  return values;
+}
+
+Eigen::VectorXd BatchEvaluator::Jstar(const Eigen::VectorXd &uFE,
+                                      const Eigen::Matrix2Xd &X,
+                                      unsigned int threads) const {
+  Eigen::VectorXd values(X.cols());
+  // Values of uFE at the quadrature points, fetched once for all x
+  const Eigen::Index Q = vol_w_.size();
+  const Eigen::Index P = cells_.empty() ? 0 : Q / cells_.size();
+  const lf::quad::QuadRule qr = lf::quad::make_TriaQR_MidpointRule();
+  const Eigen::MatrixXd zeta_ref{qr.Points()};
+  auto uFE_mf = lf::fe::MeshFunctionFE(fe_space_, uFE);
+  Eigen::ArrayXd wu(Q);
+  for (std::size_t k = 0; k < cells_.size(); ++k) {
+    auto u_vals = uFE_mf(*cells_[k], zeta_ref);
+    for (Eigen::Index l = 0; l < P; ++l) {
+      wu[k * P + l] = -vol_w_[k * P + l] * u_vals[l];
+    }
+  }
+  // The integrand -u (2 grad(G_x).grad(Psi) + G_x lapl(Psi)) is
+  //   a G_x + b.(x - y) / (2 pi |x - y|^2)
+  // with a = -u lapl(Psi) and b = -2 u grad(Psi), which do not depend on x
+  const Eigen::ArrayXd a = wu * vol_lapl_psi_;
+  const Eigen::ArrayXd b0 = 2.0 * wu * vol_grad_psi_.row(0).transpose().array();
+  const Eigen::ArrayXd b1 = 2.0 * wu * vol_grad_psi_.row(1).transpose().array();
+  const Eigen::ArrayXd yb = b0 * vol_pts_.row(0).transpose().array() +
+                            b1 * vol_pts_.row(1).transpose().array();
+  auto eval = [&](unsigned int /*t*/, Eigen::Index begin, Eigen::Index end) {
+    Eigen::ArrayXd r2(Q);
+    for (Eigen::Index i = begin; i < end; ++i) {
+      r2 = (vol_pts_.colwise() - X.col(i)).colwise().squaredNorm().transpose();
+      values[i] = -(a * r2.log()).sum() / (4.0 * M_PI) +
+                  ((X(0, i) * b0 + X(1, i) * b1 - yb) / r2).sum() /
+                      (2.0 * M_PI);
+    }
+  };
+  parallelChunks(X.cols(), threads, eval);
+  return values;
+}
+/* SAM_LISTING_END_5 */
+
+void BenchmarkBatchEvaluation(
+    std::shared_ptr<lf::uscalfe::FeSpaceLagrangeO1<double>> fe_space,
+    const Eigen::VectorXd &uFE) {
+  using clock = std::chrono::steady_clock;
+  auto elapsed = [](clock::time_point start) -> double {
+    return std::chrono::duration<double, std::milli>(clock::now() - start)
+        .count();
+  };
+  // Grid of points in the disk of radius 0.25 around (0.5, 0.5)
+  const int n = 40;
+  std::vector<Eigen::Vector2d> points;
+  for (int i = 0; i <= n; ++i) {
+    for (int j = 0; j <= n; ++j) {
+      const Eigen::Vector2d x(0.25 + 0.5 * i / n, 0.25 + 0.5 * j / n);
+      if ((x - Eigen::Vector2d(0.5, 0.5)).norm() <= 0.25) points.push_back(x);
+    }
+  }
+  Eigen::Matrix2Xd X(2, points.size());
+  for (std::size_t k = 0; k < points.size(); ++k) X.col(k) = points[k];
+
+  clock::time_point start = clock::now();
+  Eigen::VectorXd single(X.cols());
+  for (Eigen::Index k = 0; k < X.cols(); ++k) {
+    single[k] = Jstar(fe_space, uFE, X.col(k));
+  }
+  const double ms_single = elapsed(start);
+
+  const unsigned int threads =
+      std::max(1u, std::thread::hardware_concurrency());
+  start = clock::now();
+  const BatchEvaluator batch(fe_space);
+  const Eigen::VectorXd batched = batch.Jstar(uFE, X, threads);
+  const double ms_batch = elapsed(start);
+
+  std::cout << "Jstar at " << X.cols() << " points: " << std::setw(10)
+            << ms_single << " ms point by point, " << std::setw(10) << ms_batch
+            << " ms batched (" << threads << " threads), max difference "
+            << (single - batched).lpNorm<Eigen::Infinity>() << std::endl;
+}
+
 double EvaluateFEFunction(
     std::shared_ptr<lf::uscalfe::FeSpaceLagrangeO1<double>> fe_space,
     const Eigen::VectorXd &uFE, Eigen::Vector2d global, double tol) {
@@ -214,4 +408,17 @@ double EvaluateFEFunction(
   return 0.0;
 }
 
-}  // namespace StableEvaluationAtAPoint
\ No newline at end of file
+double EvaluateFEFunction(
+    std::shared_ptr<lf::uscalfe::FeSpaceLagrangeO1<double>> fe_space,
+    const Eigen::VectorXd &uFE,
+    const ConvectionDiffusion::PointLocator &locator, Eigen::Vector2d global) {
+  LF_ASSERT_MSG(locator.Mesh() == fe_space->Mesh(),
+                "PointLocator built for a different mesh");
+  // wrap coefficient vector into a FE mesh-function
+  lf::fe::MeshFunctionFE mf(fe_space, uFE);
+
+  const auto [entity_p, loc] = locator.Locate(global);
+  return entity_p != nullptr ? mf(*entity_p, loc)[0] : 0.0;
+}
+
+}  // namespace StableEvaluationAtAPoint
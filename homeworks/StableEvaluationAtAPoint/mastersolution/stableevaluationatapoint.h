@@ -22,6 +22,9 @@
 #include <Eigen/SparseLU>
 #include <memory>
 #include <utility>
+#include <vector>
+
+#include "../../../lecturecodes/ConvectionDiffusion/point_locator.h"
 
 namespace StableEvaluationAtAPoint {
 
@@ -168,6 +171,84 @@ double StablePointEvaluation(
     std::shared_ptr<lf::uscalfe::FeSpaceLagrangeO1<double>> fe_space,
     Eigen::VectorXd uFE, const Eigen::Vector2d x);
 
+/**
+ * @brief Evaluates PSL, PDL and Jstar at many points at once
+ *
+ * The constructor precomputes everything that does not depend on the
+ * evaluation point:
+ * - midpoints, lengths and outer normals of the boundary edges,
+ * - the quadrature points and weights of the midpoint rule in the cells
+ *   where Psi is not constant, together with grad(Psi) and lapl(Psi) there.
+ * Psi is constant outside of the annulus sqrt(2)/4 < |y - (0.5, 0.5)| < 0.5,
+ * so all other cells do not contribute to Jstar.
+ *
+ * For every evaluation point the contributions of G_x are then summed up by
+ * an array expression over all quadrature points. The evaluation points are
+ * distributed over threads.
+ *
+ * @warning Same assumptions as PSL, PDL and Jstar: triangular mesh of the
+ * **unit square**
+ */
+class BatchEvaluator {
+ public:
+  explicit BatchEvaluator(
+      std::shared_ptr<lf::uscalfe::FeSpaceLagrangeO1<double>> fe_space);
+
+  /** @brief PSL(mesh_p, v, X.col(i)) for all columns of X */
+  template <typename FUNCTOR>
+  Eigen::VectorXd PSL(FUNCTOR &&v, const Eigen::Matrix2Xd &X,
+                      unsigned int threads = 1) const {
+    Eigen::VectorXd weights(bd_len_.size());
+    for (Eigen::Index e = 0; e < bd_len_.size(); ++e) {
+      weights[e] = v(Eigen::Vector2d(bd_mid_.col(e))) * bd_len_[e];
+    }
+    return SingleLayer(weights, X, threads);
+  }
+  /** @brief PDL(mesh_p, v, X.col(i)) for all columns of X */
+  template <typename FUNCTOR>
+  Eigen::VectorXd PDL(FUNCTOR &&v, const Eigen::Matrix2Xd &X,
+                      unsigned int threads = 1) const {
+    Eigen::VectorXd weights(bd_len_.size());
+    for (Eigen::Index e = 0; e < bd_len_.size(); ++e) {
+      weights[e] = v(Eigen::Vector2d(bd_mid_.col(e))) * bd_len_[e];
+    }
+    return DoubleLayer(weights, X, threads);
+  }
+  /** @brief Jstar(fe_space, uFE, X.col(i)) for all columns of X */
+  Eigen::VectorXd Jstar(const Eigen::VectorXd &uFE, const Eigen::Matrix2Xd &X,
+                        unsigned int threads = 1) const;
+
+ private:
+  // sum_e weights[e] * G_x(m_e) and sum_e weights[e] * grad(G_x)(m_e).n_e
+  Eigen::VectorXd SingleLayer(const Eigen::VectorXd &weights,
+                              const Eigen::Matrix2Xd &X,
+                              unsigned int threads) const;
+  Eigen::VectorXd DoubleLayer(const Eigen::VectorXd &weights,
+                              const Eigen::Matrix2Xd &X,
+                              unsigned int threads) const;
+
+  std::shared_ptr<lf::uscalfe::FeSpaceLagrangeO1<double>> fe_space_;
+  // Boundary edges: midpoints, lengths, outer normals, m_e.n_e
+  Eigen::Matrix2Xd bd_mid_;
+  Eigen::VectorXd bd_len_;
+  Eigen::Matrix2Xd bd_normal_;
+  Eigen::ArrayXd bd_mid_dot_normal_;
+  // Cells in which Psi is not constant and their quadrature points
+  std::vector<const lf::mesh::Entity *> cells_;
+  Eigen::Matrix2Xd vol_pts_;
+  Eigen::ArrayXd vol_w_;  // weights times Gram determinants
+  Eigen::Matrix2Xd vol_grad_psi_;
+  Eigen::ArrayXd vol_lapl_psi_;
+};
+
+/**
+ * @brief Times Jstar and BatchEvaluator::Jstar for a grid of points in the
+ * disk of radius 0.25 around (0.5, 0.5)
+ */
+void BenchmarkBatchEvaluation(
+    std::shared_ptr<lf::uscalfe::FeSpaceLagrangeO1<double>> fe_space,
+    const Eigen::VectorXd &uFE);
+
 /** @brief Solves the Laplace equation using Dirichlet conditions g */
 template <typename FUNCTOR>
 Eigen::VectorXd SolveBVP(
@@ -237,6 +318,15 @@ double EvaluateFEFunction(
     std::shared_ptr<lf::uscalfe::FeSpaceLagrangeO1<double>> fe_space,
     const Eigen::VectorXd &uFE, Eigen::Vector2d global, double tol = 10E-10);
 
+/**
+ * @brief Same as above, locating the point with a PointLocator built once
+ * for the mesh of fe_space
+ */
+double EvaluateFEFunction(
+    std::shared_ptr<lf::uscalfe::FeSpaceLagrangeO1<double>> fe_space,
+    const Eigen::VectorXd &uFE,
+    const ConvectionDiffusion::PointLocator &locator, Eigen::Vector2d global);
+
 /** @brief Returns the result of evaluating u_h(x) directly or by the stable
  * scheme */
 template <typename FUNCTOR>
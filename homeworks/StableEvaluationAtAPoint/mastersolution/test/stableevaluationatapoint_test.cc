@@ -109,6 +109,76 @@ TEST(StableEvaluationAtAPoint, Jstar) {
   ASSERT_NEAR(val, ref_val, tol);
 }
 
+TEST(StableEvaluationAtAPoint, EvaluateFEFunction) {
+  auto mesh_factory_init = std::make_unique<lf::mesh::hybrid2d::MeshFactory>(2);
+  lf::io::GmshReader reader_init(std::move(mesh_factory_init),
+                                 CURRENT_SOURCE_DIR
+                                 "/../../meshes/square7.msh");
+  std::shared_ptr<lf::mesh::Mesh> mesh_p = reader_init.mesh();
+
+  std::shared_ptr<lf::uscalfe::FeSpaceLagrangeO1<double>> fe_space =
+      std::make_shared<lf::uscalfe::FeSpaceLagrangeO1<double>>(mesh_p);
+
+  const auto u = [](Eigen::Vector2d x) -> double {
+    Eigen::Vector2d one(1.0, 0.0);
+    return std::log((x + one).norm());
+  };
+
+  lf::mesh::utils::MeshFunctionGlobal mf_u{u};
+  Eigen::VectorXd uFE = lf::fe::NodalProjection(*fe_space, mf_u);
+
+  // The point locator gives the same values as the search over all cells,
+  // also for corners of the domain and points outside
+  const ConvectionDiffusion::PointLocator locator(mesh_p);
+  double tol = 1.e-12;
+  for (Eigen::Vector2d x :
+       {Eigen::Vector2d(0.3, 0.4), Eigen::Vector2d(0.0, 0.0),
+        Eigen::Vector2d(1.0, 1.0), Eigen::Vector2d(0.5, 0.999),
+        Eigen::Vector2d(1.5, 0.5)}) {
+    double val = StableEvaluationAtAPoint::EvaluateFEFunction(fe_space, uFE,
+                                                              locator, x);
+    double ref_val =
+        StableEvaluationAtAPoint::EvaluateFEFunction(fe_space, uFE, x);
+    ASSERT_NEAR(val, ref_val, tol);
+  }
+}
+
+TEST(StableEvaluationAtAPoint, BatchEvaluator) {
+  auto mesh_factory_init = std::make_unique<lf::mesh::hybrid2d::MeshFactory>(2);
+  lf::io::GmshReader reader_init(std::move(mesh_factory_init),
+                                 CURRENT_SOURCE_DIR
+                                 "/../../meshes/square7.msh");
+  std::shared_ptr<lf::mesh::Mesh> mesh_p = reader_init.mesh();
+
+  std::shared_ptr<lf::uscalfe::FeSpaceLagrangeO1<double>> fe_space =
+      std::make_shared<lf::uscalfe::FeSpaceLagrangeO1<double>>(mesh_p);
+
+  const auto u = [](Eigen::Vector2d x) -> double {
+    Eigen::Vector2d one(1.0, 0.0);
+    return std::log((x + one).norm());
+  };
+
+  lf::mesh::utils::MeshFunctionGlobal mf_u{u};
+  Eigen::VectorXd uFE = lf::fe::NodalProjection(*fe_space, mf_u);
+
+  Eigen::Matrix2Xd X(2, 4);
+  X << 0.3, 0.5, 0.6, 0.45, 0.4, 0.5, 0.35, 0.7;
+
+  const StableEvaluationAtAPoint::BatchEvaluator batch(fe_space);
+  for (unsigned int threads : {1u, 3u}) {
+    const Eigen::VectorXd psl = batch.PSL(u, X, threads);
+    const Eigen::VectorXd pdl = batch.PDL(u, X, threads);
+    const Eigen::VectorXd jstar = batch.Jstar(uFE, X, threads);
+    for (Eigen::Index i = 0; i < X.cols(); ++i) {
+      const Eigen::Vector2d x = X.col(i);
+      EXPECT_NEAR(psl[i], StableEvaluationAtAPoint::PSL(mesh_p, u, x), 1.e-12);
+      EXPECT_NEAR(pdl[i], StableEvaluationAtAPoint::PDL(mesh_p, u, x), 1.e-12);
+      EXPECT_NEAR(jstar[i], StableEvaluationAtAPoint::Jstar(fe_space, uFE, x),
+                  1.e-12);
+    }
+  }
+}
+
 /*
 TEST(StableEvaluationAtAPoint, stab_pointEval) {
   auto mesh_factory_init = std::make_unique<lf::mesh::hybrid2d::MeshFactory>(2);
@@ -20,4 +20,5 @@ set(LIBRARIES
   LF::lf.mesh.utils
   LF::lf.quad
   LF::lf.uscalfe
+  Threads::Threads
 )
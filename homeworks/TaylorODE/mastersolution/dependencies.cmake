@@ -6,6 +6,8 @@ set(SOURCES
   ${DIR}/taylorode_main.cc
   ${DIR}/taylorode.h
   ${DIR}/taylorode.cc
+  ${DIR}/taylorintegrator.h
+  ${DIR}/taylorseries.h
 )
 
 
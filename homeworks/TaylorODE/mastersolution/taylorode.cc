@@ -9,11 +9,14 @@
 #include "taylorode.h"
 
 #include <Eigen/Core>
+#include <chrono>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
 #include <vector>
 
+#include "taylorintegrator.h"
+
 namespace TaylorODE {
 
 /* SAM_LISTING_BEGIN_1 */
@@ -119,4 +122,48 @@ void PrintErrorTable(const Eigen::ArrayXd& M, const Eigen::ArrayXd& error) {
   }
 }
 
+/* SAM_LISTING_BEGIN_3 */
+void BenchmarkTaylorIntegrator() {
+  // Same setting as in TestCvgTaylorMethod()
+  const double T = 10;
+  const Eigen::Vector2d y0(100, 5);
+  const Eigen::Vector2d yex(0.319465882659820, 9.730809352326228);
+  const PredPreyModel model(3.0, 2.0, 0.1, 0.1);
+  auto f = [&model](const auto& y) { return model.f(y); };
+
+  // Average run time of solver() in microseconds
+  auto time = [](auto&& solver) {
+    const int runs = 20;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < runs; ++r) solver();
+    auto end = std::chrono::high_resolution_clock::now();
+    return 1.0E6 * std::chrono::duration<double>(end - start).count() / runs;
+  };
+
+  std::cout << "\nPredator-prey model, error at T = " << T << std::endl
+            << std::setw(28) << "method" << std::setw(10) << "steps"
+            << std::setw(15) << "error" << std::setw(15) << "time [us]"
+            << std::endl;
+  for (unsigned int M : {128, 1024, 8192}) {
+    Eigen::Vector2d yT;
+    const double t =
+        time([&] { yT = SolvePredPreyTaylor(model, T, y0, M).back(); });
+    std::cout << std::setw(28) << "SolvePredPreyTaylor" << std::setw(10) << M
+              << std::setw(15) << (yT - yex).norm() << std::setw(15) << t
+              << std::endl;
+  }
+  for (unsigned int p : {5, 10, 15, 20}) {
+    for (double tol : {1.0E-6, 1.0E-10, 1.0E-14}) {
+      TaylorIntegrator<20> taylor(p, tol);
+      Eigen::Vector2d yT;
+      const double t = time([&] { yT = taylor.solve(f, T, y0); });
+      std::cout << std::setw(12) << "Taylor p = " << std::setw(2) << p
+                << ", tol = " << std::setw(5) << tol << std::setw(10)
+                << taylor.steps() << std::setw(15) << (yT - yex).norm()
+                << std::setw(15) << t << std::endl;
+    }
+  }
+}
+/* SAM_LISTING_END_3 */
+
 }  // namespace TaylorODE
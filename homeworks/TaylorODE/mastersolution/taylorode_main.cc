@@ -15,5 +15,7 @@ int main() {
   double convRate = TaylorODE::TestCvgTaylorMethod();
   std::cout << "Estimated rate of convergence: " << convRate << std::endl;
   std::cout << "Expected rate of convergence: " << 3.0 << std::endl;
+
+  TaylorODE::BenchmarkTaylorIntegrator();
   return 0;
 }
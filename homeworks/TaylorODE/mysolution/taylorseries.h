@@ -0,0 +1,170 @@
+#ifndef TAYLORSERIES_H
+#define TAYLORSERIES_H
+/**
+ * @file taylorseries.h
+ * @brief NPDE homework TaylorODE
+ * @author agent
+ * @date 18.10.2026
+ * @copyright Developed at ETH Zurich
+ */
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+
+namespace TaylorODE {
+
+/**
+ * @brief Truncated power series a(t) = a_0 + a_1 t + ... + a_d t^d with
+ * degree d <= N, for forward mode automatic differentiation.
+ *
+ * The arithmetic operations and elementary functions compute the Taylor
+ * coefficients of the result up to the larger degree of the arguments by the
+ * usual recurrences. Constants are series of degree 0, so that a function
+ * template written for double also works for TaylorSeries<N>.
+ *
+ * @tparam N maximal degree; the coefficients are stored in a fixed-size array
+ */
+template <int N>
+class TaylorSeries {
+ public:
+  /** @brief Constant series */
+  TaylorSeries(double c0 = 0.0) : d_(0) { c_[0] = c0; }
+
+  int degree() const { return d_; }
+
+  /** @brief Sets the degree; raising it appends zero coefficients, lowering
+   * it truncates the series */
+  void setDegree(int d) {
+    assert(0 <= d && d <= N && "Degree out of range.");
+    if (d > d_) std::fill(c_.begin() + d_ + 1, c_.begin() + d + 1, 0.0);
+    d_ = d;
+  }
+
+  /** @brief Coefficient k, zero for k > degree() */
+  double operator[](int k) const { return k <= d_ ? c_[k] : 0.0; }
+  double& operator[](int k) {
+    assert(k <= d_ && "Coefficient beyond the degree.");
+    return c_[k];
+  }
+
+  TaylorSeries& operator+=(const TaylorSeries& b) {
+    extend(b.d_);
+    for (int k = 0; k <= b.d_; ++k) c_[k] += b.c_[k];
+    return *this;
+  }
+  TaylorSeries& operator-=(const TaylorSeries& b) {
+    extend(b.d_);
+    for (int k = 0; k <= b.d_; ++k) c_[k] -= b.c_[k];
+    return *this;
+  }
+  TaylorSeries& operator*=(double s) {
+    for (int k = 0; k <= d_; ++k) c_[k] *= s;
+    return *this;
+  }
+
+  TaylorSeries operator-() const {
+    TaylorSeries r = *this;
+    r *= -1.0;
+    return r;
+  }
+
+  friend TaylorSeries operator+(TaylorSeries a, const TaylorSeries& b) {
+    return a += b;
+  }
+  friend TaylorSeries operator-(TaylorSeries a, const TaylorSeries& b) {
+    return a -= b;
+  }
+
+  /** @brief Cauchy product, truncated at the larger degree */
+  friend TaylorSeries operator*(const TaylorSeries& a, const TaylorSeries& b) {
+    if (a.d_ == 0) return b * a.c_[0];
+    if (b.d_ == 0) return a * b.c_[0];
+    TaylorSeries r;
+    r.d_ = std::max(a.d_, b.d_);
+    for (int k = 0; k <= r.d_; ++k) {
+      double s = 0.0;
+      for (int j = std::max(0, k - b.d_); j <= std::min(k, a.d_); ++j) {
+        s += a.c_[j] * b.c_[k - j];
+      }
+      r.c_[k] = s;
+    }
+    return r;
+  }
+  friend TaylorSeries operator*(TaylorSeries a, double s) { return a *= s; }
+  friend TaylorSeries operator*(double s, TaylorSeries a) { return a *= s; }
+
+  /** @brief Quotient, c_k = (a_k - sum_{j=1}^k b_j c_{k-j}) / b_0 */
+  friend TaylorSeries operator/(const TaylorSeries& a, const TaylorSeries& b) {
+    if (b.d_ == 0) return a * (1.0 / b.c_[0]);
+    TaylorSeries r;
+    r.d_ = std::max(a.d_, b.d_);
+    for (int k = 0; k <= r.d_; ++k) {
+      double s = a[k];
+      for (int j = 1; j <= std::min(k, b.d_); ++j) s -= b.c_[j] * r.c_[k - j];
+      r.c_[k] = s / b.c_[0];
+    }
+    return r;
+  }
+
+  /** @brief exp(a): e_k = 1/k sum_{j=1}^k j a_j e_{k-j} */
+  friend TaylorSeries exp(const TaylorSeries& a) {
+    TaylorSeries r;
+    r.d_ = a.d_;
+    r.c_[0] = std::exp(a.c_[0]);
+    for (int k = 1; k <= a.d_; ++k) {
+      double s = 0.0;
+      for (int j = 1; j <= k; ++j) s += j * a.c_[j] * r.c_[k - j];
+      r.c_[k] = s / k;
+    }
+    return r;
+  }
+
+  /** @brief sqrt(a): s_k = (a_k - sum_{j=1}^{k-1} s_j s_{k-j}) / (2 s_0) */
+  friend TaylorSeries sqrt(const TaylorSeries& a) {
+    TaylorSeries r;
+    r.d_ = a.d_;
+    r.c_[0] = std::sqrt(a.c_[0]);
+    for (int k = 1; k <= a.d_; ++k) {
+      double s = a.c_[k];
+      for (int j = 1; j < k; ++j) s -= r.c_[j] * r.c_[k - j];
+      r.c_[k] = s / (2.0 * r.c_[0]);
+    }
+    return r;
+  }
+
+  /** @brief sin(a) and cos(a) by their coupled recurrences */
+  friend TaylorSeries sin(const TaylorSeries& a) { return sincos(a)[0]; }
+  friend TaylorSeries cos(const TaylorSeries& a) { return sincos(a)[1]; }
+
+ private:
+  static std::array<TaylorSeries, 2> sincos(const TaylorSeries& a) {
+    TaylorSeries s, c;
+    s.d_ = c.d_ = a.d_;
+    s.c_[0] = std::sin(a.c_[0]);
+    c.c_[0] = std::cos(a.c_[0]);
+    for (int k = 1; k <= a.d_; ++k) {
+      double ss = 0.0, cc = 0.0;
+      for (int j = 1; j <= k; ++j) {
+        ss += j * a.c_[j] * c.c_[k - j];
+        cc -= j * a.c_[j] * s.c_[k - j];
+      }
+      s.c_[k] = ss / k;
+      c.c_[k] = cc / k;
+    }
+    return {s, c};
+  }
+
+  // Raises the degree to at least d
+  void extend(int d) {
+    if (d > d_) setDegree(d);
+  }
+
+  int d_;                        // degree
+  std::array<double, N + 1> c_;  // coefficients, valid up to d_
+};
+
+}  // namespace TaylorODE
+
+#endif  // TAYLORSERIES_H
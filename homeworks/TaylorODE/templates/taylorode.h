@@ -9,6 +9,7 @@
  */
 
 #include <Eigen/Dense>
+#include <array>
 #include <vector>
 
 namespace TaylorODE {
@@ -26,6 +27,18 @@ class PredPreyModel {
   /** @brief Evaluate f(y) */
   Eigen::Vector2d f(const Eigen::Vector2d& y) const;
 
+  /**
+   * @brief Evaluate f(y) for a generic scalar type, e.g. TaylorSeries, as
+   * needed by TaylorIntegrator
+   */
+  template <class Scalar>
+  std::array<Scalar, 2> f(const std::array<Scalar, 2>& y) const {
+    //====================
+    // Your code goes here
+    //====================
+    return y;
+  }
+
   /** @brief Evaluate df(y)*z */
   Eigen::Vector2d df(const Eigen::Vector2d& y, const Eigen::Vector2d& z) const;
 
@@ -64,6 +77,12 @@ double TestCvgTaylorMethod();
  */
 void PrintErrorTable(const Eigen::ArrayXd& M, const Eigen::ArrayXd& error);
 
+/**
+ * @brief Compares accuracy and run time of SolvePredPreyTaylor() and the
+ * adaptive TaylorIntegrator of higher orders for the predator-prey model
+ */
+void BenchmarkTaylorIntegrator();
+
 }  // namespace TaylorODE
 
 #endif  // TAYLORODE_H
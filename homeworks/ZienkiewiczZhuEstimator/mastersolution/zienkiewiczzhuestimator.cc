@@ -8,8 +8,12 @@
 #include "zienkiewiczzhuestimator.h"
 
 #define _USE_MATH_DEFINES
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <iomanip>
+#include <string>
+#include <thread>
 // Eigen includes
 #include <Eigen/Core>
 #include <Eigen/Dense>
@@ -17,9 +21,13 @@
 // Lehrfem++ includes
 #include <lf/assemble/assemble.h>
 #include <lf/geometry/geometry.h>
+#include <lf/mesh/test_utils/test_meshes.h>
 #include <lf/mesh/utils/utils.h>
+#include <lf/refinement/refinement.h>
 #include <lf/uscalfe/uscalfe.h>
 
+#include "../../../lecturecodes/helperfiles/parallelchunks.h"
+
 namespace ZienkiewiczZhuEstimator {
 
 /* Implementing member function Eval of class VectorProjectionMatrixProvider*/
@@ -398,6 +406,213 @@ double getMeshSize(const std::shared_ptr<const lf::mesh::Mesh> &mesh_p) {
   return mesh_size;
 };  // getMeshSize
 
+GradientRecovery::GradientRecovery(const lf::assemble::DofHandler &scal_dofh,
+                                   const lf::assemble::DofHandler &vec_dofh)
+    : mesh_p_(scal_dofh.Mesh()) {
+  const lf::mesh::Mesh &mesh{*mesh_p_};
+  const lf::base::size_type n_cells = mesh.NumEntities(0);
+  const lf::base::size_type n_scal = scal_dofh.NumDofs();
+  LF_VERIFY_MSG(vec_dofh.NumDofs() == 2 * n_scal,
+                "Number of degrees of freedom mismatch!");
+  grad_bary_.resize(n_cells);
+  area_.resize(n_cells);
+  cell_dofs_.resize(n_cells);
+  vec_dofs_.resize(n_scal);
+  patch_area_inv_.assign(n_scal, 0.0);
+
+  // I: Geometry of the cells and their vertex dofs, counting the cells
+  // adjacent to every node
+  std::vector<lf::base::size_type> node_start(n_scal + 1, 0);
+  for (const lf::mesh::Entity *cell : mesh.Entities(0)) {
+    LF_VERIFY_MSG(cell->RefEl() == lf::base::RefEl::kTria(),
+                  "Unsupported cell type " << cell->RefEl());
+    const lf::base::size_type k = mesh.Index(*cell);
+    // Same as gradbarycoordinates(), but computed only once
+    Eigen::Matrix3d X;
+    X.col(0) = Eigen::Vector3d::Ones();
+    X.rightCols(2) = lf::geometry::Corners(*(cell->Geometry())).transpose();
+    grad_bary_[k] = X.inverse().bottomRows(2);
+    area_[k] = 0.5 * std::abs(X.determinant());
+    nonstd::span<const lf::mesh::Entity *const> nodes{cell->SubEntities(2)};
+    for (int j = 0; j < 3; ++j) {
+      const lf::assemble::gdof_idx_t i{
+          scal_dofh.GlobalDofIndices(*nodes[j])[0]};
+      const auto vec_idx = vec_dofh.GlobalDofIndices(*nodes[j]);
+      cell_dofs_[k][j] = i;
+      vec_dofs_[i] = {vec_idx[0], vec_idx[1]};
+      patch_area_inv_[i] += area_[k];
+      ++node_start[i + 1];
+    }
+  }
+  for (lf::base::size_type i = 0; i < n_scal; ++i) {
+    patch_area_inv_[i] = 1.0 / patch_area_inv_[i];
+    node_start[i + 1] += node_start[i];
+  }
+  // Cells adjacent to node i: node_cells[node_start[i]], ...
+  std::vector<lf::base::size_type> node_cells(node_start.back());
+  std::vector<lf::base::size_type> fill(node_start.begin(),
+                                        node_start.end() - 1);
+  for (lf::base::size_type k = 0; k < n_cells; ++k) {
+    for (lf::assemble::gdof_idx_t i : cell_dofs_[k]) node_cells[fill[i]++] = k;
+  }
+
+  // II: Greedy coloring, cell k gets the smallest color not taken by one of
+  // the cells 0, ..., k-1 sharing a vertex with it
+  std::vector<lf::base::size_type> color(n_cells);
+  // taken[c] == k + 1 if color c is used by a neighbour of cell k
+  std::vector<lf::base::size_type> taken;
+  for (lf::base::size_type k = 0; k < n_cells; ++k) {
+    for (lf::assemble::gdof_idx_t i : cell_dofs_[k]) {
+      for (lf::base::size_type l = node_start[i]; l < node_start[i + 1]; ++l) {
+        if (node_cells[l] < k) taken[color[node_cells[l]]] = k + 1;
+      }
+    }
+    lf::base::size_type c = 0;
+    while (c < taken.size() && taken[c] == k + 1) ++c;
+    if (c == taken.size()) taken.push_back(0);
+    color[k] = c;
+  }
+  // Sort the cells by color
+  color_start_.assign(taken.size() + 1, 0);
+  for (lf::base::size_type k = 0; k < n_cells; ++k) {
+    ++color_start_[color[k] + 1];
+  }
+  for (lf::base::size_type c = 0; c < taken.size(); ++c) {
+    color_start_[c + 1] += color_start_[c];
+  }
+  color_cells_.resize(n_cells);
+  fill.assign(color_start_.begin(), color_start_.end() - 1);
+  for (lf::base::size_type k = 0; k < n_cells; ++k) {
+    color_cells_[fill[color[k]]++] = k;
+  }
+}
+
+/* SAM_LISTING_BEGIN_5 */
+Eigen::VectorXd GradientRecovery::lumpedProjection(const Eigen::VectorXd &mu,
+                                                   unsigned int threads) const {
+  const lf::base::size_type n_scal = vec_dofs_.size();
+  // Area-weighted sums of the cell gradients at the nodes
+  std::vector<Eigen::Vector2d> grad_sum(n_scal, Eigen::Vector2d::Zero());
+  Eigen::VectorXd proj_vec(2 * n_scal);
+  // I: scatter pass, the cells of one color do not share vertices, so that
+  // the threads never update the same node
+  for (lf::base::size_type c = 0; c < numColors(); ++c) {
+    const lf::base::size_type *cells = color_cells_.data() + color_start_[c];
+    auto scatter = [&](unsigned int /*t*/, lf::base::size_type begin,
+                       lf::base::size_type end) {
+      for (lf::base::size_type l = begin; l < end; ++l) {
+        const lf::base::size_type k = cells[l];
+        const Eigen::Vector2d grad = area_[k] * cellGradient(k, mu);
+        for (lf::assemble::gdof_idx_t i : cell_dofs_[k]) grad_sum[i] += grad;
+      }
+    };
+    parallelChunks(color_start_[c + 1] - color_start_[c], threads, scatter);
+  }
+  // II: division by the patch areas
+  auto scale = [&](unsigned int /*t*/, lf::base::size_type begin,
+                   lf::base::size_type end) {
+    for (lf::base::size_type i = begin; i < end; ++i) {
+      proj_vec[vec_dofs_[i][0]] = patch_area_inv_[i] * grad_sum[i][0];
+      proj_vec[vec_dofs_[i][1]] = patch_area_inv_[i] * grad_sum[i][1];
+    }
+  };
+  parallelChunks(n_scal, threads, scale);
+  return proj_vec;
+}
+/* SAM_LISTING_END_5 */
+
+/* SAM_LISTING_BEGIN_6 */
+Eigen::VectorXd GradientRecovery::cellDeviations(const Eigen::VectorXd &mu,
+                                                 const Eigen::VectorXd &gamma,
+                                                 unsigned int threads) const {
+  Eigen::VectorXd eta = Eigen::VectorXd::Zero(area_.size());
+  auto deviations = [&](unsigned int /*t*/, lf::base::size_type begin,
+                        lf::base::size_type end) {
+    for (lf::base::size_type k = begin; k < end; ++k) {
+      const Eigen::Vector2d grad = cellGradient(k, mu);
+      // Recovered gradient at the vertices
+      Eigen::Matrix<double, 2, 3> r;
+      for (int j = 0; j < 3; ++j) {
+        const std::array<lf::assemble::gdof_idx_t, 2> &v{
+            vec_dofs_[cell_dofs_[k][j]]};
+        r.col(j) = Eigen::Vector2d(gamma[v[0]], gamma[v[1]]);
+      }
+      // Edge midpoint rule as in computeL2Deviation()
+      double dev = 0.0;
+      for (int j = 0; j < 3; ++j) {
+        dev += (0.5 * (r.col(j) + r.col((j + 1) % 3)) - grad).squaredNorm();
+      }
+      eta[k] = dev * area_[k] / 3.0;
+    }
+  };
+  // Cell indices are of type lf::base::size_type
+  parallelChunks(static_cast<lf::base::size_type>(area_.size()), threads,
+                 deviations);
+  return eta;
+}
+/* SAM_LISTING_END_6 */
+
+void benchmarkGradientRecovery() {
+  auto time = [](auto &&F) {
+    auto start = std::chrono::high_resolution_clock::now();
+    F();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+  };
+  // Uniformly refined triangular test mesh
+  std::shared_ptr<lf::refinement::MeshHierarchy> multi_mesh_p =
+      lf::refinement::GenerateMeshHierarchyByUniformRefinemnt(
+          lf::mesh::test_utils::GenerateHybrid2DTestMesh(3), 6);
+  std::shared_ptr<const lf::mesh::Mesh> mesh_p =
+      multi_mesh_p->getMesh(multi_mesh_p->NumLevels() - 1);
+  auto fe_space_p =
+      std::make_shared<lf::uscalfe::FeSpaceLagrangeO1<double>>(mesh_p);
+  const lf::assemble::DofHandler &dofh{fe_space_p->LocGlobMap()};
+  lf::assemble::UniformFEDofHandler vec_dofh(mesh_p,
+                                             {{lf::base::RefEl::kPoint(), 2},
+                                              {lf::base::RefEl::kSegment(), 0},
+                                              {lf::base::RefEl::kTria(), 0},
+                                              {lf::base::RefEl::kQuad(), 0}});
+  const Eigen::VectorXd mu = solveBVP(fe_space_p);
+
+  Eigen::VectorXd gamma_full, gamma_lumped;
+  double dev = 0.0;
+  const double ms_full =
+      time([&] { gamma_full = solveGradVP(fe_space_p, mu, vec_dofh); });
+  const double ms_lumped = time([&] {
+    gamma_lumped = computeLumpedProjection(dofh, mu, vec_dofh);
+    dev = computeL2Deviation(dofh, mu, vec_dofh, gamma_lumped);
+  });
+  std::unique_ptr<GradientRecovery> recovery;
+  const double ms_setup = time([&] {
+    recovery = std::make_unique<GradientRecovery>(dofh, vec_dofh);
+  });
+
+  std::cout << "Gradient recovery on " << mesh_p->NumEntities(0)
+            << " cells (" << recovery->numColors() << " colors)" << std::endl;
+  std::cout << std::setw(36) << "method" << std::setw(12) << "time [ms]"
+            << std::setw(14) << "deviation" << std::endl;
+  std::cout << std::setw(36) << "solveGradVP (full mass matrix)"
+            << std::setw(12) << ms_full << std::setw(14)
+            << computeL2Deviation(dofh, mu, vec_dofh, gamma_full) << std::endl;
+  std::cout << std::setw(36) << "computeLumpedProjection + deviation"
+            << std::setw(12) << ms_lumped << std::setw(14) << dev << std::endl;
+  std::cout << std::setw(36) << "GradientRecovery setup (once)"
+            << std::setw(12) << ms_setup << std::endl;
+  const unsigned int hw = std::max(1u, std::thread::hardware_concurrency());
+  for (unsigned int threads = 1; threads <= hw; threads *= 2) {
+    Eigen::VectorXd gamma, eta;
+    const double ms = time([&] {
+      gamma = recovery->lumpedProjection(mu, threads);
+      eta = recovery->cellDeviations(mu, gamma, threads);
+    });
+    std::cout << std::setw(36)
+              << "GradientRecovery, " + std::to_string(threads) + " threads"
+              << std::setw(12) << ms << std::setw(14) << std::sqrt(eta.sum())
+              << std::endl;
+  }
+}
+
 void progress_bar::write(double fraction) {
   // clamp fraction to valid range [0,1]
   if (fraction < 0)
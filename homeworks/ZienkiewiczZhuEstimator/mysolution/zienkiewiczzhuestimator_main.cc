@@ -5,11 +5,16 @@
  * @copyright Developed at ETH Zurich
  */
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
+#include <vector>
 
+#include "../../../lecturecodes/helperfiles/convergencestudy.h"
 #include "zienkiewiczzhuestimator.h"
 // Eigen includes
 #include <Eigen/Core>
@@ -29,17 +34,14 @@ int main(int /*argc*/, const char ** /*argv*/) {
   std::cout << "\n" << std::endl;
   std::cout << "PROBLEM - ZienkiewiczZhuEstimator " << std::endl;
   progress_bar progress{std::clog, 70u, "Computing"};
-  double progress_pourcentage;
   // Tools and data
   int N_meshes = 4;             // num. of meshes
   Eigen::VectorXd approx_sol;   // basis ceoff expansion of scalar approx sol
-  Eigen::VectorXd approx_grad;  // basis ceoff expansion of approx grad
   Eigen::VectorXd L2errors(N_meshes);     // L2 errors of scalar approx sol
   Eigen::VectorXd H1errors(N_meshes);     // H1 errors of scalar approx sol
   Eigen::VectorXd errors_grad(N_meshes);  // deviation of grad (delta error)
   Eigen::VectorXd errors_diff(N_meshes);  // error difference (epsilon error)
   Eigen::VectorXd mesh_sizes(N_meshes);
-  Eigen::VectorXd interpolated_uExact;
   std::shared_ptr<lf::uscalfe::FeSpaceLagrangeO1<double>> fe_space_p;
   std::shared_ptr<const lf::mesh::Mesh> mesh_p;
 
@@ -55,54 +57,89 @@ int main(int /*argc*/, const char ** /*argv*/) {
   };
   lf::mesh::utils::MeshFunctionGlobal mf_grad_uExact{grad_uExact};
 
-  for (int i = 0; i < N_meshes; i++) {  // for each mesh
+  // Load the meshes into Lehrfem++ objects. They are only read from now on,
+  // so that they can be treated concurrently.
+  std::vector<std::shared_ptr<const lf::mesh::Mesh>> meshes(N_meshes);
+  std::vector<int> Ns(N_meshes);  // numbers of cells, identify the meshes
+  for (int i = 0; i < N_meshes; i++) {
     std::string idx_str = std::to_string(i);
-    // Load mesh into a Lehrfem++ object
     auto mesh_factory = std::make_unique<lf::mesh::hybrid2d::MeshFactory>(2);
     const lf::io::GmshReader reader(
         std::move(mesh_factory),
         CURRENT_SOURCE_DIR "/../meshes/unitsquare" + idx_str + ".msh");
-    mesh_p = reader.mesh();
-    mesh_sizes[i] = getMeshSize(mesh_p);
-    fe_space_p =
-        std::make_shared<lf::uscalfe::FeSpaceLagrangeO1<double>>(mesh_p);
+    meshes[i] = reader.mesh();
+    mesh_sizes[i] = getMeshSize(meshes[i]);
+    Ns[i] = static_cast<int>(meshes[i]->NumEntities(0));
+  }
+
+  std::mutex progress_mutex;
+  int meshes_done = 0;
+  auto solveMesh = [&](int N, ConvergenceStudy::PhaseTimer &timer) {
+    const int i = static_cast<int>(std::find(Ns.begin(), Ns.end(), N) -
+                                   Ns.begin());
+    std::shared_ptr<const lf::mesh::Mesh> mesh_i = meshes[i];
+    auto fe_space_i =
+        std::make_shared<lf::uscalfe::FeSpaceLagrangeO1<double>>(mesh_i);
     // Obtain reference to scalar dofh
-    const lf::assemble::DofHandler &dofh{fe_space_p->LocGlobMap()};
+    const lf::assemble::DofHandler &dofh{fe_space_i->LocGlobMap()};
     // Produce a dof handler for the vector-valued finite element space
     lf::assemble::UniformFEDofHandler vec_dofh(
-        mesh_p, {{lf::base::RefEl::kPoint(), 2},
+        mesh_i, {{lf::base::RefEl::kPoint(), 2},
                  {lf::base::RefEl::kSegment(), 0},
                  {lf::base::RefEl::kTria(), 0},
                  {lf::base::RefEl::kQuad(), 0}});
 
     LF_VERIFY_MSG(2 * dofh.NumDofs() == vec_dofh.NumDofs(),
                   "Number of degrees of freedom mismatch!");
+    timer.lap(ConvergenceStudy::kAssemble);
+
+    // Solve Poisson BVP with essential BCs and the gradient VP, both
+    // functions assemble their linear systems themselves
+    Eigen::VectorXd sol = solveBVP(fe_space_i);
+    Eigen::VectorXd approx_grad = solveGradVP(fe_space_i, sol, vec_dofh);
+    // approx_grad = computeLumpedProjection(dofh, sol, vec_dofh);
+    timer.lap(ConvergenceStudy::kSolve);
 
-    // Solve Poisson BVP with essential BCs
-    approx_sol = solveBVP(fe_space_p);
     // Compute L2 and H1 errors
-    auto mf_approx_sol = lf::fe::MeshFunctionFE(fe_space_p, approx_sol);
-    L2errors[i] = std::sqrt(lf::fe::IntegrateMeshFunction(
-        *mesh_p, lf::uscalfe::squaredNorm(mf_uExact - mf_approx_sol), 2));
-    auto mf_approx_grad_sol =
-        lf::fe::MeshFunctionGradFE(fe_space_p, approx_sol);
-    H1errors[i] = std::sqrt(lf::fe::IntegrateMeshFunction(
-        *mesh_p, lf::uscalfe::squaredNorm(mf_grad_uExact - mf_approx_grad_sol),
+    Eigen::Vector4d errors;
+    auto mf_approx_sol = lf::fe::MeshFunctionFE(fe_space_i, sol);
+    errors[0] = std::sqrt(lf::fe::IntegrateMeshFunction(
+        *mesh_i, lf::uscalfe::squaredNorm(mf_uExact - mf_approx_sol), 2));
+    auto mf_approx_grad_sol = lf::fe::MeshFunctionGradFE(fe_space_i, sol);
+    errors[1] = std::sqrt(lf::fe::IntegrateMeshFunction(
+        *mesh_i, lf::uscalfe::squaredNorm(mf_grad_uExact - mf_approx_grad_sol),
         2));
-
-    // Solve gradient VP and compute L2 deviation
-    approx_grad = solveGradVP(fe_space_p, approx_sol, vec_dofh);
-    // approx_grad = computeLumpedProjection(dofh, approx_sol, vec_dofh);
     // Compute deviation error (delta error)
-    errors_grad[i] =
-        computeL2Deviation(dofh, approx_sol, vec_dofh, approx_grad);
-
+    errors[2] = computeL2Deviation(dofh, sol, vec_dofh, approx_grad);
     // Compute difference error (epsilon error)
-    errors_diff[i] = std::abs(H1errors[i] - errors_grad[i]);
+    errors[3] = std::abs(errors[1] - errors[2]);
+    timer.lap(ConvergenceStudy::kError);
 
-    progress_pourcentage = ((double)i + 1.0) / N_meshes * 100.0;
-    progress.write(progress_pourcentage / 100.0);
+    std::lock_guard<std::mutex> lock(progress_mutex);
+    if (i == N_meshes - 1) {
+      // Kept for the output of the solution on the finest mesh
+      fe_space_p = fe_space_i;
+      approx_sol = sol;
+    }
+    progress.write(++meshes_done / static_cast<double>(N_meshes));
+    return Eigen::VectorXd(errors);
+  };
+  // Galerkin matrices and LU factors of the scalar and the vector-valued
+  // problem, roughly 4 kB per cell
+  auto memory = [](int N) -> std::size_t {
+    return std::size_t{4096} * static_cast<std::size_t>(N);
+  };
+  const std::vector<ConvergenceStudy::Level> results =
+      ConvergenceStudy::run(Ns, solveMesh, memory);
+  for (int i = 0; i < N_meshes; i++) {
+    L2errors[i] = results[i].errors[0];
+    H1errors[i] = results[i].errors[1];
+    errors_grad[i] = results[i].errors[2];
+    errors_diff[i] = results[i].errors[3];
   }
+  mesh_p = meshes[N_meshes - 1];
+  ConvergenceStudy::write(CURRENT_BINARY_DIR "/errors.csv",
+                          {"L2", "H1", "delta", "epsilon"}, results);
 
   // Computing rates of convergence of approx solutions to BVP and gradient VP
   double ratesL2[N_meshes - 1];
@@ -267,4 +304,7 @@ int main(int /*argc*/, const char ** /*argv*/) {
             << std::endl;
   std::cout << ">> ZienkiewiczZhuEstimator_solution.vtk\n" << std::endl;
 
+  // Cached, parallel lumped gradient recovery vs. the global projections
+  benchmarkGradientRecovery();
+
 }  // main
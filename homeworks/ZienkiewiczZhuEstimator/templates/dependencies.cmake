@@ -19,4 +19,5 @@ set(LIBRARIES
   LF::lf.mesh.utils
   LF::lf.refinement
   LF::lf.uscalfe
+  Threads::Threads
 )
@@ -8,7 +8,10 @@
  * @copyright Developed at ETH Zurich
  */
 
+#include <array>
 #include <iostream>
+#include <memory>
+#include <vector>
 // Lehrfem++ includes
 #include <lf/assemble/assemble.h>
 #include <lf/fe/fe.h>
@@ -100,6 +103,61 @@ class progress_bar {
   void write(double fraction);
 };
 
+/** @brief Gradient recovery by lumped L2-projection and the resulting
+ * Zienkiewicz-Zhu error indicators on TRIANGULAR meshes
+ *
+ * The constructor caches the gradients of the barycentric coordinate
+ * functions, the areas and the vertex dofs of all cells, the reciprocal areas
+ * of the node patches and a coloring of the cells such that cells sharing a
+ * vertex have different colors. The lumped projection is a single scatter
+ * pass over the cells, which runs in parallel color by color without any
+ * synchronization of the nodal sums. No linear system is solved.
+ */
+class GradientRecovery {
+ public:
+  /** @param scal_dofh dof handler of the scalar linear Lagrangian FE space
+   *  @param vec_dofh dof handler with two dofs per node for the recovered
+   *  gradient, on the same mesh */
+  GradientRecovery(const lf::assemble::DofHandler &scal_dofh,
+                   const lf::assemble::DofHandler &vec_dofh);
+
+  /** @brief Same result as computeLumpedProjection() */
+  Eigen::VectorXd lumpedProjection(const Eigen::VectorXd &mu,
+                                   unsigned int threads = 1) const;
+
+  /** @brief Local contributions to the square of computeL2Deviation(),
+   * indexed by the cells, for use as error indicators */
+  Eigen::VectorXd cellDeviations(const Eigen::VectorXd &mu,
+                                 const Eigen::VectorXd &gamma,
+                                 unsigned int threads = 1) const;
+
+  /** @brief Number of colors = number of sequential scatter stages */
+  lf::base::size_type numColors() const { return color_start_.size() - 1; }
+
+ private:
+  // Constant gradient of the FE function with coefficient vector mu on cell k
+  Eigen::Vector2d cellGradient(lf::base::size_type k,
+                               const Eigen::VectorXd &mu) const {
+    const std::array<lf::assemble::gdof_idx_t, 3> &dofs{cell_dofs_[k]};
+    return grad_bary_[k] * Eigen::Vector3d(mu[dofs[0]], mu[dofs[1]],
+                                           mu[dofs[2]]);
+  }
+
+  std::shared_ptr<const lf::mesh::Mesh> mesh_p_;
+  // Indexed by the cells
+  std::vector<Eigen::Matrix<double, 2, 3>> grad_bary_;
+  std::vector<double> area_;
+  std::vector<std::array<lf::assemble::gdof_idx_t, 3>> cell_dofs_;
+  // Indexed by the scalar dofs: vector dofs at the same node and the
+  // reciprocal area of the patch of cells around the node
+  std::vector<std::array<lf::assemble::gdof_idx_t, 2>> vec_dofs_;
+  std::vector<double> patch_area_inv_;
+  // Cells of color c: color_cells_[color_start_[c]], ...,
+  // color_cells_[color_start_[c + 1] - 1]
+  std::vector<lf::base::size_type> color_start_;
+  std::vector<lf::base::size_type> color_cells_;
+};
+
 /* LIBRARY FUNCTIONS */
 Eigen::Matrix<double, 2, 3> gradbarycoordinates(const lf::mesh::Entity &entity);
 
@@ -121,6 +179,10 @@ Eigen::VectorXd solveGradVP(
 
 double getMeshSize(const std::shared_ptr<const lf::mesh::Mesh> &mesh_p);
 
+/** @brief Compares runtimes of solveGradVP(), computeLumpedProjection() and
+ * GradientRecovery on a uniformly refined triangular test mesh */
+void benchmarkGradientRecovery();
+
 template <typename FUNCTOR_U>
 Eigen::VectorXd interpolateData(
     std::shared_ptr<lf::uscalfe::UniformScalarFESpace<double>> fe_space_p,
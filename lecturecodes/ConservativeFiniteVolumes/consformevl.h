@@ -6,6 +6,8 @@
 
 // This headere supplies the Runge-Kutta single-step method for timestepping
 #include <Eigen/Dense>
+#include <limits>
+#include <utility>
 
 #include "ode.h"
 
@@ -75,15 +77,61 @@ VectorXd consformevl(double a, double b, unsigned N, FunctionU0 u0, double T,
   // Boost integrator (adaptive explicit embedded Runge-Kutta method
   // of order 5, see also Def.~\ref{def:rk2})
   double abstol = 1E-8, reltol = 1E-6;  // integration control parameters
-  // std::vector<double> t;  Returns temporal grid
-  // std::vector<Eigen::VectorXd> MU; Returns states  \Blue{$\vec{\mubf}^{(k)}$}
-  // Use this C++17 syntax only, if you are well aware of the return types
-  auto [t, MU] =
-      ode45(odefun, 0, T, mu0, abstol, reltol);  // \Label[line]{cle:ode45}
-  // Retrieve approximate state at final time.
-  return MU.back();
+  // Only the approximate state at final time is retained, intermediate
+  // states \Blue{$\vec{\mubf}^{(k)}$} are not stored
+  return ode45final(odefun, 0, T, mu0, abstol,
+                    reltol);  // \Label[line]{cle:ode45}
 }
 /* SAM_LISTING_END_2 */
 
+// arguments:
+//   Real numbers \Blue{$a, b$}, the boundaries of the interval,
+//   unsigned int \Blue{$N$}, the number of cells,
+//   Functor \Blue{$u0 : \mathbb R \mapsto \mathbb R$}, initial value,
+//   Final time \Blue{$T>0$},
+//   Functor \Blue{$F=F(v,w)$} for 2-point numerical flux function,
+//   Functor \Blue{$df$}, derivative \Blue{$f'$} of the flux function,
+//   Functor \Blue{$observer(\mu,t,final)$}, receives all states, see
+//     SnapshotWriter,
+//   Real number \Blue{$0 < cfl \leq 1$}, safety factor for the CFL condition.
+//
+// return value:
+//   Vector with cell values at final time \Blue{$T$}
+//
+// Same as consformevl(), but timestepping with the SSP Runge-Kutta method of
+// order 3, where the timestep is chosen adaptively according to the CFL
+// condition \Blue{$\tau \leq cfl\,h / \max_j|f'(\mu_j)|$}.
+template <typename FunctionU0, typename FunctionF, typename FunctionDF,
+          typename OBSERVER>
+VectorXd consformevlssp(double a, double b, unsigned N, FunctionU0 u0,
+                        double T, FunctionF &&F, FunctionDF &&df,
+                        OBSERVER &&observer, double cfl = 0.9) {
+  double h = (b - a) / N;  // meshwidth
+  VectorXd x = VectorXd::LinSpaced(N, a + 0.5 * h, b - 0.5 * h);
+  VectorXd mu0 = x.unaryExpr(u0);
+
+  auto odefun = [&](const VectorXd &mu, VectorXd &dmdt, double /*t*/) {
+    dmdt = -1. / h * fluxdiff<FunctionF>(mu, F);
+  };
+  // Maximal timestep permitted by the CFL condition for the current state
+  auto taumax = [&](const VectorXd &mu) {
+    const double speed = mu.unaryExpr(df).cwiseAbs().maxCoeff();
+    return (speed > 0.0) ? cfl * h / speed
+                         : std::numeric_limits<double>::infinity();
+  };
+  return sspRK3(odefun, 0, T, mu0, taumax, std::forward<OBSERVER>(observer))
+      .first;
+}
+
+// consformevlssp() without observer
+template <typename FunctionU0, typename FunctionF, typename FunctionDF>
+VectorXd consformevlssp(double a, double b, unsigned N, FunctionU0 u0,
+                        double T, FunctionF &&F, FunctionDF &&df,
+                        double cfl = 0.9) {
+  return consformevlssp(a, b, N, u0, T, std::forward<FunctionF>(F),
+                        std::forward<FunctionDF>(df),
+                        [](const VectorXd &, double, bool) {}, cfl);
+}
+
 }  // namespace ConsFV
 #endif
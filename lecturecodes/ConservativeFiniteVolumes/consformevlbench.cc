@@ -0,0 +1,105 @@
+// * Demonstration code for course Numerical Methods for Partial Differential
+// Equations
+// * Author: agent
+// * Date: October 2026
+
+// Throughput of the SoA multi-component finite volume code: a parameter sweep
+// of many Burgers problems is solved one by one with consformevl() and as a
+// single batch with consformevlsys() for various numbers of cells. In
+// addition, a small system (shallow water equations) is solved with the same
+// code.
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+#include "consformevl.h"
+#include "consformevlsys.h"
+#include "numexp_runner.h"
+
+// Rusanov flux for the shallow water equations with states (h, hu)
+static auto nfn_lf_shallowwater = [](const auto &v, const auto &w) {
+  const double g = 9.81;
+  const Eigen::ArrayXd uv = v.col(1) / v.col(0);
+  const Eigen::ArrayXd uw = w.col(1) / w.col(0);
+  const Eigen::ArrayXd s = (uv.abs() + (g * v.col(0)).sqrt())
+                               .max(uw.abs() + (g * w.col(0)).sqrt());
+  ConsFV::SoAStates<2> F(v.rows(), 2);
+  F.col(0) = 0.5 * (v.col(1) + w.col(1)) - 0.5 * s * (w.col(0) - v.col(0));
+  F.col(1) = 0.5 * (v.col(1) * uv + 0.5 * g * v.col(0).square() +
+                    w.col(1) * uw + 0.5 * g * w.col(0).square()) -
+             0.5 * s * (w.col(1) - v.col(1));
+  return F;
+};
+
+template <typename FUNCTOR>
+double timeit(FUNCTOR &&f) {
+  auto start = std::chrono::high_resolution_clock::now();
+  f();
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration<double>(end - start).count();
+}
+
+int main(int /*argc*/, char ** /*argv*/) {
+  const double a = -1.0;
+  const double b = 5.0;
+  const double T = 2.0;
+  // Number of independent problems of the parameter sweep
+  constexpr int B = 32;
+  // Shifts of the initial data u0 = bump(x - s)
+  const Eigen::ArrayXd shift = Eigen::ArrayXd::LinSpaced(B, 0.0, 1.0);
+
+  std::cout << "Parameter sweep of " << B
+            << " Burgers problems, shifted bump initial data, T = " << T
+            << std::endl;
+  std::cout << std::setw(8) << "N" << std::setw(16) << "sequential [s]"
+            << std::setw(16) << "problems/s" << std::setw(16) << "batch [s]"
+            << std::setw(16) << "problems/s" << std::setw(14) << "max diff"
+            << std::endl;
+  for (unsigned int N : {30, 60, 120, 240, 480, 960}) {
+    // Reference: one problem after the other
+    ConsFV::SoAStates<B> mu_seq(N, B);
+    const double t_seq = timeit([&]() {
+      for (int k = 0; k < B; ++k) {
+        auto u0 = [&](double x) { return bump(x - shift[k]); };
+        mu_seq.col(k) = ConsFV::consformevl(a, b, N, u0, T, nfn_lf_burger);
+      }
+    });
+    // All problems at once with the scalar flux applied componentwise
+    auto u0_batch = [&](const Eigen::VectorXd &x) {
+      ConsFV::SoAStates<B> mu0(x.size(), B);
+      for (int k = 0; k < B; ++k) {
+        mu0.col(k) = (x.array() - shift[k]).unaryExpr(bump);
+      }
+      return mu0;
+    };
+    ConsFV::SoAStates<B> mu_batch;
+    const double t_batch = timeit([&]() {
+      mu_batch = ConsFV::consformevlsys<B>(a, b, N, u0_batch, T,
+                                           ConsFV::soaflux(nfn_lf_burger));
+    });
+    std::cout << std::setw(8) << N << std::setw(16) << t_seq << std::setw(16)
+              << B / t_seq << std::setw(16) << t_batch << std::setw(16)
+              << B / t_batch << std::setw(14)
+              << (mu_batch - mu_seq).abs().maxCoeff() << std::endl;
+  }
+
+  // A system: dam break problem for the shallow water equations
+  const unsigned int N = 1920;
+  auto u0_dambreak = [](const Eigen::VectorXd &x) {
+    ConsFV::SoAStates<2> mu0(x.size(), 2);
+    mu0.col(0) = (x.array() < 2.0).select(2.0, Eigen::ArrayXd::Ones(x.size()));
+    mu0.col(1).setZero();
+    return mu0;
+  };
+  ConsFV::SoAStates<2> mu_sw;
+  const double t_sw = timeit([&]() {
+    mu_sw = ConsFV::consformevlsys<2>(a, b, N, u0_dambreak, 0.5,
+                                      nfn_lf_shallowwater);
+  });
+  std::cout << "Shallow water dam break, N = " << N << ": " << t_sw
+            << " s, total mass = " << mu_sw.col(0).sum() * (b - a) / N
+            << std::endl;
+  return 0;
+}
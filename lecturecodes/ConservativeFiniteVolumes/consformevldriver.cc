@@ -3,6 +3,8 @@
 // * Author: R. Hiptmair, SAM, ETH Zurich
 // * Date: May 2020
 
+#include <fstream>
+
 #include "consformevl.h"
 #include "numexp_runner.h"
 
@@ -53,4 +55,20 @@ int main(int /*argc*/, char** /*argv*/) {
     };
     consform_compute(evl, "burgers_bump_godunov.csv", _T, _a, _b);
   }
+  // Derivative of the Burgers flux, which gives the wave speed
+  auto dfb = [](double u) { return u; };
+  {
+    // SSP Runge-Kutta timestepping with timestep from the CFL condition
+    auto evl = [&](double a, double b, double N, double T) -> Eigen::VectorXd {
+      return ConsFV::consformevlssp(a, b, N, box, T, nfn_god_burger, dfb);
+    };
+    consform_compute(evl, "burgers_box_godunov_ssp.csv", _T, _a, _b);
+  }
+  {
+    // Every 20th state of a single run is written to file
+    std::ofstream snapshot_file("burgers_box_godunov_snapshots.csv");
+    ConsFV::SnapshotWriter writer(snapshot_file, 20);
+    ConsFV::consformevlssp(_a, _b, 480, box, _T, nfn_god_burger, dfb, writer);
+    std::cout << "Generated burgers_box_godunov_snapshots.csv" << std::endl;
+  }
 }
@@ -0,0 +1,123 @@
+// Demonstration code for course Numerical Methods for Partial Differential
+// Equations Author: agent Date: October 2026
+
+#ifndef CONSFORMEVLSYS_HPP
+#define CONSFORMEVLSYS_HPP
+
+#include <Eigen/Dense>
+#include <type_traits>
+
+#include "ode.h"
+
+namespace ConsFV {
+
+// States of K components on N cells in "structure of arrays" (SoA) layout:
+// column k holds the cell averages of component k, stored contiguously.
+// The K components may either be the unknowns of a system of conservation
+// laws (shallow water: K=2, Euler: K=3) or K independent scalar problems
+// which are advanced together (batch of a parameter sweep).
+template <int K>
+using SoAStates = Eigen::Array<double, Eigen::Dynamic, K>;
+
+// Converts a 2-point numerical flux \Blue{$F : \mathbb R \times \mathbb R
+// \mapsto \mathbb R$} for a scalar conservation law into a numerical flux
+// acting on blocks of SoA states, that is, \Blue{$F$} is applied to each
+// component independently. This is the way to run batches of scalar problems
+// with the ordinary scalar numerical fluxes.
+template <typename FunctionF>
+auto soaflux(FunctionF &&F) {
+  return [F](const auto &v, const auto &w) {
+    constexpr int K = std::decay_t<decltype(v)>::ColsAtCompileTime;
+    SoAStates<K> Fvw(v.rows(), v.cols());
+    // Column by column: every sweep runs over contiguous memory and can be
+    // vectorized by the compiler, whereas a 2D traversal of the blocks cannot
+    for (Eigen::Index k = 0; k < v.cols(); ++k) {
+      Fvw.col(k) = v.col(k).binaryExpr(w.col(k), F);
+    }
+    return Fvw;
+  };
+}
+
+/* SAM_LISTING_BEGIN_1 */
+// arguments: SoA states \Blue{$\mu$} of cell averages, \Blue{$N\times K$}
+//  Functor \Blue{$F$}: 2-point numerical flux acting on blocks of states,
+//  \Blue{$F(V,W)$}, where row \Blue{$i$} of the \Blue{$m\times K$}
+//  arrays \Blue{$V$} and \Blue{$W$} contains the states left and right of
+//  interface \Blue{$i$}; it has to return an \Blue{$m\times K$} array of
+//  numerical fluxes.
+// return value: SoA array with differences of numerical fluxes, which provides
+// the right hand side of \eqref{eq:2pcf} for every component
+//
+// All interfaces are processed by a single call of \Blue{$F$}, which is a
+// loop over contiguous memory for every component and can be vectorized.
+template <int K, typename FunctionF>
+SoAStates<K> fluxdiffsys(const Eigen::Ref<const SoAStates<K>> &mu,
+                         FunctionF &&F) {
+  const Eigen::Index n = mu.rows();  // number of cells
+  SoAStates<K> fd(n, mu.cols());     // return array
+  if (n < 2) {
+    // No interior interface: the fluxes F(mu, mu) on both sides cancel
+    fd.setZero();
+    return fd;
+  }
+  // Numerical fluxes at the \Blue{$n-1$} interior interfaces
+  const SoAStates<K> Fint = F(mu.topRows(n - 1), mu.bottomRows(n - 1));
+  // constant continuation of data for \Blue{$x\leq a$} and \Blue{$x\geq b$}!
+  const SoAStates<K> Fa = F(mu.topRows(1), mu.topRows(1));
+  const SoAStates<K> Fb = F(mu.bottomRows(1), mu.bottomRows(1));
+  fd.topRows(1) = Fint.topRows(1) - Fa;
+  fd.middleRows(1, n - 2) = Fint.bottomRows(n - 2) - Fint.topRows(n - 2);
+  fd.bottomRows(1) = Fb - Fint.bottomRows(1);
+  return fd;
+}
+/* SAM_LISTING_END_1 */
+
+/* SAM_LISTING_BEGIN_2 */
+// arguments:
+//   Real numbers \Blue{$a, b$}, the boundaries of the interval,
+//   unsigned int \Blue{$N$}, the number of cells,
+//   Functor \Blue{$u0$}, initial value: takes the vector of cell centers and
+//     returns the \Blue{$N\times K$} SoA array of initial states,
+//   Final time \Blue{$T>0$},
+//   Functor \Blue{$F=F(V,W)$}, block 2-point numerical flux, see
+//     fluxdiffsys().
+//
+// return value:
+//   SoA array with cell values at final time \Blue{$T$}
+//
+// Same as consformevl(), but for K components. The SoA array is passed to the
+// ODE solver as a single vector of length \Blue{$NK$}; for a batch of
+// independent problems this means that a common adaptive timestep is used,
+// which is controlled by the most demanding member of the batch.
+template <int K, typename FunctionU0, typename FunctionF>
+SoAStates<K> consformevlsys(double a, double b, unsigned N, FunctionU0 &&u0,
+                            double T, FunctionF &&F) {
+  const double h = (b - a) / N;  // meshwidth
+  // centers of dual cells
+  const Eigen::VectorXd x =
+      Eigen::VectorXd::LinSpaced(N, a + 0.5 * h, b - 0.5 * h);
+  // SoA array of initial cell averages obtained by point sampling
+  const SoAStates<K> mu0 = u0(x);
+  const Eigen::Index n = mu0.rows();
+  const Eigen::Index k = mu0.cols();
+
+  // right hand side function for ode solver; its states are the SoA arrays
+  // viewed as vectors of length \Blue{$NK$}
+  auto odefun = [&](const Eigen::VectorXd &mu, Eigen::VectorXd &dmdt,
+                    double /*t*/) {
+    Eigen::Map<const SoAStates<K>> muarr(mu.data(), n, k);
+    dmdt.resize(mu.size());
+    Eigen::Map<SoAStates<K>>(dmdt.data(), n, k) =
+        (-1. / h) * fluxdiffsys<K>(muarr, F);
+  };
+
+  double abstol = 1E-8, reltol = 1E-6;  // integration control parameters
+  const Eigen::VectorXd mu = ode45final(
+      odefun, 0, T, Eigen::Map<const Eigen::VectorXd>(mu0.data(), n * k),
+      abstol, reltol);
+  return Eigen::Map<const SoAStates<K>>(mu.data(), n, k);
+}
+/* SAM_LISTING_END_2 */
+
+}  // namespace ConsFV
+#endif
@@ -45,11 +45,8 @@ Eigen::VectorXd highresevl(double a, double b, unsigned N, FunctionU0 &&u0,
   // timestepping by explicit adaptive Runge-Kutta single-step
   // method of order 5. Adaptivity control according to \ncseref{sec:ssctrl}
   double abstol = 1E-8, reltol = 1E-6;  // integration control parameters
-  // std::vector<double> t;    Temporal adaptive integration mesh
-  // std::vector<Eigen::VectorXd> MU; Returns states \Blue{$\vec{\mubf}^{(k)}$}
-  auto [t, MU] = ode45(odefun, 0, T, mu0, abstol, reltol);
-  // Extract state vector for final time
-  return MU.back();
+  // Only the state vector for final time is retained
+  return ode45final(odefun, 0, T, mu0, abstol, reltol);
 }
 /* SAM_LISTING_END_1 */
 }  // namespace ConsFV
@@ -4,6 +4,10 @@
 #define ODE_HPP
 
 #include <Eigen/Core>
+#include <algorithm>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -67,6 +71,131 @@ std::pair<std::vector<double>, std::vector<Eigen::VectorXd>> ode45(
   return {timesteps, mus};
 }
 
+/**
+ * @brief Same as ode45(), but only the final state is kept
+ *
+ * No intermediate states are stored, so that the memory consumption does not
+ * grow with the number of timesteps.
+ *
+ * @param odefun The function f(t, y) for a scalar t and a vector y, see ode45()
+ * @param t0 The starting time.
+ * @param tfinal The ending time.
+ * @param y0 The initial conditions.
+ * @param abserr The absolute error tolerance.
+ * @param relerr The relative error tolerance.
+ * @return approximate state at time tfinal
+ */
+template <typename ODEFUN>
+Eigen::VectorXd ode45final(ODEFUN &&odefun, const double t0,
+                           const double tfinal, const Eigen::VectorXd &y0,
+                           const double abserr = 1.0E-8,
+                           const double relerr = 1.0E-6) {
+  Eigen::VectorXd mu = y0;
+  auto stepper = boost::numeric::odeint::make_controlled(
+      abserr, relerr,
+      boost::numeric::odeint::runge_kutta_dopri5<Eigen::VectorXd>());
+  // The state mu is updated in place, no observer
+  boost::numeric::odeint::integrate_adaptive(stepper, odefun, mu, t0, tfinal,
+                                             0.01);
+  return mu;
+}
+
+/**
+ * @brief Observer for sspRK3() writing every k-th state to a stream
+ *
+ * Each line of output contains the time followed by the comma-separated
+ * components of the state. The final state is always written.
+ */
+class SnapshotWriter {
+ public:
+  /**
+   * @param out stream receiving the snapshots
+   * @param every only every every-th state is written, every > 0
+   */
+  explicit SnapshotWriter(std::ostream &out, unsigned int every = 1)
+      : out_(out), every_(every) {}
+
+  void operator()(const Eigen::VectorXd &x, double t, bool final = false) {
+    if (final || (cnt_ % every_ == 0)) {
+      const Eigen::IOFormat CSVFormat(Eigen::FullPrecision,
+                                      Eigen::DontAlignCols, ", ", ", ");
+      out_ << t << ", " << x.transpose().format(CSVFormat) << '\n';
+    }
+    ++cnt_;
+  }
+
+ private:
+  std::ostream &out_;
+  unsigned int every_;
+  unsigned int cnt_{0};
+};
+
+/**
+ * @brief Strong-stability preserving (SSP) explicit Runge-Kutta method of
+ * order 3 (Shu-Osher form) with timestep controlled by a CFL condition
+ *
+ * In each step the timestep is \f$\tau = \min\{taumax(y), tfinal - t\}\f$.
+ * All auxiliary vectors are allocated once, so memory does not grow with the
+ * number of timesteps.
+ *
+ * @tparam ODEFUN same as for ode45()
+ * @tparam TAUFUN callable object with signature double(const Eigen::VectorXd&)
+ * returning the maximal stable timestep for a given state
+ * @tparam OBSERVER callable object with signature void(const Eigen::VectorXd
+ * &x, double t, bool final), e.g. SnapshotWriter. It is invoked for the initial
+ * state and after every timestep.
+ * @param odefun The function f(t, y) for a scalar t and a vector y.
+ * @param t0 The starting time.
+ * @param tfinal The ending time.
+ * @param y0 The initial conditions.
+ * @param taumax CFL timestep bound
+ * @param observer receives the sequence of states
+ * @return approximate state at time tfinal and number of timesteps
+ * @throws std::runtime_error if taumax returns a value that is not positive
+ */
+template <typename ODEFUN, typename TAUFUN, typename OBSERVER>
+std::pair<Eigen::VectorXd, unsigned int> sspRK3(
+    ODEFUN &&odefun, const double t0, const double tfinal,
+    const Eigen::VectorXd &y0, TAUFUN &&taumax, OBSERVER &&observer) {
+  Eigen::VectorXd mu = y0;
+  // Preallocated stages and increment
+  Eigen::VectorXd mu1(mu.size()), mu2(mu.size()), k(mu.size());
+  double t = t0;
+  unsigned int nsteps = 0;
+  observer(mu, t, false);
+  while (t < tfinal) {
+    // A vanishing wave speed yields an unbounded timestep
+    const double tau = std::min(taumax(mu), tfinal - t);
+    if (!(tau > 0.0)) {
+      throw std::runtime_error("sspRK3: CFL timestep bound is not positive");
+    }
+    odefun(mu, k, t);
+    mu1 = mu + tau * k;
+    odefun(mu1, k, t + tau);
+    mu2 = 0.75 * mu + 0.25 * (mu1 + tau * k);
+    odefun(mu2, k, t + 0.5 * tau);
+    mu = (1.0 / 3.0) * mu + (2.0 / 3.0) * (mu2 + tau * k);
+    t = (tau == tfinal - t) ? tfinal : t + tau;
+    ++nsteps;
+    observer(mu, t, t >= tfinal);
+  }
+  return {mu, nsteps};
+}
+
+/**
+ * @brief sspRK3() without observer
+ */
+template <typename ODEFUN, typename TAUFUN>
+std::pair<Eigen::VectorXd, unsigned int> sspRK3(ODEFUN &&odefun,
+                                                const double t0,
+                                                const double tfinal,
+                                                const Eigen::VectorXd &y0,
+                                                TAUFUN &&taumax) {
+  return sspRK3(std::forward<ODEFUN>(odefun), t0, tfinal, y0,
+                std::forward<TAUFUN>(taumax),
+                [](const Eigen::VectorXd &, double, bool) {});
+}
+
 }  // namespace ConsFV
 
 #endif
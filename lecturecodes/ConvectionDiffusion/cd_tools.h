@@ -19,6 +19,8 @@
 #include <string>
 #include <vector>
 
+#include "point_locator.h"
+
 namespace ConvectionDiffusion {
 
 /**
@@ -60,6 +62,40 @@ double EvaluateMeshFunction(std::shared_ptr<const lf::mesh::Mesh> mesh_p, MF mf,
   }
   return 0.0;
 }
+/**
+ * @brief Evaluates a MeshFunction at a point specified by its global
+ * coordinates, using a PointLocator for the mesh of the MeshFunction
+ */
+template <typename MF>
+double EvaluateMeshFunction(const PointLocator& locator, MF mf,
+                            Eigen::Vector2d global) {
+  const auto [entity_p, loc] = locator.Locate(global);
+  return entity_p != nullptr ? mf(*entity_p, loc)[0] : 0.0;
+}
+
+/**
+ * @brief Evaluates a MeshFunction at points specified by their global
+ * coordinates, using a PointLocator for the mesh of the MeshFunction.
+ *
+ * Each point is located by a walk starting from the cell of the previous
+ * point, so that sequences of nearby points cost O(1) per point.
+ */
+template <typename MF>
+std::vector<double> EvaluateMeshFunction(
+    const PointLocator& locator, MF mf,
+    const std::vector<Eigen::Vector2d>& global) {
+  std::vector<double> res(global.size(), 0.0);
+  const lf::mesh::Entity* seed = nullptr;
+  for (std::size_t i = 0; i < global.size(); ++i) {
+    const auto [entity_p, loc] = locator.Locate(global[i], seed);
+    if (entity_p != nullptr) {
+      res[i] = mf(*entity_p, loc)[0];
+      seed = entity_p;
+    }
+  }
+  return res;
+}
+
 /**
  * @brief Evaluates a MeshFunction at points specified by their global
  * coordinates
@@ -69,61 +105,19 @@ template <typename MF>
 std::vector<double> EvaluateMeshFunction(
     std::shared_ptr<const lf::mesh::Mesh> mesh_p, MF mf,
     const std::vector<Eigen::Vector2d>& global, double tol = 10E-10) {
-  unsigned N = global.size();
-  std::vector<double> res(N);
-  std::vector<bool> computed(N, false);
-  unsigned counter = 0;
-
-  for (const lf::mesh::Entity* entity_p : mesh_p->Entities(0)) {
-    // verify that entity_p is a triangle
-    LF_ASSERT_MSG(lf::base::RefEl::kTria() == entity_p->RefEl(),
-                  "Function only defined for triangular cells");
-
-    // compute geometric information about the cell
-    const lf::geometry::Geometry* geo_p = entity_p->Geometry();
-    Eigen::MatrixXd corners = lf::geometry::Corners(*geo_p);
-
-    // Prepare global to local coordinate transformation
-    Eigen::Matrix2d A;
-    A << corners.col(1) - corners.col(0), corners.col(2) - corners.col(0);
-    Eigen::FullPivLU<Eigen::Matrix2d> lu = A.fullPivLu();
-
-    for (unsigned i = 0; i < N; ++i) {
-      if (computed[i] == false) {
-        // compute local coordinates
-        Eigen::Vector2d b = global[i] - corners.col(0);
-        Eigen::Vector2d loc = lu.solve(b);
-
-        // evaluate MeshFunction, if local coordinates lie in the reference
-        // triangle
-        if (loc(0) >= 0 - tol && loc(1) >= 0 - tol &&
-            loc(0) + loc(1) <= 1 + tol) {
-          res[i] = mf(*entity_p, loc)[0];
-          computed[i] = true;
-          counter++;
-
-          // Check, if MeshFunction was evaluated at all points
-          if (counter == N) {
-            return res;
-          }
-        }
-      }
-    }
-  }
-  return res;
+  return EvaluateMeshFunction(PointLocator(mesh_p, tol), mf, global);
 }
 
 /**
  * @brief Samples a MeshFunction at points along a curve
  * @param file_name Outut file
- * @param mesh_p underlying mesh
+ * @param locator PointLocator for the underlying mesh
  * @param gamma Curve parametrized over the unit interval [0,1]
  * @param mf MeshFunction
  * @param N Number of sample points
  */
 template <typename CURVE, typename MF>
-void SampleMeshFunction(std::string file_name,
-                        std::shared_ptr<const lf::mesh::Mesh> mesh_p,
+void SampleMeshFunction(std::string file_name, const PointLocator& locator,
                         CURVE gamma, MF mf, int N) {
   // Sample uniformly along gamma
   Eigen::VectorXd sample_times = Eigen::VectorXd::LinSpaced(N, 0.0, 1.0);
@@ -133,7 +127,7 @@ void SampleMeshFunction(std::string file_name,
     sample_points[i] = gamma(t);
   }
 
-  std::vector<double> res = EvaluateMeshFunction(mesh_p, mf, sample_points);
+  std::vector<double> res = EvaluateMeshFunction(locator, mf, sample_points);
 
   // output
   std::ofstream file;
@@ -147,6 +141,18 @@ void SampleMeshFunction(std::string file_name,
   file.close();
 }
 
+/**
+ * @brief Samples a MeshFunction at points along a curve
+ * @param mesh_p underlying mesh, see the overload above for the other
+ * parameters
+ */
+template <typename CURVE, typename MF>
+void SampleMeshFunction(std::string file_name,
+                        std::shared_ptr<const lf::mesh::Mesh> mesh_p,
+                        CURVE gamma, MF mf, int N) {
+  SampleMeshFunction(file_name, PointLocator(mesh_p), gamma, mf, N);
+}
+
 }  // namespace ConvectionDiffusion
 
 #endif  // CD_TOOLS_H
\ No newline at end of file
@@ -59,11 +59,12 @@ int main() {
 
   // Output solution along the curve gamma
   auto gamma = [](double t) { return Eigen::Vector2d(t, 1 - t); };
-  ConvectionDiffusion::SampleMeshFunction("results_standard_FEM.txt", mesh_p,
+  const ConvectionDiffusion::PointLocator locator(mesh_p);
+  ConvectionDiffusion::SampleMeshFunction("results_standard_FEM.txt", locator,
                                           gamma, sol_standard_mf, 300);
-  ConvectionDiffusion::SampleMeshFunction("results_upwind.txt", mesh_p, gamma,
+  ConvectionDiffusion::SampleMeshFunction("results_upwind.txt", locator, gamma,
                                           sol_upwind_mf, 300);
-  ConvectionDiffusion::SampleMeshFunction("results_supg.txt", mesh_p, gamma,
+  ConvectionDiffusion::SampleMeshFunction("results_supg.txt", locator, gamma,
                                           sol_supg_mf, 300);
 
   // Plot
@@ -0,0 +1,225 @@
+#ifndef POINT_LOCATOR_H
+#define POINT_LOCATOR_H
+
+/**
+ * @file point_locator.h
+ * @brief Point location in triangular meshes
+ * @author agent
+ * @date October 2026
+ * @copyright Developed at SAM, ETH Zurich
+ */
+
+#include <lf/base/base.h>
+#include <lf/geometry/geometry.h>
+#include <lf/mesh/mesh.h>
+
+#include <Eigen/Core>
+#include <Eigen/LU>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace ConvectionDiffusion {
+
+/**
+ * @brief Locates points in a TRIANGULAR mesh, i.e. finds the cell containing
+ * a point given by its global coordinates and its local coordinates there.
+ *
+ * Built once per mesh in O(#cells):
+ * - the inverses of the affine maps of all cells, so that the local
+ *   coordinates of a point cost a single 2x2 matrix-vector product,
+ * - a uniform bucket grid over the bounding box of the mesh with about one
+ *   cell per bucket, each bucket listing the cells whose bounding box it
+ *   intersects,
+ * - the neighbours of all cells across their edges.
+ *
+ * Locate(x) only tests the cells of the bucket containing x. Locate(x, seed)
+ * walks from the cell seed towards x, crossing the edge opposite to the
+ * most negative barycentric coordinate. It is the method of choice for
+ * sequences of nearby points, e.g. along a curve, and falls back to the
+ * bucket grid if the walk leaves the mesh.
+ */
+class PointLocator {
+ public:
+  /** @brief Cell containing a point (nullptr if none) and local coordinates */
+  using Location = std::pair<const lf::mesh::Entity *, Eigen::Vector2d>;
+
+  /**
+   * @param mesh_p a TRIANGULAR mesh
+   * @param tol points at distance up to tol (in barycentric coordinates)
+   * outside of a cell are considered inside
+   */
+  explicit PointLocator(std::shared_ptr<const lf::mesh::Mesh> mesh_p,
+                        double tol = 10E-10);
+
+  /** @brief Locates x using the bucket grid */
+  Location Locate(const Eigen::Vector2d &x) const;
+  /** @brief Locates x by walking from the cell seed, may be nullptr */
+  Location Locate(const Eigen::Vector2d &x,
+                  const lf::mesh::Entity *seed) const;
+
+  std::shared_ptr<const lf::mesh::Mesh> Mesh() const { return mesh_p_; }
+
+ private:
+  static constexpr unsigned kNone = std::numeric_limits<unsigned>::max();
+
+  Eigen::Vector2d LocalCoordinates(unsigned cell,
+                                   const Eigen::Vector2d &x) const {
+    return inverses_[cell] * (x - origins_[cell]);
+  }
+  bool Inside(const Eigen::Vector2d &loc) const {
+    return loc(0) >= -tol_ && loc(1) >= -tol_ && loc(0) + loc(1) <= 1 + tol_;
+  }
+  // Bucket index of a coordinate, clamped to the grid
+  unsigned Bucket(double x, double lo, double width, unsigned n) const {
+    const double i = std::floor((x - lo) / width);
+    return static_cast<unsigned>(std::clamp(i, 0.0, n - 1.0));
+  }
+
+  std::shared_ptr<const lf::mesh::Mesh> mesh_p_;
+  double tol_;
+  // Affine map x = origins_[i] + A_i * loc of cell i, inverses_[i] = A_i^{-1}
+  std::vector<Eigen::Vector2d> origins_;
+  std::vector<Eigen::Matrix2d> inverses_;
+  // neighbours_[3*i + j]: cell across the edge opposite to vertex j of cell i
+  std::vector<unsigned> neighbours_;
+  // Bucket grid: cells of bucket b are bucket_cells_[bucket_start_[b]], ...,
+  // bucket_cells_[bucket_start_[b + 1] - 1]
+  Eigen::Vector2d lo_, hi_;
+  double wx_, wy_;
+  unsigned nx_, ny_;
+  std::vector<unsigned> bucket_start_;
+  std::vector<unsigned> bucket_cells_;
+};
+
+inline PointLocator::PointLocator(std::shared_ptr<const lf::mesh::Mesh> mesh_p,
+                                  double tol)
+    : mesh_p_(std::move(mesh_p)), tol_(tol) {
+  const unsigned n_cells = mesh_p_->NumEntities(0);
+  origins_.resize(n_cells);
+  inverses_.resize(n_cells);
+  std::vector<Eigen::Vector2d> lo(n_cells), hi(n_cells);
+  // Opposite edges of all cells as (sorted pair of node indices, 3*i + j)
+  std::vector<std::pair<std::uint64_t, unsigned>> edges;
+  edges.reserve(3 * n_cells);
+
+  lo_.setConstant(std::numeric_limits<double>::infinity());
+  hi_.setConstant(-std::numeric_limits<double>::infinity());
+  for (const lf::mesh::Entity *entity_p : mesh_p_->Entities(0)) {
+    LF_ASSERT_MSG(lf::base::RefEl::kTria() == entity_p->RefEl(),
+                  "Function only defined for triangular cells");
+    const unsigned i = mesh_p_->Index(*entity_p);
+    const Eigen::MatrixXd corners =
+        lf::geometry::Corners(*entity_p->Geometry());
+    Eigen::Matrix2d A;
+    A << corners.col(1) - corners.col(0), corners.col(2) - corners.col(0);
+    origins_[i] = corners.col(0);
+    inverses_[i] = A.inverse();
+    lo[i] = corners.rowwise().minCoeff();
+    hi[i] = corners.rowwise().maxCoeff();
+    lo_ = lo_.cwiseMin(lo[i]);
+    hi_ = hi_.cwiseMax(hi[i]);
+
+    auto nodes = entity_p->SubEntities(2);
+    for (unsigned j = 0; j < 3; ++j) {
+      std::uint64_t a = mesh_p_->Index(*nodes[(j + 1) % 3]);
+      std::uint64_t b = mesh_p_->Index(*nodes[(j + 2) % 3]);
+      if (a > b) std::swap(a, b);
+      edges.emplace_back((a << 32) | b, 3 * i + j);
+    }
+  }
+
+  // Cells sharing an edge are adjacent after sorting
+  neighbours_.assign(3 * n_cells, kNone);
+  std::sort(edges.begin(), edges.end());
+  for (std::size_t k = 0; k + 1 < edges.size(); ++k) {
+    if (edges[k].first == edges[k + 1].first) {
+      neighbours_[edges[k].second] = edges[k + 1].second / 3;
+      neighbours_[edges[k + 1].second] = edges[k].second / 3;
+      ++k;
+    }
+  }
+
+  // About one cell per bucket, with square-ish buckets
+  const Eigen::Vector2d ext = (hi_ - lo_).cwiseMax(1E-300);
+  const double w = std::sqrt(ext(0) * ext(1) / std::max(1u, n_cells));
+  nx_ = std::max(1u, static_cast<unsigned>(std::ceil(ext(0) / w)));
+  ny_ = std::max(1u, static_cast<unsigned>(std::ceil(ext(1) / w)));
+  wx_ = ext(0) / nx_;
+  wy_ = ext(1) / ny_;
+
+  // Two passes: count the cells per bucket, then fill
+  bucket_start_.assign(nx_ * ny_ + 1, 0);
+  for (int pass = 0; pass < 2; ++pass) {
+    std::vector<unsigned> fill;
+    if (pass == 1) {
+      for (unsigned b = 0; b < nx_ * ny_; ++b) {
+        bucket_start_[b + 1] += bucket_start_[b];
+      }
+      bucket_cells_.resize(bucket_start_.back());
+      fill.assign(bucket_start_.begin(), bucket_start_.end() - 1);
+    }
+    for (unsigned i = 0; i < n_cells; ++i) {
+      const unsigned ix0 = Bucket(lo[i](0), lo_(0), wx_, nx_);
+      const unsigned ix1 = Bucket(hi[i](0), lo_(0), wx_, nx_);
+      const unsigned iy0 = Bucket(lo[i](1), lo_(1), wy_, ny_);
+      const unsigned iy1 = Bucket(hi[i](1), lo_(1), wy_, ny_);
+      for (unsigned iy = iy0; iy <= iy1; ++iy) {
+        for (unsigned ix = ix0; ix <= ix1; ++ix) {
+          const unsigned b = iy * nx_ + ix;
+          if (pass == 0) {
+            ++bucket_start_[b + 1];
+          } else {
+            bucket_cells_[fill[b]++] = i;
+          }
+        }
+      }
+    }
+  }
+}
+
+inline PointLocator::Location PointLocator::Locate(
+    const Eigen::Vector2d &x) const {
+  // Tolerance in global coordinates for points on the bounding box
+  const double eps = tol_ * std::max(wx_ * nx_, wy_ * ny_);
+  if ((x.array() < lo_.array() - eps).any() ||
+      (x.array() > hi_.array() + eps).any()) {
+    return {nullptr, Eigen::Vector2d::Zero()};
+  }
+  const unsigned b = Bucket(x(1), lo_(1), wy_, ny_) * nx_ +
+                     Bucket(x(0), lo_(0), wx_, nx_);
+  for (unsigned k = bucket_start_[b]; k < bucket_start_[b + 1]; ++k) {
+    const unsigned i = bucket_cells_[k];
+    const Eigen::Vector2d loc = LocalCoordinates(i, x);
+    if (Inside(loc)) return {mesh_p_->EntityByIndex(0, i), loc};
+  }
+  return {nullptr, Eigen::Vector2d::Zero()};
+}
+
+inline PointLocator::Location PointLocator::Locate(
+    const Eigen::Vector2d &x, const lf::mesh::Entity *seed) const {
+  if (seed == nullptr) return Locate(x);
+  unsigned i = mesh_p_->Index(*seed);
+  // A straight walk crosses O(#buckets per direction) cells
+  const unsigned max_steps = 2 * (nx_ + ny_) + 10;
+  for (unsigned step = 0; step < max_steps; ++step) {
+    const Eigen::Vector2d loc = LocalCoordinates(i, x);
+    const Eigen::Vector3d lambda(1.0 - loc(0) - loc(1), loc(0), loc(1));
+    Eigen::Index j;
+    if (lambda.minCoeff(&j) >= -tol_) {
+      return {mesh_p_->EntityByIndex(0, i), loc};
+    }
+    // Cross the edge opposite to vertex j
+    i = neighbours_[3 * i + j];
+    if (i == kNone) break;
+  }
+  return Locate(x);
+}
+
+}  // namespace ConvectionDiffusion
+
+#endif  // POINT_LOCATOR_H
@@ -3,6 +3,7 @@
 #include <iostream>
 
 #include "odeintssctrl.h"
+#include "stepsizecontrol.h"
 
 int main() {
   // A scalar initial-value problem
@@ -28,15 +29,27 @@ int main() {
     double k2 = f(y + h * k1);
     return y + (h / 2.) * (k1 + k2);
   };
-  // Call simple adaptive integrator
+  // Call simple adaptive integrator of the lecture, elementary controller
   std::vector<std::pair<double, double>> states =
       odeintssctrl(psilow, 1, psihigh, y0, 1.9, 0.2, 1e-3, 1e-4, 1e-4, norm);
-  // Output solution and error
-  std::cout << "Adaptive integration, " << states.size() - 1 << " timesteps"
+  std::cout << "Elementary controller: " << states.size() - 1 << " timesteps"
             << std::endl;
-  for (auto &ty : states) {
-    std::cout << "t = " << ty.first << ": y = " << ty.second
-              << ", error = " << norm(ty.second - y(ty.first)) << std::endl;
-  }
+
+  // Same embedded pair with the PI controller; the observer outputs the
+  // solution and the error right after every accepted step
+  StepSizeControl::PIDController ctrl = StepSizeControl::PIDController::PI(1);
+  const StepSizeControl::Statistics stats = StepSizeControl::integrate(
+      [&](double h, double yk, double &y_high, double &y_low) {
+        y_high = psihigh(h, yk);
+        y_low = psilow(h, yk);
+      },
+      y0, T, 0.2, 1e-3, 1e-4, 1e-4, ctrl,
+      [&](double t, double yt) {
+        std::cout << "t = " << t << ": y = " << yt
+                  << ", error = " << norm(yt - y(t)) << std::endl;
+      },
+      norm);
+  std::cout << "PI controller: " << stats.accepted << " timesteps, "
+            << stats.rejected << " rejected" << std::endl;
   return 0;
 }
@@ -0,0 +1,187 @@
+///////////////////////////////////////////////////////////////////////////
+/// Demonstration code for lecture "Numerical Methods for CSE" @ ETH Zurich
+/// Author(s): agent
+/// Date: October 2026
+//////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//! \file stepsizecontrol.h Local-in-time step size control for adaptive
+//! single-step methods with PI/PID controllers, a generalization of the
+//! loops in odeintssctrl() and odeintadapt().
+
+namespace StepSizeControl {
+
+//! \brief Default norm: modulus for scalars, Euclidean norm for \eigen
+//! vector types.
+template <class State>
+double defaultNorm(const State &y) {
+  if constexpr (std::is_arithmetic_v<State>) {
+    return std::abs(y);
+  } else {
+    return y.norm();
+  }
+}
+
+//! \brief Counters collected by integrate()
+struct Statistics {
+  unsigned int accepted = 0;  // accepted steps
+  unsigned int rejected = 0;  // rejected steps
+};
+
+//! \brief Step size control based on the last three error ratios
+//! \f$ e_k = \mathrm{EST}_k / \mathrm{TOL}_k \f$ (accepted if \f$ e_k < 1 \f$):
+//! \f[ h_{k+1} = h_k \min(f_{max}, \max(f_{min}, \rho\, e_k^{-\beta_1/q}
+//!     e_{k-1}^{-\beta_2/q} e_{k-2}^{-\beta_3/q})), \quad q = p + 1, \f]
+//! where p is the order of the lower order method. After a rejection only the
+//! current error ratio is used. \f$ \beta = (1, 0, 0) \f$ is the elementary
+//! controller of the lecture, the other choices smooth the step size sequence
+//! and avoid oscillations, e.g. at the stability limit of explicit methods.
+class PIDController {
+ public:
+  PIDController(unsigned int p, double beta1 = 1.0, double beta2 = 0.0,
+                double beta3 = 0.0, double safety = 0.9, double facmin = 0.5,
+                double facmax = 2.0)
+      : q_(p + 1.0),
+        beta1_(beta1),
+        beta2_(beta2),
+        beta3_(beta3),
+        safety_(safety),
+        facmin_(facmin),
+        facmax_(facmax) {}
+
+  //! Elementary controller \f$ \beta = (1, 0, 0) \f$
+  static PIDController Elementary(unsigned int p) {
+    return PIDController(p);
+  }
+  //! PI controller of Gustafsson \f$ \beta = (0.7, -0.4, 0) \f$
+  static PIDController PI(unsigned int p) {
+    return PIDController(p, 0.7, -0.4);
+  }
+  //! PID controller H312PID of Söderlind \f$ \beta = (1, 2, 1) / 18 \f$
+  static PIDController PID(unsigned int p) {
+    return PIDController(p, 1.0 / 18.0, 1.0 / 9.0, 1.0 / 18.0);
+  }
+
+  //! Forgets the error ratios of previous steps
+  void reset() { e1_ = e2_ = 1.0; }
+
+  //! Factor for the next step size after a step with error ratio e
+  double factor(double e, bool accepted) {
+    // Avoid 0^(-beta) for exact steps
+    e = std::max(e, 1.0E-10);
+    double fac;
+    if (accepted) {
+      fac = safety_ * std::pow(e, -beta1_ / q_) * std::pow(e1_, -beta2_ / q_) *
+            std::pow(e2_, -beta3_ / q_);
+      e2_ = e1_;
+      e1_ = e;
+    } else {
+      fac = safety_ * std::pow(e, -1.0 / q_);
+    }
+    return std::min(facmax_, std::max(facmin_, fac));
+  }
+
+ private:
+  double q_;
+  double beta1_, beta2_, beta3_;
+  double safety_, facmin_, facmax_;
+  double e1_ = 1.0, e2_ = 1.0;  // error ratios of the last accepted steps
+};
+
+//! \brief Step size control with fixed factors, independent of the error
+//! ratio: grow by \a up after accepted steps, shrink by \a down otherwise.
+class FixedFactorController {
+ public:
+  FixedFactorController(double up = 1.1, double down = 0.5)
+      : up_(up), down_(down) {}
+  void reset() {}
+  double factor(double /*e*/, bool accepted) const {
+    return accepted ? up_ : down_;
+  }
+
+ private:
+  double up_, down_;
+};
+
+//! \brief Adaptive integration from t = 0 to T with local-in-time step size
+//! control.
+//! \tparam EmbeddedStep callable step(h, y, y_high, y_low), computing the
+//! results of the higher and lower order discrete evolutions for step size h
+//! starting from y. Embedded methods can share their stages this way.
+//! \tparam Controller PIDController, FixedFactorController or any class with
+//! reset() and factor(e, accepted)
+//! \param observer called as observer(t, y) for t = 0 and after every
+//! accepted step
+//! \return Statistics of accepted and rejected steps
+/* SAM_LISTING_BEGIN_0 */
+template <class EmbeddedStep, class State, class Controller, class Observer,
+          class NormFunc = decltype(defaultNorm<State>)>
+Statistics integrate(EmbeddedStep &&step, const State &y0, double T,
+                     double h0, double reltol, double abstol, double hmin,
+                     Controller &ctrl, Observer &&observer,
+                     NormFunc &&norm = defaultNorm<State>) {
+  Statistics stats;
+  double t = 0.0;
+  double h = h0;
+  State y = y0;
+  State y_high = y0;
+  State y_low = y0;
+  ctrl.reset();
+  observer(t, y);
+  while (t < T && h >= hmin) {
+    // Do not step beyond T
+    const double hstep = std::min(T - t, h);
+    step(hstep, y, y_high, y_low);
+    const double est = norm(y_high - y_low);  // \Blue{$\mathrm{EST}_k$}
+    const double tol = std::max(reltol * norm(y), abstol);
+    const bool accepted = est < tol;
+    if (accepted) {
+      // Continue with the higher order approximation
+      std::swap(y, y_high);
+      t += hstep;
+      ++stats.accepted;
+      observer(t, y);
+    } else {
+      ++stats.rejected;
+    }
+    h = hstep * ctrl.factor(est / tol, accepted);
+  }
+  if (t < T) {
+    std::cerr << "Warning: Failure at t=" << t
+              << ". Unable to meet integration tolerances without reducing "
+                 "the step size below the smallest value allowed ("
+              << hmin << ") at time t." << std::endl;
+  }
+  return stats;
+}
+/* SAM_LISTING_END_0 */
+
+//! \brief Same as above for separate discrete evolutions Psilow(h, y) and
+//! Psihigh(h, y), storing all pairs \f$ (t_k, \mathbf{y}_k) \f$.
+template <class DiscEvolOpLow, class DiscEvolOpHigh, class State,
+          class Controller, class NormFunc = decltype(defaultNorm<State>)>
+std::vector<std::pair<double, State>> integrateStates(
+    DiscEvolOpLow &&Psilow, DiscEvolOpHigh &&Psihigh, const State &y0,
+    double T, double h0, double reltol, double abstol, double hmin,
+    Controller &ctrl, NormFunc &&norm = defaultNorm<State>) {
+  std::vector<std::pair<double, State>> states;
+  integrate(
+      [&Psilow, &Psihigh](double h, const State &y, State &y_high,
+                          State &y_low) {
+        y_high = Psihigh(h, y);
+        y_low = Psilow(h, y);
+      },
+      y0, T, h0, reltol, abstol, hmin, ctrl,
+      [&states](double t, const State &y) { states.emplace_back(t, y); },
+      norm);
+  return states;
+}
+
+}  // namespace StepSizeControl
@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////////////////
+/// Demonstration code for lecture "Numerical Methods for CSE" @ ETH Zurich
+/// Author(s): agent
+/// Date: October 2026
+//////////////////////////////////////////////////////////////////////////
+
+#include <Eigen/Dense>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "stepsizecontrol.h"
+
+using State = Eigen::VectorXd;
+using Rhs = std::function<State(const State &)>;
+
+// Test problem y' = f(y), y(0) = y0 on [0, T]
+struct TestProblem {
+  std::string name;
+  Rhs f;
+  State y0;
+  double T;
+};
+
+// Embedded Runge-Kutta pair of Bogacki and Shampine of orders 3 and 2,
+// counting the evaluations of f
+struct BogackiShampine {
+  const Rhs &f;
+  unsigned int &evals;
+  void operator()(double h, const State &y, State &y_high,
+                  State &y_low) const {
+    const State k1 = f(y);
+    const State k2 = f(y + 0.5 * h * k1);
+    const State k3 = f(y + 0.75 * h * k2);
+    y_high = y + h * (2.0 / 9.0 * k1 + 1.0 / 3.0 * k2 + 4.0 / 9.0 * k3);
+    const State k4 = f(y_high);
+    y_low = y + h * (7.0 / 24.0 * k1 + 0.25 * k2 + 1.0 / 3.0 * k3 +
+                     0.125 * k4);
+    evals += 4;
+  }
+};
+
+// Solves the test problem, returns y(T), the state of the last call of the
+// observer
+template <class Controller>
+State solve(const TestProblem &prob, double tol, Controller &ctrl,
+            unsigned int &evals, StepSizeControl::Statistics &stats) {
+  State yT;
+  evals = 0;
+  stats = StepSizeControl::integrate(
+      BogackiShampine{prob.f, evals}, prob.y0, prob.T, 0.01 * prob.T, tol,
+      tol, 1e-12 * prob.T, ctrl,
+      [&yT](double /*t*/, const State &y) { yT = y; });
+  return yT;
+}
+
+int main() {
+  std::vector<TestProblem> problems;
+  // Van der Pol oscillator, mildly stiff for mu = 10
+  problems.push_back({"Van der Pol, mu = 10",
+                      [](const State &y) {
+                        State dy(2);
+                        dy << y(1), 10.0 * (1.0 - y(0) * y(0)) * y(1) - y(0);
+                        return dy;
+                      },
+                      Eigen::Vector2d(2.0, 0.0), 20.0});
+  // Prothero-Robinson equation with exact solution sin(t): explicit methods
+  // run at their stability limit
+  problems.push_back({"Prothero-Robinson, lambda = -100",
+                      [](const State &y) {
+                        State dy(2);
+                        dy << -100.0 * (y(0) - std::sin(y(1))) +
+                                  std::cos(y(1)),
+                            1.0;
+                        return dy;
+                      },
+                      Eigen::Vector2d(0.0, 0.0), 10.0});
+  // Brusselator with A = 1, B = 3
+  problems.push_back({"Brusselator",
+                      [](const State &y) {
+                        State dy(2);
+                        dy << 1.0 + y(0) * y(0) * y(1) - 4.0 * y(0),
+                            3.0 * y(0) - y(0) * y(0) * y(1);
+                        return dy;
+                      },
+                      Eigen::Vector2d(1.5, 3.0), 20.0});
+
+  // Controllers for the lower order p = 2
+  const unsigned int p = 2;
+  std::vector<std::pair<std::string, StepSizeControl::PIDController>>
+      controllers = {
+          {"elementary", StepSizeControl::PIDController::Elementary(p)},
+          {"PI (0.7, -0.4)", StepSizeControl::PIDController::PI(p)},
+          {"H211PI (1/6, 1/6)",
+           StepSizeControl::PIDController(p, 1.0 / 6.0, 1.0 / 6.0)},
+          {"H312PID (1, 2, 1)/18", StepSizeControl::PIDController::PID(p)}};
+  StepSizeControl::FixedFactorController fixed(1.1, 0.5);
+
+  unsigned int evals;
+  StepSizeControl::Statistics stats;
+  auto print = [&](const std::string &name, const State &yT,
+                   const State &yref) {
+    std::cout << std::setw(24) << name << std::setw(10) << evals
+              << std::setw(10) << stats.accepted << std::setw(10)
+              << stats.rejected << std::setw(14) << (yT - yref).norm()
+              << std::endl;
+  };
+  for (const TestProblem &prob : problems) {
+    // Reference solution
+    StepSizeControl::PIDController ref_ctrl =
+        StepSizeControl::PIDController::Elementary(p);
+    const State yref = solve(prob, 1e-12, ref_ctrl, evals, stats);
+    for (double tol : {1e-3, 1e-6}) {
+      std::cout << prob.name << ", tol = " << tol << std::endl
+                << std::setw(24) << "controller" << std::setw(10) << "f-evals"
+                << std::setw(10) << "accepted" << std::setw(10) << "rejected"
+                << std::setw(14) << "error" << std::endl;
+      for (auto &[name, ctrl] : controllers) {
+        const State yT = solve(prob, tol, ctrl, evals, stats);
+        print(name, yT, yref);
+      }
+      const State yT = solve(prob, tol, fixed, evals, stats);
+      print("fixed (1.1, 0.5)", yT, yref);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,46 @@
+/**
+ * @file tridiagonal.h
+ * @brief Direct solver for tridiagonal linear systems
+ * @author agent
+ * @date October 2026
+ * @copyright MIT License
+ */
+
+#ifndef TRIDIAGONAL_H
+#define TRIDIAGONAL_H
+
+#include <Eigen/Core>
+
+/**
+ * @brief Solves the n x n system with constant diagonal d and constant
+ * off-diagonals o by Gaussian elimination without pivoting (Thomas
+ * algorithm) in O(n) operations
+ *
+ * The matrix has to be diagonally dominant, |d| >= 2|o|, like the stiffness
+ * matrices of 1D Lagrangian finite elements on equidistant meshes.
+ *
+ * @param rhs right-hand side, overwritten with the solution
+ * @param work scratch space, resized to n
+ */
+inline void solveTridiagonal(double d, double o,
+                             Eigen::Ref<Eigen::VectorXd> rhs,
+                             Eigen::VectorXd &work) {
+  const Eigen::Index n = rhs.size();
+  if (n == 0) return;
+  work.resize(n);
+  // Forward elimination: work[i] holds the upper off-diagonal entry of row
+  // i after normalization of its diagonal entry to 1
+  work[0] = o / d;
+  rhs[0] /= d;
+  for (Eigen::Index i = 1; i < n; ++i) {
+    const double pivot = d - o * work[i - 1];
+    work[i] = o / pivot;
+    rhs[i] = (rhs[i] - o * rhs[i - 1]) / pivot;
+  }
+  // Back substitution
+  for (Eigen::Index i = n - 1; i-- > 0;) {
+    rhs[i] -= work[i] * rhs[i + 1];
+  }
+}
+
+#endif  // TRIDIAGONAL_H
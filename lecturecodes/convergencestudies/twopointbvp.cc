@@ -11,12 +11,18 @@
 #include <lf/quad/gauss_quadrature.h>
 
 #include <Eigen/Dense>
-#include <Eigen/Sparse>
+#include <algorithm>
 #include <boost/program_options.hpp>
 #include <cmath>
-#include <fstream>
+#include <cstddef>
 #include <iostream>
 #include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "../helperfiles/convergencestudy.h"
+#include "tridiagonal.h"
 
 namespace po = boost::program_options;
 
@@ -28,7 +34,11 @@ int main(int argc, char *argv[]) {
   ("output,o", po::value<std::string>(), "Name of the output file")
   ("M_max,M", po::value<int>()->default_value(500), "Maximum number of cells")
   ("dM,m", po::value<int>()->default_value(5), "Increment in M")
-  ("num_quad_points,n", po::value<int>()->default_value(2), "Number of points for numerical quadrature");
+  ("num_quad_points,n", po::value<int>()->default_value(2), "Number of points for numerical quadrature")
+  ("geometric,g", "Double M instead of incrementing it by dM")
+  ("samples,s", po::value<int>(), "Number of points per mesh for the max norm, default 10*M_max")
+  ("threads,t", po::value<unsigned int>()->default_value(std::max(1u, std::thread::hardware_concurrency())), "Number of meshes treated concurrently")
+  ("memory_budget,b", po::value<std::size_t>()->default_value(0), "Memory budget in MB for concurrent meshes, 0 for none");
   // clang-format on
   po::variables_map vm;
   po::store(po::parse_command_line(argc, argv, desc), vm);
@@ -39,8 +49,13 @@ int main(int argc, char *argv[]) {
   const int M_max = vm["M_max"].as<int>();
   const int dM = vm["dM"].as<int>();
   const int num_quad_points = vm["num_quad_points"].as<int>();
+  const int samples =
+      vm.count("samples") > 0 ? vm["samples"].as<int>() : 10 * M_max;
   const std::string output_file = vm["output"].as<std::string>();
-  const auto [quad_points, quad_weights] =
+  // Not a structured binding: those cannot be captured by lambdas in C++17
+  Eigen::VectorXd quad_points;
+  Eigen::VectorXd quad_weights;
+  std::tie(quad_points, quad_weights) =
       lf::quad::GaussLegendre(num_quad_points);
 
   // Right-hand side source function
@@ -56,117 +71,108 @@ int main(int argc, char *argv[]) {
     return 4 * M_PI * x * std::cos(2 * M_PI * x * x);
   };
 
-  Eigen::MatrixXd results(M_max / dM, 4);
-  // Loop over equidistant meshes of increasing resolution
-  for (int M = dM; M <= M_max; M += dM) {
+  // Computations on a mesh with M cells, independent of all other meshes
+  auto solveLevel = [&](int M, ConvergenceStudy::PhaseTimer &timer) {
     // The mesh width
     const double h = 1. / M;
 
     // Generate the stiffness matrix for negative second derivative on an
     // equidistant mesh on [0, 1] with M cells and p.w. linear Lagrangian finite
     // elements. See Section 2.3 for derivation of the formulas.
-    Eigen::SparseMatrix<double> A(M + 1, M + 1);
-    A.reserve(3 * (M + 1));
-    // Fill the diagonal
-    for (int i = 0; i < M + 1; ++i) {
-      A.coeffRef(i, i) += 2. / h;
-    }
-    // Fill the off-diagonals
-    for (int i = 0; i < M; ++i) {
-      A.coeffRef(i, i + 1) += -1. / h;
-      A.coeffRef(i + 1, i) += -1. / h;
-    }
+    // The matrix has 2/h on the diagonal and -1/h on the off-diagonals and is
+    // never stored. Zero Dirichlet boundary conditions are enforced by
+    // restricting it to the interior nodes 1, ..., M-1.
 
-    // Generate the load vector
-    Eigen::VectorXd rhs = Eigen::VectorXd::Zero(M + 1);
+    // Generate the load vector, sol will be overwritten with the solution
+    Eigen::VectorXd sol = Eigen::VectorXd::Zero(M + 1);
     for (int i = 0; i < M; ++i) {
       const double a = static_cast<double>(i) / M;
-      const Eigen::VectorXd loc_quad_points =
-          Eigen::VectorXd::Constant(num_quad_points, a) + h * quad_points;
-      const Eigen::VectorXd loc_quad_weights = h * quad_weights;
       // Perform the integration over the cell for both basis functions
-      const auto b1 = [&](double x) { return (x - a) / h; };
-      const auto b2 = [&](double x) { return 1. - b1(x); };
       for (int k = 0; k < num_quad_points; ++k) {
-        rhs[i] += loc_quad_weights[k] * b2(loc_quad_points[k]) *
-                  f(loc_quad_points[k]);
-        rhs[i + 1] += loc_quad_weights[k] * b1(loc_quad_points[k]) *
-                      f(loc_quad_points[k]);
-      }
-    }
-
-    // Enforce zero dirichlet boundary conditions
-    for (long k = 0; k < A.outerSize(); ++k) {
-      for (Eigen::SparseMatrix<double>::InnerIterator it(A, k); it; ++it) {
-        const int row = it.row();
-        const int col = it.col();
-        if ((row == 0 && col == 0) || (row == M && col == M)) {
-          it.valueRef() = 1;
-        } else if (row == 0 || row == M || col == 0 || col == M) {
-          it.valueRef() = 0;
-        }
+        const double x = a + h * quad_points[k];
+        const double w = h * quad_weights[k];
+        const double b1 = (x - a) / h;
+        const double b2 = 1. - b1;
+        sol[i] += w * b2 * f(x);
+        sol[i + 1] += w * b1 * f(x);
       }
     }
     // Set the boundary values to zero
-    rhs[0] = 0;
-    rhs[M] = 0;
+    sol[0] = 0;
+    sol[M] = 0;
+
+    timer.lap(ConvergenceStudy::kAssemble);
 
-    // Solve the resulting linear system
-    Eigen::SparseLU<Eigen::SparseMatrix<double>> solver(A);
-    const Eigen::VectorXd sol = solver.solve(rhs);
+    // Solve the resulting linear system for the interior nodes
+    Eigen::VectorXd work;
+    solveTridiagonal(2. / h, -1. / h, sol.segment(1, M - 1), work);
 
-    // Compute the norms and store them in the results matrix
+    timer.lap(ConvergenceStudy::kSolve);
+
+    // Compute the norms, no temporary vectors
     double norm_max = 0;
     double norm_H1_squared = 0;
     double norm_L2_squared = 0;
+    // Number of points per cell for the evaluation of the max norm
+    const int n_max = std::max(1, samples / M);
     for (int i = 0; i < M; ++i) {
       const double a = static_cast<double>(i) / M;
       const double b = static_cast<double>(i + 1) / M;
-      const Eigen::VectorXd loc_quad_points =
-          Eigen::VectorXd::Constant(num_quad_points, a) + h * quad_points;
-      const Eigen::VectorXd loc_quad_weights = h * quad_weights;
 
       // The approximate solution on the current cell
       const auto u_h = [&](double x) {
         return sol[i + 1] * (x - a) / h + sol[i] * (1. - (x - a) / h);
       };
       // The gradient of the approximate solution on the current cell
-      const auto u_h_grad = [&](double /*x*/) {
-        return (sol[i + 1] - sol[i]) / h;
-      };
+      const double u_h_grad = (sol[i + 1] - sol[i]) / h;
       // The difference of the approximate and the exact solution
       const auto diff = [&](double x) { return u_h(x) - u(x); };
       // The difference in the gradient of the approximate and the exact
       // solution
-      const auto diff_grad = [&](double x) { return u_h_grad(x) - u_grad(x); };
-
-      // Compute the max norm by evaluating the functions on a fine grid
-      norm_max =
-          std::max(norm_max, Eigen::ArrayXd::LinSpaced(10 * M_max / M, a, b)
-                                 .unaryExpr(diff)
-                                 .abs()
-                                 .maxCoeff());
+      const auto diff_grad = [&](double x) { return u_h_grad - u_grad(x); };
+
+      // Compute the max norm by evaluating the functions on n_max
+      // equidistant points of the cell including b
+      const double step = n_max > 1 ? (b - a) / (n_max - 1) : 0.;
+      for (int j = 0; j < n_max; ++j) {
+        const double x = (j == n_max - 1) ? b : a + j * step;
+        norm_max = std::max(norm_max, std::abs(diff(x)));
+      }
       // Compute the H1 and L2 norms by integrating using a numerical quadrature
       for (int k = 0; k < num_quad_points; ++k) {
-        norm_H1_squared += loc_quad_weights[k] * diff_grad(loc_quad_points[k]) *
-                           diff_grad(loc_quad_points[k]);
-        norm_L2_squared += loc_quad_weights[k] * diff(loc_quad_points[k]) *
-                           diff(loc_quad_points[k]);
+        const double x = a + h * quad_points[k];
+        const double w = h * quad_weights[k];
+        norm_H1_squared += w * diff_grad(x) * diff_grad(x);
+        norm_L2_squared += w * diff(x) * diff(x);
       }
     }
-    results((M / dM) - 1, 0) = M;
-    results((M / dM) - 1, 1) = norm_max;
-    results((M / dM) - 1, 2) = std::sqrt(norm_H1_squared);
-    results((M / dM) - 1, 3) = std::sqrt(norm_L2_squared);
-  }
+    timer.lap(ConvergenceStudy::kError);
+    return Eigen::Vector3d(norm_max, std::sqrt(norm_H1_squared),
+                           std::sqrt(norm_L2_squared));
+  };
+  // Load vector/solution and scratch space of the Thomas algorithm
+  auto memory = [](int M) -> std::size_t {
+    return 2 * sizeof(double) * (M + 1);
+  };
 
-  // Output the resulting errors to a file
-  const static Eigen::IOFormat CSVFormat(Eigen::StreamPrecision,
-                                         Eigen::DontAlignCols, ", ", "\n");
-  std::ofstream file;
-  file.open(output_file);
-  file << results.format(CSVFormat);
-  file.close();
+  // Loop over equidistant meshes of increasing resolution
+  std::vector<int> Ms;
+  if (vm.count("geometric") > 0) {
+    for (int M = dM; M <= M_max; M *= 2) Ms.push_back(M);
+  } else {
+    for (int M = dM; M <= M_max; M += dM) Ms.push_back(M);
+  }
+  ConvergenceStudy::Options options;
+  options.threads = vm["threads"].as<unsigned int>();
+  options.memory_budget = vm["memory_budget"].as<std::size_t>() << 20;
+  const std::vector<ConvergenceStudy::Level> results =
+      ConvergenceStudy::run(Ms, solveLevel, memory, options);
+
+  // Output the errors, timings and rates to a file
+  ConvergenceStudy::write(output_file, {"max", "H1", "L2"}, results);
+  const Eigen::VectorXd rates = ConvergenceStudy::rates(results);
+  std::cout << "Empiric rates: max " << rates[0] << ", H1 " << rates[1]
+            << ", L2 " << rates[2] << std::endl;
 
   return 0;
 }
@@ -0,0 +1,193 @@
+/**
+ * @file convergencestudy.h
+ * @brief Runner for empiric convergence studies: independent discretization
+ * levels are computed concurrently, timed phase by phase, and the rates are
+ * fitted with polyfit()
+ * @author agent
+ * @date October 2026
+ * @copyright MIT License
+ */
+
+#ifndef CONVERGENCESTUDY_H
+#define CONVERGENCESTUDY_H
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <fstream>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "polyfit.h"
+
+namespace ConvergenceStudy {
+
+/** @brief Phases of the computation on one level */
+enum Phase { kAssemble = 0, kSolve = 1, kError = 2 };
+
+/**
+ * @brief Accumulates wall time per phase: lap(phase) charges the time since
+ * the previous lap (or the construction) to phase
+ */
+class PhaseTimer {
+ public:
+  PhaseTimer() : last_(clock::now()) {}
+  void lap(Phase phase) {
+    const clock::time_point now = clock::now();
+    ms_[phase] +=
+        std::chrono::duration<double, std::milli>(now - last_).count();
+    last_ = now;
+  }
+  double ms(Phase phase) const { return ms_[phase]; }
+  /** @brief Restarts the clock and clears all phases */
+  void reset() { *this = PhaseTimer(); }
+
+ private:
+  using clock = std::chrono::steady_clock;
+  clock::time_point last_;
+  std::array<double, 3> ms_{0.0, 0.0, 0.0};
+};
+
+/** @brief Result of one level: discretization parameter, error norms and
+ * timings */
+struct Level {
+  int N;
+  Eigen::VectorXd errors;
+  PhaseTimer timer;
+};
+
+/** @brief Parameters of the runner */
+struct Options {
+  unsigned int threads = std::max(1u, std::thread::hardware_concurrency());
+  // Upper bound for the sum of the memory estimates of the levels running
+  // at the same time, 0 means no bound. A level exceeding the budget on its
+  // own runs alone.
+  std::size_t memory_budget = 0;
+};
+
+/**
+ * @brief Computes all levels N in Ns on a pool of threads
+ *
+ * @param solve callable Eigen::VectorXd(int N, PhaseTimer &timer) returning
+ * the error norms on level N; it charges its work to the phases by calling
+ * timer.lap() and must not share mutable state with other levels
+ * @param memory callable std::size_t(int N), estimate of the memory in bytes
+ * needed by level N
+ * @return the levels in the order of Ns
+ *
+ * Levels are started in order of decreasing memory estimate, so that the
+ * most expensive ones do not end up last.
+ */
+template <typename SOLVE, typename MEMORY>
+std::vector<Level> run(const std::vector<int> &Ns, SOLVE &&solve,
+                       MEMORY &&memory, const Options &options = Options()) {
+  const std::size_t n = Ns.size();
+  std::vector<Level> levels(n);
+  std::vector<std::size_t> need(n);
+  std::vector<std::size_t> order(n);
+  for (std::size_t i = 0; i < n; ++i) need[i] = memory(Ns[i]);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&need](std::size_t i, std::size_t j) {
+                     return need[i] > need[j];
+                   });
+
+  std::mutex mutex;
+  std::condition_variable released;
+  std::size_t next = 0;  // position in order of the next level to start
+  std::size_t in_use = 0;  // memory estimate of the running levels
+  unsigned int running = 0;
+  auto worker = [&]() {
+    for (;;) {
+      std::size_t i;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (next == n) return;
+        // Wait until the next level fits into the budget
+        released.wait(lock, [&] {
+          return next == n || options.memory_budget == 0 || running == 0 ||
+                 in_use + need[order[next]] <= options.memory_budget;
+        });
+        if (next == n) return;
+        i = order[next++];
+        in_use += need[i];
+        ++running;
+      }
+      levels[i].N = Ns[i];
+      levels[i].timer.reset();
+      levels[i].errors = solve(Ns[i], levels[i].timer);
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        in_use -= need[i];
+        --running;
+      }
+      released.notify_all();
+    }
+  };
+
+  const unsigned int threads = std::max(
+      1u, static_cast<unsigned int>(std::min<std::size_t>(options.threads, n)));
+  std::vector<std::thread> pool;
+  pool.reserve(threads - 1);
+  for (unsigned int t = 1; t < threads; ++t) pool.emplace_back(worker);
+  worker();
+  for (std::thread &thread : pool) thread.join();
+  return levels;
+}
+
+/**
+ * @brief Empiric convergence rates: minus the slope of the least squares
+ * line through (log N, log error) for every error norm
+ */
+inline Eigen::VectorXd rates(const std::vector<Level> &levels) {
+  const std::size_t n = levels.size();
+  const Eigen::Index norms = n > 0 ? levels[0].errors.size() : 0;
+  Eigen::VectorXd logN(n);
+  Eigen::MatrixXd logerr(n, norms);
+  for (std::size_t i = 0; i < n; ++i) {
+    logN[i] = std::log(levels[i].N);
+    logerr.row(i) = levels[i].errors.array().log().matrix().transpose();
+  }
+  Eigen::VectorXd result(norms);
+  for (Eigen::Index k = 0; k < norms; ++k) {
+    result[k] = -polyfit(logN, logerr.col(k), 1)(0);
+  }
+  return result;
+}
+
+/**
+ * @brief Writes one comma-separated line per level: N, the error norms and
+ * the assembly, solve and error evaluation times in ms. The column names and
+ * the fitted rates are written as comment lines starting with '#'.
+ */
+inline void write(const std::string &file_name,
+                  const std::vector<std::string> &norm_names,
+                  const std::vector<Level> &levels) {
+  std::ofstream file(file_name);
+  file << "# N";
+  for (const std::string &name : norm_names) file << ", " << name;
+  file << ", assemble_ms, solve_ms, error_ms\n";
+  const Eigen::VectorXd r = rates(levels);
+  for (Eigen::Index k = 0; k < r.size(); ++k) {
+    file << "# rate " << norm_names[k] << " = " << r[k] << "\n";
+  }
+  for (const Level &level : levels) {
+    file << level.N;
+    for (Eigen::Index k = 0; k < level.errors.size(); ++k) {
+      file << ", " << level.errors[k];
+    }
+    file << ", " << level.timer.ms(kAssemble) << ", "
+         << level.timer.ms(kSolve) << ", " << level.timer.ms(kError) << "\n";
+  }
+}
+
+}  // namespace ConvergenceStudy
+
+#endif  // CONVERGENCESTUDY_H
@@ -0,0 +1,83 @@
+/**
+ * @file parallelchunks.h
+ * @brief Distribution of the index range {0, ..., n-1} of independent loop
+ * iterations on a few threads
+ * @author agent
+ * @date October 2026
+ * @copyright MIT License
+ */
+
+#ifndef PARALLELCHUNKS_H
+#define PARALLELCHUNKS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Number of threads actually used for n iterations: at least one, at
+ * most n
+ */
+template <typename INDEX>
+unsigned int numChunks(INDEX n, unsigned int threads) {
+  if constexpr (std::is_signed_v<INDEX>) {
+    assert(n >= 0 && "Negative number of iterations");
+  }
+  if (static_cast<std::uintmax_t>(n) < threads) {
+    threads = static_cast<unsigned int>(n);
+  }
+  return std::max(1u, threads);
+}
+
+/**
+ * @brief Calls f(t, begin, end) for the contiguous chunks [begin, end) of
+ * {0, ..., n-1}, t = 0, ..., numChunks(n, threads)-1, chunk t on its own
+ * thread and chunk 0 on the calling one
+ *
+ * Every t is called exactly once, even for n = 0, so that f may use t to
+ * address thread-local storage.
+ */
+template <typename INDEX, typename FUNCTION>
+void parallelChunks(INDEX n, unsigned int threads, FUNCTION &&f) {
+  threads = numChunks(n, threads);
+  auto bound = [n, threads](unsigned int t) -> INDEX {
+    return static_cast<INDEX>(static_cast<std::uintmax_t>(n) * t / threads);
+  };
+  std::vector<std::thread> pool;
+  pool.reserve(threads - 1);
+  for (unsigned int t = 1; t < threads; ++t) {
+    pool.emplace_back([&f, &bound, t]() { f(t, bound(t), bound(t + 1)); });
+  }
+  f(0u, bound(0), bound(1));
+  for (std::thread &thread : pool) thread.join();
+}
+
+/**
+ * @brief Calls f(k) for k = 0, ..., n-1 on the given number of threads
+ *
+ * Unlike parallelChunks() the indices are handed out one by one, which
+ * balances iterations of varying cost.
+ */
+template <typename INDEX, typename FUNCTION>
+void parallelFor(INDEX n, unsigned int threads, FUNCTION &&f) {
+  threads = numChunks(n, threads);
+  if (threads == 1) {
+    for (INDEX k = 0; k < n; ++k) f(k);
+    return;
+  }
+  std::atomic<INDEX> next(0);
+  auto work = [&]() {
+    for (INDEX k = next++; k < n; k = next++) f(k);
+  };
+  std::vector<std::thread> pool;
+  pool.reserve(threads - 1);
+  for (unsigned int t = 1; t < threads; ++t) pool.emplace_back(work);
+  work();
+  for (std::thread &thread : pool) thread.join();
+}
+
+#endif  // PARALLELCHUNKS_H
@@ -15,8 +15,9 @@
 /* SAM_LISTING_BEGIN_0 */
 // Solver for polynomial linear least squares data fitting problem
 // data points passed in t and y, 'order' = degree of polynomial
-Eigen::VectorXd polyfit(const Eigen::VectorXd& t, const Eigen::VectorXd& y,
-                        const unsigned& order) {
+inline Eigen::VectorXd polyfit(const Eigen::VectorXd& t,
+                               const Eigen::VectorXd& y,
+                               const unsigned& order) {
   // A = [1 t_1 t_1^2 ... ]
   //     [ ...        ... ]
   //     [1 t_n t_n^2 ... ]